@@ -0,0 +1,152 @@
+"""Generates C++ headers with the restore height checkpoints and the seed nodes as constexpr arrays.
+
+Run by the build, see src/CMakeLists.txt. Exits with an error if a table is malformed or unsorted, so a bad table
+fails the build instead of producing wrong restore heights at runtime.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+NETWORKS = ["mainnet", "stagenet", "testnet"]
+NODE_KINDS = ["tor", "clearnet", "i2p"]  # order in which the nodes are tried
+
+INT_MAX = 2 ** 31 - 1
+
+HEADER = """// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+// Generated by contrib/embed-tables/generate.py from {source}, do not edit.
+"""
+
+
+def fail(message):
+    print(f"embed-tables: {message}", file=sys.stderr)
+    sys.exit(1)
+
+
+def read_checkpoints(path):
+    checkpoints = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line:
+                continue
+
+            match = re.fullmatch(r"(\d+):(\d+)", line)
+            if not match:
+                fail(f"{path}:{number}: expected '<timestamp>:<height>', got '{line}'")
+
+            timestamp, height = int(match.group(1)), int(match.group(2))
+            if height < 1 or height > INT_MAX:
+                fail(f"{path}:{number}: height {height} out of range")
+
+            if checkpoints:
+                previous_timestamp, previous_height = checkpoints[-1]
+                if timestamp <= previous_timestamp or height <= previous_height:
+                    fail(f"{path}:{number}: not sorted, {timestamp}:{height} follows {previous_timestamp}:{previous_height}")
+
+            checkpoints.append((timestamp, height))
+
+    if not checkpoints:
+        fail(f"{path}: no checkpoints")
+    return checkpoints
+
+
+def read_nodes(path):
+    with open(path) as f:
+        try:
+            data = json.load(f)
+        except json.JSONDecodeError as e:
+            fail(f"{path}: {e}")
+
+    if not isinstance(data, dict):
+        fail(f"{path}: expected an object of networks")
+
+    nodes = {}
+    for network, kinds in data.items():
+        if network not in NETWORKS:
+            fail(f"{path}: unknown network '{network}'")
+        if not isinstance(kinds, dict):
+            fail(f"{path}: {network}: expected an object of node lists")
+
+        nodes[network] = []
+        for kind, addresses in kinds.items():
+            if kind not in NODE_KINDS:
+                fail(f"{path}: {network}: unknown node kind '{kind}'")
+            if not isinstance(addresses, list):
+                fail(f"{path}: {network}.{kind}: expected a list")
+
+        for kind in NODE_KINDS:
+            for address in kinds.get(kind, []):
+                match = re.fullmatch(r"[A-Za-z0-9.-]+:(\d+)", address) if isinstance(address, str) else None
+                if not match or not 0 < int(match.group(1)) < 65536:
+                    fail(f"{path}: {network}.{kind}: invalid address {address!r}")
+                nodes[network].append(address)
+
+    return nodes
+
+
+def write(path, text):
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def generate_restore_heights(args):
+    out = [HEADER.format(source=", ".join(os.path.basename(p) for p in (args.mainnet, args.stagenet)))]
+    out.append("#ifndef FEATHER_EMBEDDED_RESTORE_HEIGHTS_H")
+    out.append("#define FEATHER_EMBEDDED_RESTORE_HEIGHTS_H\n")
+    out.append("#include <array>\n")
+    out.append('#include "utils/RestoreHeightLookup.h"\n')
+    out.append("namespace embedded {")
+
+    for network, path in (("mainnet", args.mainnet), ("stagenet", args.stagenet)):
+        checkpoints = read_checkpoints(path)
+        out.append(f"    inline constexpr std::array<RestoreHeightLookup::Checkpoint, {len(checkpoints)}> {network}RestoreHeights = {{{{")
+        for timestamp, height in checkpoints:
+            out.append(f"        {{{timestamp}, {height}}},")
+        out.append("    }};")
+
+    out.append("}\n")
+    out.append("#endif //FEATHER_EMBEDDED_RESTORE_HEIGHTS_H\n")
+    write(os.path.join(args.output, "EmbeddedRestoreHeights.h"), "\n".join(out))
+
+
+def generate_seed_nodes(args):
+    nodes = read_nodes(args.nodes)
+
+    out = [HEADER.format(source=os.path.basename(args.nodes))]
+    out.append("#ifndef FEATHER_EMBEDDED_SEED_NODES_H")
+    out.append("#define FEATHER_EMBEDDED_SEED_NODES_H\n")
+    out.append("#include <array>\n")
+    out.append("namespace embedded {")
+
+    for network in NETWORKS:
+        addresses = nodes.get(network, [])
+        out.append(f"    inline constexpr std::array<const char*, {len(addresses)}> {network}SeedNodes = {{{{")
+        for address in addresses:
+            out.append(f'        "{address}",')
+        out.append("    }};")
+
+    out.append("}\n")
+    out.append("#endif //FEATHER_EMBEDDED_SEED_NODES_H\n")
+    write(os.path.join(args.output, "EmbeddedSeedNodes.h"), "\n".join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the embedded checkpoint and seed node tables.")
+    parser.add_argument("--mainnet", required=True, help="mainnet restore heights, <timestamp>:<height> per line")
+    parser.add_argument("--stagenet", required=True, help="stagenet restore heights")
+    parser.add_argument("--nodes", required=True, help="nodes.json")
+    parser.add_argument("--output", required=True, help="directory for the generated headers")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    generate_restore_heights(args)
+    generate_seed_nodes(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -15,11 +15,15 @@ namespace
     const char BlockSizeProperty[] = "blockSize";
 } // namespace
 
-Application::Application(int& argc, char** argv)
+Application::Application(int& argc, char** argv, bool singleInstance)
         : QApplication(argc, argv)
         , m_alreadyRunning(false)
         , m_lockFile(nullptr)
 {
+    if (!singleInstance) {
+        return;
+    }
+
     QString userName = qgetenv("USER");
     if (userName.isEmpty()) {
         userName = qgetenv("USERNAME");
@@ -13,7 +13,7 @@ class Application : public QApplication {
     Q_OBJECT
 
 public:
-    Application(int& argc, char** argv);
+    Application(int& argc, char** argv, bool singleInstance = true);
     ~Application() override;
 
     bool isAlreadyRunning() const;
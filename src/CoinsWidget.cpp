@@ -23,6 +23,7 @@ CoinsWidget::CoinsWidget(Wallet *wallet, QWidget *parent)
         , m_copyMenu(new QMenu("Copy",this))
 {
     ui->setupUi(this);
+    m_wallet->coins()->attachView(this);
 
     // header context menu
     ui->coins->header()->setContextMenuPolicy(Qt::CustomContextMenu);
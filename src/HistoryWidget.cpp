@@ -9,6 +9,7 @@
 #include "dialog/TxInfoDialog.h"
 #include "dialog/TxProofDialog.h"
 #include "model/TransactionHistoryProxyModel.h"
+#include "libwalletqt/TransactionHistory.h"
 #include "libwalletqt/Wallet.h"
 #include "libwalletqt/WalletManager.h"
 #include "utils/config.h"
@@ -24,6 +25,7 @@ HistoryWidget::HistoryWidget(Wallet *wallet, QWidget *parent)
         , m_model(wallet->historyModel())
 {
     ui->setupUi(this);
+    m_wallet->history()->attachView(this);
     m_contextMenu->addMenu(m_copyMenu);
     m_contextMenu->addAction(icons()->icon("info2.svg"), "Show details", this, &HistoryWidget::showTxDetails);
     m_contextMenu->addAction("View on block explorer", this, &HistoryWidget::onViewOnBlockExplorer);
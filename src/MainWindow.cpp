@@ -21,6 +21,7 @@
 #include "dialog/TxImportDialog.h"
 #include "dialog/TxInfoDialog.h"
 #include "dialog/TxPoolViewerDialog.h"
+#include "dialog/ConsolidateDialog.h"
 #include "dialog/ViewOnlyDialog.h"
 #include "dialog/WalletInfoDialog.h"
 #include "dialog/WalletCacheDebugDialog.h"
@@ -34,7 +35,10 @@
 #include "utils/AsyncTask.h"
 #include "utils/ColorScheme.h"
 #include "utils/Icons.h"
+#include "utils/Logger.h"
+#include "utils/Startup.h"
 #include "utils/TorManager.h"
+#include "utils/Tracer.h"
 #include "utils/WebsocketNotifier.h"
 
 #include "wallet/wallet_errors.h"
@@ -56,6 +60,8 @@ MainWindow::MainWindow(WindowManager *windowManager, Wallet *wallet, QWidget *pa
     , m_nodes(new Nodes(this, wallet))
     , m_rpc(new DaemonRpc(this, ""))
 {
+    TRACE_SCOPE("MainWindow::MainWindow");
+
     ui->setupUi(this);
 
     // Ensure the destructor is called after closeEvent()
@@ -86,7 +92,10 @@ MainWindow::MainWindow(WindowManager *windowManager, Wallet *wallet, QWidget *pa
     connect(websocketNotifier(), &WebsocketNotifier::UpdatesReceived, m_updater.data(), &Updater::wsUpdatesReceived);
 #endif
 
-    websocketNotifier()->emitCache(); // Get cached data
+    // Cached prices and notices, after the window painted
+    startup()->whenInteractive("WebsocketNotifier::emitCache", []{
+        websocketNotifier()->emitCache();
+    });
 
     connect(m_windowManager, &WindowManager::websocketStatusChanged, this, &MainWindow::onWebsocketStatusChanged);
     this->onWebsocketStatusChanged(!conf()->get(Config::disableWebsocket).toBool());
@@ -317,6 +326,7 @@ void MainWindow::initMenu() {
     connect(ui->actionRescan_spent,          &QAction::triggered, this, &MainWindow::rescanSpent);
     connect(ui->actionWallet_cache_debug,    &QAction::triggered, this, &MainWindow::showWalletCacheDebugDialog);
     connect(ui->actionTxPoolViewer,          &QAction::triggered, this, &MainWindow::showTxPoolViewerDialog);
+    connect(ui->actionConsolidateOutputs,    &QAction::triggered, this, &MainWindow::showConsolidateDialog);
 
     // [Wallet] -> [History]
     connect(ui->actionExport_CSV, &QAction::triggered, this, &MainWindow::onExportHistoryCSV);
@@ -550,6 +560,7 @@ QString MainWindow::walletKeysPath() {
 
 void MainWindow::onWalletOpened() {
     qDebug() << Q_FUNC_INFO;
+    TRACE_SCOPE("MainWindow::onWalletOpened");
     m_splashDialog->hide();
 
     m_wallet->setRingDatabase(Utils::ringDatabasePath());
@@ -733,7 +744,7 @@ void MainWindow::onMultiBroadcast(const QMap<QString, QString> &txHexMap) {
         i.next();
         for (const auto& node: m_nodes->nodes()) {
             QString address = node.toURL();
-            qDebug() << QString("Relaying %1 to: %2").arg(i.key(), address);
+            qCDebug(lcNetwork) << QString("Relaying %1 to: %2").arg(i.key(), address);
             m_rpc->setDaemonAddress(address);
             m_rpc->sendRawTransaction(i.value());
         }
@@ -744,8 +755,23 @@ void MainWindow::onSyncStatus(quint64 height, quint64 target, bool daemonSync) {
     if (height >= (target - 1)) {
         this->updateNetStats();
     }
-    this->setStatusText(Utils::formatSyncStatus(height, target, daemonSync));
-    m_statusLabelStatus->setToolTip(QString("Wallet height: %1").arg(QString::number(height)));
+    QString status = Utils::formatSyncStatus(height, target, daemonSync);
+    QString tooltip = QString("Wallet height: %1").arg(QString::number(height));
+
+    SyncTelemetry *telemetry = m_nodes->telemetry();
+    if (!daemonSync && telemetry && telemetry->isSyncing()) {
+        QString summary = telemetry->summary();
+        if (!summary.isEmpty()) {
+            status += QString(" (%1)").arg(summary);
+        }
+        tooltip += QString("\n%1 per block\nWaiting on node: %2s, scanning: %3s")
+                .arg(Utils::formatBytes(static_cast<quint64>(telemetry->bytesPerBlock())),
+                     QString::number(qRound(telemetry->networkSeconds())),
+                     QString::number(qRound(telemetry->scanSeconds())));
+    }
+
+    this->setStatusText(status);
+    m_statusLabelStatus->setToolTip(tooltip);
 }
 
 void MainWindow::onConnectionStatusChanged(int status)
@@ -1059,6 +1085,7 @@ void MainWindow::onTransactionCommitted(bool success, PendingTransaction *tx, co
     if (msgBox.clickedButton() == showDetailsButton) {
         this->showHistoryTab();
 
+        m_wallet->history()->refreshIfStale();
         const auto& rows = m_wallet->history()->getRows();
         auto itr = std::find_if(rows.begin(), rows.end(),
                 [&](const TransactionRow& ti) {
@@ -1363,6 +1390,19 @@ void MainWindow::showTxPoolViewerDialog() {
     m_txPoolViewerDialog->show();
 }
 
+void MainWindow::showConsolidateDialog() {
+    if (m_wallet->viewOnly()) {
+        Utils::showError(this, "Unable to consolidate outputs", "Wallet is view-only", {"Use the offline transaction signing workflow to sweep outputs from a view-only wallet."});
+        return;
+    }
+
+    if (!m_consolidateDialog) {
+        m_consolidateDialog = new ConsolidateDialog{this, m_wallet};
+    }
+
+    m_consolidateDialog->show();
+}
+
 void MainWindow::showAccountSwitcherDialog() {
     m_accountSwitcherDialog->show();
     m_accountSwitcherDialog->update();
@@ -1690,6 +1730,7 @@ void MainWindow::onSelectedInputsChanged(const QStringList &selectedInputs) {
     ui->frame_coinControl->setVisible(numInputs > 0);
 
     if (numInputs > 0) {
+        m_wallet->coins()->refreshIfStale();
         quint64 totalAmount = m_wallet->coins()->sumAmounts(selectedInputs);
 
         QString text = QString("Coin control active: %1 selected outputs, %2 XMR").arg(QString::number(numInputs), WalletManager::displayAmount(totalAmount));
@@ -1738,12 +1779,28 @@ void MainWindow::onImportHistoryDescriptionsCSV() {
         return;
     }
 
-    QString error = m_wallet->history()->importLabelsFromCSV(fileName);
+    TxNotesResult result;
+    QString error = m_wallet->history()->importLabelsFromCSV(fileName, result);
     if (!error.isEmpty()) {
         Utils::showError(this, "Unable to import transaction descriptions from CSV", error);
+        return;
     }
-    else {
-        Utils::showInfo(this, "Successfully imported transaction descriptions from CSV");
+
+    QString description = QString("Imported %1 descriptions.").arg(QString::number(result.updated));
+    QStringList skipped;
+    if (result.unmatched > 0) {
+        skipped.append(QString("%1 rows refer to transactions that are not in this wallet, e.g. %2")
+                       .arg(QString::number(result.unmatched), result.unmatchedSample.first()));
+    }
+    if (result.invalid > 0) {
+        skipped.append(QString("%1 rows have an invalid transaction ID, e.g. '%2'")
+                       .arg(QString::number(result.invalid), result.invalidSample.first()));
+    }
+
+    if (skipped.isEmpty()) {
+        Utils::showInfo(this, "Successfully imported transaction descriptions from CSV", description);
+    } else {
+        Utils::showWarning(this, "Imported transaction descriptions from CSV", description, skipped);
     }
 }
 
@@ -20,6 +20,7 @@
 #include "dialog/AboutDialog.h"
 #include "dialog/SplashDialog.h"
 #include "dialog/TxPoolViewerDialog.h"
+#include "dialog/ConsolidateDialog.h"
 #include "libwalletqt/Wallet.h"
 #include "model/SubaddressModel.h"
 #include "model/SubaddressProxyModel.h"
@@ -148,6 +149,7 @@ private slots:
     void showKeyImageSyncWizard();
     void showWalletCacheDebugDialog();
     void showTxPoolViewerDialog();
+    void showConsolidateDialog();
     void showAccountSwitcherDialog();
     void showAddressChecker();
     void showURDialog();
@@ -222,6 +224,7 @@ private:
     SplashDialog *m_splashDialog = nullptr;
     AccountSwitcherDialog *m_accountSwitcherDialog = nullptr;
     TxPoolViewerDialog *m_txPoolViewerDialog = nullptr;
+    ConsolidateDialog *m_consolidateDialog = nullptr;
 
     WalletUnlockWidget *m_walletUnlockWidget = nullptr;
     ContactsWidget *m_contactsWidget = nullptr;
@@ -4,7 +4,9 @@
 #include "ReceiveWidget.h"
 #include "ui_ReceiveWidget.h"
 
+#include <QInputDialog>
 #include <QMenu>
+#include <QMessageBox>
 
 #include "libwalletqt/rows/SubaddressRow.h"
 #include "dialog/PaymentRequestDialog.h"
@@ -19,6 +21,7 @@ ReceiveWidget::ReceiveWidget(Wallet *wallet, QWidget *parent)
         , m_wallet(wallet)
 {
     ui->setupUi(this);
+    m_wallet->subaddress()->attachView(this);
 
     m_model = m_wallet->subaddressModel();
     m_proxyModel = new SubaddressProxyModel(this, m_wallet->subaddress());
@@ -66,6 +69,11 @@ ReceiveWidget::ReceiveWidget(Wallet *wallet, QWidget *parent)
         ui->addresses->setColumnHidden(2, !show);
     });
 
+    m_headerMenu->addSeparator();
+    m_headerMenu->addAction("Generate subaddresses...", this, &ReceiveWidget::generateSubaddresses);
+    m_headerMenu->addAction("Unused address pool...", this, &ReceiveWidget::setSubaddressPoolSize);
+    connect(m_wallet, &Wallet::subaddressesGenerated, this, &ReceiveWidget::onSubaddressesGenerated);
+
     connect(ui->addresses->header(), &QHeaderView::customContextMenuRequested, this, &ReceiveWidget::showHeaderMenu);
     ui->toolBtn_options->setMenu(m_headerMenu);
 
@@ -242,6 +250,68 @@ void ReceiveWidget::generateSubaddress() {
     }
 }
 
+void ReceiveWidget::generateSubaddresses() {
+    if (m_wallet->isGeneratingSubaddresses()) {
+        Utils::showInfo(this, "Subaddresses are being generated", "Wait for the current batch to finish.");
+        return;
+    }
+
+    bool ok;
+    int count = QInputDialog::getInt(this, "Generate subaddresses", "Number of subaddresses:", 100, 1, 1000000, 100, &ok);
+    if (!ok) {
+        return;
+    }
+
+    QString labelTemplate = QInputDialog::getText(this, "Generate subaddresses", "Label ({index}, {n} and {account} are replaced):", QLineEdit::Normal, "", &ok);
+    if (!ok) {
+        return;
+    }
+
+    m_exportNextBatch = m_wallet->addSubaddresses(count, labelTemplate);
+    if (!m_exportNextBatch) {
+        Utils::showError(this, "Failed to generate subaddresses");
+    }
+}
+
+void ReceiveWidget::setSubaddressPoolSize() {
+    bool ok;
+    int poolSize = QInputDialog::getInt(this, "Unused address pool", "Keep at least this many unused subaddresses (0 to disable):",
+                                        conf()->get(Config::subaddressPoolSize).toInt(), 0, 1000000, 100, &ok);
+    if (!ok) {
+        return;
+    }
+
+    conf()->set(Config::subaddressPoolSize, poolSize);
+    m_wallet->subaddress()->updateUsed(m_wallet->currentSubaddressAccount());
+}
+
+void ReceiveWidget::onSubaddressesGenerated(quint32 accountIndex, quint32 first, quint32 count, const QString &error) {
+    // Batches topping up the unused pool are not exported
+    if (!m_exportNextBatch) {
+        return;
+    }
+    m_exportNextBatch = false;
+
+    if (!error.isEmpty()) {
+        Utils::showError(this, "Failed to generate subaddresses", error);
+        return;
+    }
+
+    auto button = QMessageBox::question(this, "Subaddresses generated", QString("Generated %1 subaddresses. Export them to a file?").arg(count));
+    if (button != QMessageBox::Yes || accountIndex != m_wallet->currentSubaddressAccount()) {
+        return;
+    }
+
+    QString fn = Utils::getSaveFileName(this, "Export subaddresses", QString("subaddresses_%1_%2.csv").arg(accountIndex).arg(first), "CSV (*.csv);;JSON (*.json)");
+    if (fn.isEmpty()) {
+        return;
+    }
+
+    if (!m_wallet->subaddress()->exportRows(fn, first, count)) {
+        Utils::showError(this, "Failed to export subaddresses", m_wallet->subaddress()->getError());
+    }
+}
+
 void ReceiveWidget::updateQrCode(){
     QModelIndex index = getCurrentIndex();
     if (!index.isValid()) {
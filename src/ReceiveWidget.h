@@ -46,6 +46,9 @@ private slots:
     void showHeaderMenu(const QPoint& position);
     void showOnDevice();
     void generateSubaddress();
+    void generateSubaddresses();
+    void setSubaddressPoolSize();
+    void onSubaddressesGenerated(quint32 accountIndex, quint32 first, quint32 count, const QString &error);
 
 private:
     QScopedPointer<Ui::ReceiveWidget> ui;
@@ -54,6 +57,7 @@ private:
     QAction *m_showTransactionsAction;
     SubaddressModel *m_model;
     SubaddressProxyModel *m_proxyModel;
+    bool m_exportNextBatch = false;
 
     QModelIndex getCurrentIndex();
 
@@ -9,8 +9,10 @@
 #include "utils/AppData.h"
 #include "utils/config.h"
 #include "Icons.h"
+#include "libwalletqt/FeeHistory.h"
 #include "libwalletqt/Wallet.h"
 #include "libwalletqt/WalletManager.h"
+#include "utils/OpenAliasResolver.h"
 
 #if defined(WITH_SCANNER)
 #include "wizard/offline_tx_signing/OfflineTxSigningWizard.h"
@@ -35,7 +37,7 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
     connect(m_wallet, &Wallet::beginCommitTransaction, this, &SendWidget::disableSendButton);
     connect(m_wallet, &Wallet::transactionCommitted, this, &SendWidget::enableSendButton);
 
-    connect(WalletManager::instance(), &WalletManager::openAliasResolved, this, &SendWidget::onOpenAliasResolved);
+    connect(openAliasResolver(), &OpenAliasResolver::resolved, this, &SendWidget::onOpenAliasResolved);
 
     connect(ui->btnScan, &QPushButton::clicked, this, &SendWidget::scanClicked);
     connect(ui->btnSend, &QPushButton::clicked, this, &SendWidget::sendClicked);
@@ -46,6 +48,7 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
     connect(ui->lineAddress, &QPlainTextEdit::textChanged, this, &SendWidget::addressEdited);
     connect(ui->btn_openAlias, &QPushButton::clicked, this, &SendWidget::aliasClicked);
     connect(ui->lineAddress, &PayToEdit::dataPasted, this, &SendWidget::onDataFromQR);
+    connect(ui->lineAddress, &PayToEdit::outputsChanged, this, &SendWidget::addressEdited);
     ui->label_conversionAmount->setText("");
     ui->label_conversionAmount->hide();
     ui->btn_openAlias->hide();
@@ -64,6 +67,7 @@ SendWidget::SendWidget(Wallet *wallet, QWidget *parent)
 
     ui->lineAddress->setNetType(constants::networkType);
     this->setupComboBox();
+    this->setupDeadlineComboBox();
 
     this->setManualFeeSelectionEnabled(conf()->get(Config::manualFeeTierSelection).toBool());
     this->setSubtractFeeFromAmountEnabled(conf()->get(Config::subtractFeeFromAmount).toBool());
@@ -93,7 +97,7 @@ void SendWidget::addressEdited() {
         ui->comboCurrencySelection->setCurrentIndex(0);
     }
 
-    ui->btn_openAlias->setVisible(ui->lineAddress->isOpenAlias());
+    ui->btn_openAlias->setVisible(ui->lineAddress->isOpenAlias() || ui->lineAddress->hasUnresolvedAliases());
 }
 
 void SendWidget::amountEdited(const QString &text) {
@@ -267,9 +271,15 @@ void SendWidget::sendClicked() {
 }
 
 void SendWidget::aliasClicked() {
+    if (ui->lineAddress->isMultiline()) {
+        ui->lineAddress->resolveAliases();
+        return;
+    }
+
     ui->btn_openAlias->setEnabled(false);
-    auto alias = ui->lineAddress->text();
-    WalletManager::instance()->resolveOpenAliasAsync(alias);
+    auto alias = ui->lineAddress->text().trimmed();
+    m_pendingAlias = OpenAliasResolver::normalize(alias);
+    openAliasResolver()->resolve(alias);
 }
 
 void SendWidget::clearClicked() {
@@ -342,15 +352,23 @@ double SendWidget::amountDouble() {
     return amount / constants::cdiv;
 }
 
-void SendWidget::onOpenAliasResolved(const QString &openAlias, const QString &address, bool dnssecValid) {
+void SendWidget::onOpenAliasResolved(const OpenAliasResult &result) {
+    // Also emitted for lookups of other widgets
+    if (m_pendingAlias.isEmpty() || result.alias != m_pendingAlias) {
+        return;
+    }
+    m_pendingAlias.clear();
     ui->btn_openAlias->setEnabled(true);
 
+    const QString openAlias = ui->lineAddress->text().trimmed();
+    const QString &address = result.address;
+
     if (address.isEmpty()) {
         Utils::showError(this, "Unable to resolve OpenAlias", "Address empty.");
         return;
     }
 
-    if (!dnssecValid) {
+    if (!result.dnssecValid) {
         Utils::showError(this, "Unable to resolve OpenAlias", "Address found, but the DNSSEC signatures could not be verified, so this address may be spoofed.");
         return;
     }
@@ -405,6 +423,90 @@ void SendWidget::setWebsocketEnabled(bool enabled) {
 void SendWidget::setManualFeeSelectionEnabled(bool enabled) {
     ui->label_feeTarget->setVisible(enabled);
     ui->combo_feePriority->setVisible(enabled);
+    ui->combo_deadline->setVisible(enabled);
+    ui->label_feeEstimate->setVisible(enabled);
+}
+
+void SendWidget::setupDeadlineComboBox() {
+    const QList<QPair<QString, int>> deadlines = {
+        {"No deadline", 0},
+        {"Within 10 minutes", 10},
+        {"Within 30 minutes", 30},
+        {"Within 1 hour", 60},
+        {"Within 2 hours", 120},
+        {"Within 6 hours", 360},
+        {"Within 1 day", 1440},
+    };
+    for (const auto &deadline : deadlines) {
+        ui->combo_deadline->addItem(deadline.first, deadline.second);
+    }
+    int index = ui->combo_deadline->findData(conf()->get(Config::confirmationDeadline).toInt());
+    ui->combo_deadline->setCurrentIndex(std::max(index, 0));
+
+    connect(ui->combo_deadline, &QComboBox::currentIndexChanged, [this]{
+        conf()->set(Config::confirmationDeadline, ui->combo_deadline->currentData().toInt());
+        if (m_wallet->feeHistory()->estimates().isEmpty()) {
+            m_wallet->feeHistory()->requestUpdate();
+        }
+        this->updateFeeEstimate(true);
+    });
+    connect(ui->combo_feePriority, &QComboBox::activated, [this]{
+        // A tier picked by hand replaces the suggestion
+        QSignalBlocker blocker{ui->combo_deadline};
+        ui->combo_deadline->setCurrentIndex(0);
+        conf()->set(Config::confirmationDeadline, 0);
+        this->updateFeeEstimate(false);
+    });
+    connect(m_wallet->feeHistory(), &FeeHistory::estimatesChanged, [this]{
+        this->updateFeeEstimate(true);
+    });
+
+    this->updateFeeEstimate(true);
+}
+
+void SendWidget::updateFeeEstimate(bool suggestTier) {
+    const FeeHistory *history = m_wallet->feeHistory();
+    const QVector<FeeEstimate> estimates = history->estimates();
+    const int deadline = ui->combo_deadline->currentData().toInt();
+
+    if (estimates.isEmpty()) {
+        ui->label_feeEstimate->setText(deadline > 0 ? "Waiting for transaction pool" : "");
+        return;
+    }
+
+    QStringList tooltip;
+    const QStringList tierNames = {"Low", "Normal", "High", "Highest"};
+    for (const auto &estimate : estimates) {
+        tooltip.append(QString("%1 (%2 /B): %3").arg(tierNames.value(estimate.tier), QString::number(estimate.feePerByte),
+                                                   FeeHistory::formatEstimate(estimate.seconds)));
+    }
+    if (!estimates.first().fromHistory) {
+        tooltip.append("Based on the current pool only, the history is still being recorded.");
+    }
+    ui->label_feeEstimate->setToolTip(tooltip.join("\n"));
+
+    // Only a deadline the user can see picks the tier, and it never raises the fee past what meets the deadline
+    bool deadlineMissed = false;
+    if (suggestTier && deadline > 0 && !ui->combo_deadline->isHidden()) {
+        int tier = history->cheapestTier(deadline * 60);
+        deadlineMissed = (tier < 0);
+        if (!deadlineMissed) {
+            ui->combo_feePriority->setCurrentIndex(tier + 1);
+        }
+    }
+
+    const int tier = ui->combo_feePriority->currentIndex() - 1;
+    if (tier < 0 || tier >= estimates.size()) {
+        // Automatic, wallet2 picks the tier when the transaction is created
+        ui->label_feeEstimate->setText(deadlineMissed ? "No tier is expected to meet the deadline" : "");
+        return;
+    }
+
+    QString text = QString("ETA %1").arg(FeeHistory::formatEstimate(estimates[tier].seconds));
+    if (deadlineMissed) {
+        text += ", no tier is expected to meet the deadline";
+    }
+    ui->label_feeEstimate->setText(text);
 }
 
 void SendWidget::setSubtractFeeFromAmountEnabled(bool enabled) {
@@ -7,6 +7,7 @@
 #include <QWidget>
 
 class Wallet;
+struct OpenAliasResult;
 
 namespace Ui {
     class SendWidget;
@@ -36,7 +37,7 @@ public slots:
     void currencyComboChanged(int index);
     void fillAddress(const QString &address);
     void updateConversionLabel();
-    void onOpenAliasResolved(const QString &openAlias, const QString &address, bool dnssecValid);
+    void onOpenAliasResolved(const OpenAliasResult &result);
     void onPreferredFiatCurrencyChanged();
     void setWebsocketEnabled(bool enabled);
 
@@ -53,6 +54,8 @@ private slots:
 
 private:
     void setupComboBox();
+    void setupDeadlineComboBox();
+    void updateFeeEstimate(bool suggestTier);
     double amountDouble();
     bool keyImageSync(bool sendAll, quint64 amount);
 
@@ -62,6 +65,7 @@ private:
     QScopedPointer<Ui::SendWidget> ui;
     Wallet *m_wallet;
     bool m_disallowSending = false;
+    QString m_pendingAlias;
 };
 
 #endif // FEATHER_SENDWIDGET_H
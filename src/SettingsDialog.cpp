@@ -12,6 +12,7 @@
 #include "libwalletqt/WalletManager.h"
 #include "utils/AppData.h"
 #include "utils/Icons.h"
+#include "utils/Logger.h"
 #include "utils/nodes.h"
 #include "utils/WebsocketNotifier.h"
 #include "widgets/NetworkProxyWidget.h"
@@ -234,6 +235,13 @@ void Settings::setupStorageTab() {
         WalletManager::instance()->setLogLevel(toggled ? conf()->get(Config::logLevel).toInt() : -1);
     });
 
+    // [Write application log to disk]
+    ui->checkBox_logToFile->setChecked(conf()->get(Config::logToFile).toBool());
+    connect(ui->checkBox_logToFile, &QCheckBox::toggled, [](bool toggled){
+        conf()->set(Config::logToFile, toggled);
+        Logger::setLogFile(toggled ? Config::defaultConfigDir().filePath("feather.log") : QString());
+    });
+
     // [Log level]
     ui->comboBox_logLevel->setCurrentIndex(conf()->get(Config::logLevel).toInt());
     connect(ui->comboBox_logLevel, QOverload<int>::of(&QComboBox::currentIndexChanged), [](int index){
@@ -364,6 +372,18 @@ void Settings::setupTransactionsTab() {
         conf()->set(Config::subtractFeeFromAmount, toggled);
         emit subtractFeeFromAmountEnabled(toggled);
     });
+
+    // [Record fee history]
+    ui->checkBox_recordFeeHistory->setChecked(conf()->get(Config::recordFeeHistory).toBool());
+    connect(ui->checkBox_recordFeeHistory, &QCheckBox::toggled, [](bool toggled){
+        conf()->set(Config::recordFeeHistory, toggled);
+    });
+
+    // [Remember resolved OpenAlias addresses]
+    ui->checkBox_cacheOpenAliases->setChecked(conf()->get(Config::cacheOpenAliases).toBool());
+    connect(ui->checkBox_cacheOpenAliases, &QCheckBox::toggled, [](bool toggled){
+        conf()->set(Config::cacheOpenAliases, toggled);
+    });
 }
 
 void Settings::setupPluginsTab() {
@@ -24,10 +24,14 @@
 #include "utils/TorManager.h"
 #include "utils/WebsocketNotifier.h"
 #include "utils/AppData.h"
+#include "utils/Startup.h"
+#include "utils/Tracer.h"
 
 WindowManager::WindowManager(QObject *parent)
     : QObject(parent)
 {
+    TRACE_SCOPE("WindowManager::WindowManager");
+
     m_walletManager = WalletManager::instance();
     m_splashDialog = new SplashDialog();
     m_cleanupThread = new QThread(this);
@@ -47,13 +51,19 @@ WindowManager::WindowManager(QObject *parent)
     this->buildTrayMenu();
     m_tray->setVisible(conf()->get(Config::showTrayIcon).toBool());
 
+    // On a worker thread, while the first window is set up and the wallet is opened
+    torManager()->prepare();
+
     this->initSkins();
     this->patchMacStylesheet();
 
     this->showCrashLogs();
 
     if (!conf()->get(Config::firstRun).toBool() || TailsOS::detect() || WhonixOS::detect()) {
-        this->onInitialNetworkConfigured();
+        // Runs from the event loop once Tor is unpacked, opening the wallet doesn't have to wait for it
+        startup()->add("WindowManager::onInitialNetworkConfigured", Startup::Gui, [this]{
+            this->onInitialNetworkConfigured();
+        }, {"TorManager::unpackBins"});
     }
 
     this->startupWarning();
@@ -249,6 +259,7 @@ void WindowManager::setDocsHighlight(const QString &highlight) {
 
 void WindowManager::tryOpenWallet(const QString &path, const QString &password) {
     // Path : path to .keys file
+    Tracer::instant("WindowManager::tryOpenWallet");
 
     QString absolutePath = path;
     if (absolutePath.startsWith("~")) {
@@ -273,6 +284,8 @@ void WindowManager::tryOpenWallet(const QString &path, const QString &password)
 }
 
 void WindowManager::onWalletOpened(Wallet *wallet) {
+    TRACE_SCOPE("WindowManager::onWalletOpened");
+
     if (!wallet) {
         this->handleWalletError({nullptr, Utils::ERROR, "Unable to open wallet", "This should never happen. If you encounter this error, please report it to the developers.", {}, "report_an_issue"});
         return;
@@ -320,6 +333,7 @@ void WindowManager::onWalletOpened(Wallet *wallet) {
     m_splashDialog->hide();
     m_openWalletTriedOnce = false;
     auto *window = new MainWindow(this, wallet);
+    startup()->watch(window);
     m_windows.append(window);
     this->buildTrayMenu();
     m_openingWallet = false;
@@ -329,6 +343,7 @@ void WindowManager::onWalletOpenPasswordRequired(bool invalidPassword, const QSt
     QFileInfo fileInfo(path);
 
     PasswordDialog dialog{fileInfo.fileName(), invalidPassword};
+    startup()->watch(&dialog);
     switch (dialog.exec()) {
         case QDialog::Rejected:
         {
@@ -387,6 +402,9 @@ void WindowManager::tryCreateWallet(Seed seed, const QString &path, const QStrin
 
     wallet->setCacheAttribute("feather.seed", seed.mnemonic.join(" "));
     wallet->setCacheAttribute("feather.seedoffset", seedOffset);
+    if (!newWallet && seed.restoreDate > 0) {
+        wallet->setRestoreDate(seed.restoreDate);
+    }
     // Store attributes now, so we don't lose them on crash / forced exit
     wallet->store();
 
@@ -671,31 +689,7 @@ void WindowManager::onProxySettingsChanged() {
         return;
     }
 
-    // Will kill the process if necessary
-    torManager()->init();
-    torManager()->start();
-
-    QNetworkProxy proxy{QNetworkProxy::NoProxy};
-    if (conf()->get(Config::proxy).toInt() != Config::Proxy::None) {
-        QString host = conf()->get(Config::socks5Host).toString();
-        quint16 port = conf()->get(Config::socks5Port).toString().toUShort();
-
-        if (conf()->get(Config::proxy).toInt() == Config::Proxy::Tor && (!torManager()->isLocalTor() || torManager()->isAlreadyRunning())) {
-            host = torManager()->featherTorHost;
-            port = torManager()->featherTorPort;
-        }
-
-        proxy = QNetworkProxy{QNetworkProxy::Socks5Proxy, host, port};
-        getNetworkSocks5()->setProxy(proxy);
-    }
-
-    qWarning() << "Proxy: " << proxy.hostName() << " " << proxy.port();
-
-    // Switch websocket to new proxy and update URL
-    websocketNotifier()->websocketClient->stop();
-    websocketNotifier()->websocketClient->webSocket->setProxy(proxy);
-    websocketNotifier()->websocketClient->nextWebsocketUrl();
-    websocketNotifier()->websocketClient->restart();
+    applyProxySettings();
 
     emit proxySettingsChanged();
 }
@@ -737,6 +731,7 @@ void WindowManager::showWizard(WalletWizard::Page startPage) {
     m_wizard->setStartId(startPage);
     m_wizard->restart();
     m_wizard->setEnabled(true);
+    startup()->watch(m_wizard);
     m_wizard->show();
 }
 
@@ -747,22 +742,32 @@ void WindowManager::wizardOpenWallet() {
 // ######################## SKINS ########################
 
 void WindowManager::initSkins() {
-    m_skins.insert("Native", "");
-
-    QString qdarkstyle = this->loadStylesheet(":qdarkstyle/style.qss");
-    if (!qdarkstyle.isEmpty())
-        m_skins.insert("QDarkStyle", qdarkstyle);
+    TRACE_SCOPE("WindowManager::initSkins");
 
-    QString breeze_dark = this->loadStylesheet(":/dark.qss");
-    if (!breeze_dark.isEmpty())
-        m_skins.insert("Breeze/Dark", breeze_dark);
+    // Stylesheets are read when a skin is applied, startup only needs the one in use
+    m_skins.insert("Native", "");
 
-    QString breeze_light = this->loadStylesheet(":/light.qss");
-    if (!breeze_light.isEmpty())
-        m_skins.insert("Breeze/Light", breeze_light);
+    const QMap<QString, QString> stylesheets = {
+        {"QDarkStyle", ":qdarkstyle/style.qss"},
+        {"Breeze/Dark", ":/dark.qss"},
+        {"Breeze/Light", ":/light.qss"},
+    };
+    for (auto it = stylesheets.cbegin(); it != stylesheets.cend(); ++it) {
+        if (QFile::exists(it.value())) {
+            m_skins.insert(it.key(), it.value());
+        }
+    }
 
     QString skin = conf()->get(Config::skin).toString();
-    qApp->setStyleSheet(m_skins[skin]);
+    qApp->setStyleSheet(this->skinStylesheet(skin));
+}
+
+QString WindowManager::skinStylesheet(const QString &skinName) {
+    QString resource = m_skins.value(skinName);
+    if (resource.isEmpty()) {
+        return "";
+    }
+    return this->loadStylesheet(resource);
 }
 
 QString WindowManager::loadStylesheet(const QString &resource) {
@@ -789,7 +794,7 @@ void WindowManager::onChangeTheme(const QString &skinName) {
 
     conf()->set(Config::skin, skinName);
 
-    qApp->setStyleSheet(m_skins[skinName]);
+    qApp->setStyleSheet(this->skinStylesheet(skinName));
     qDebug() << QString("Skin changed to %1").arg(skinName);
 
     this->patchMacStylesheet();
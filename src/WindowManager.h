@@ -87,6 +87,7 @@ private:
     void displayWalletErrorMessage(const QString &message);
 
     void initSkins();
+    QString skinStylesheet(const QString &skinName);
     QString loadStylesheet(const QString &resource);
     void patchMacStylesheet();
 
@@ -108,7 +109,7 @@ private:
 
     QSystemTrayIcon *m_tray = nullptr;
 
-    QMap<QString, QString> m_skins;
+    QMap<QString, QString> m_skins;  // name, stylesheet resource
 
     bool m_openWalletTriedOnce = false;
     bool m_openingWallet = false;
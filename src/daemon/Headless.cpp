@@ -0,0 +1,664 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "Headless.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QTimer>
+
+#if defined(Q_OS_UNIX)
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "constants.h"
+#include "libwalletqt/Coins.h"
+#include "libwalletqt/PendingTransaction.h"
+#include "libwalletqt/Subaddress.h"
+#include "libwalletqt/TransactionHistory.h"
+#include "libwalletqt/Wallet.h"
+#include "libwalletqt/WalletManager.h"
+#include "libwalletqt/rows/CoinsInfo.h"
+#include "libwalletqt/rows/TransactionRow.h"
+#include "utils/AppData.h"
+#include "utils/NetworkManager.h"
+#include "utils/OtsContainer.h"
+#include "utils/Startup.h"
+#include "utils/TorManager.h"
+#include "utils/Utils.h"
+#include "utils/nodes.h"
+
+namespace {
+    constexpr int defaultChunkSize = 500;
+
+#if defined(Q_OS_UNIX)
+    int signalFds[2] = {-1, -1};
+
+    void onTerminationSignal(int) {
+        char c = 1;
+        [[maybe_unused]] ssize_t r = ::write(signalFds[0], &c, sizeof(c));
+    }
+#endif
+
+    QJsonObject transactionToJson(const TransactionRow &row) {
+        QJsonArray subaddrIndices;
+        for (quint32 index : row.subaddrIndex) {
+            subaddrIndices.append(static_cast<qint64>(index));
+        }
+
+        QJsonObject obj;
+        obj["txid"] = row.hash;
+        obj["direction"] = row.direction == TransactionRow::Direction_In ? "in" : "out";
+        obj["amount"] = row.amount;
+        obj["balance_delta"] = row.balanceDelta;
+        obj["fee"] = static_cast<qint64>(row.fee);
+        obj["height"] = static_cast<qint64>(row.blockHeight);
+        obj["timestamp"] = row.timestamp.toSecsSinceEpoch();
+        obj["confirmations"] = static_cast<qint64>(row.confirmations);
+        obj["unlock_time"] = static_cast<qint64>(row.unlockTime);
+        obj["account"] = static_cast<qint64>(row.subaddrAccount);
+        obj["subaddr_indices"] = subaddrIndices;
+        obj["payment_id"] = row.paymentId;
+        obj["description"] = row.description;
+        obj["label"] = row.label;
+        obj["pending"] = row.pending;
+        obj["failed"] = row.failed;
+        obj["coinbase"] = row.coinbase;
+        return obj;
+    }
+
+    QJsonObject coinToJson(const CoinsInfo &coin) {
+        QJsonObject obj;
+        obj["pubkey"] = coin.pubKey;
+        obj["key_image"] = coin.keyImageKnown ? coin.keyImage : QString();
+        obj["txid"] = coin.hash;
+        obj["output_index"] = static_cast<qint64>(coin.internalOutputIndex);
+        obj["global_index"] = static_cast<qint64>(coin.globalOutputIndex);
+        obj["amount"] = static_cast<qint64>(coin.amount);
+        obj["height"] = static_cast<qint64>(coin.blockHeight);
+        obj["spent"] = coin.spent;
+        obj["spent_height"] = static_cast<qint64>(coin.spentHeight);
+        obj["frozen"] = coin.frozen;
+        obj["unlocked"] = coin.unlocked;
+        obj["account"] = static_cast<qint64>(coin.subaddrAccount);
+        obj["subaddr_index"] = static_cast<qint64>(coin.subaddrIndex);
+        obj["address"] = coin.address;
+        obj["address_label"] = coin.addressLabel;
+        obj["description"] = coin.description;
+        obj["coinbase"] = coin.coinbase;
+        obj["change"] = coin.change;
+        return obj;
+    }
+
+    // Sends rows as "stream" notifications of chunkSize rows each, then the number of rows as the result
+    template<typename T, typename F>
+    void streamRows(const RpcCallPtr &call, const QList<T> &rows, F toJson, const std::function<bool(const T&)> &filter = {}) {
+        int chunkSize = call->params().value("chunk_size").toInt(defaultChunkSize);
+        if (chunkSize <= 0) {
+            chunkSize = defaultChunkSize;
+        }
+
+        qint64 count = 0;
+        QJsonArray chunk;
+        for (const T &row : rows) {
+            if (filter && !filter(row)) {
+                continue;
+            }
+            chunk.append(toJson(row));
+            count++;
+            if (chunk.size() >= chunkSize) {
+                call->stream(chunk);
+                chunk = QJsonArray();
+            }
+        }
+        if (!chunk.isEmpty()) {
+            call->stream(chunk);
+        }
+
+        QJsonObject result;
+        result["count"] = count;
+        call->result(result);
+    }
+}
+
+Headless::Headless(QString walletPath, QString password, QString socketName, QObject *parent)
+    : QObject(parent)
+    , m_walletPath(std::move(walletPath))
+    , m_password(std::move(password))
+    , m_socketName(std::move(socketName))
+    , m_walletManager(WalletManager::instance())
+    , m_server(new RpcServer(this))
+{
+    connect(m_walletManager, &WalletManager::walletOpened, this, &Headless::onWalletOpened);
+    this->registerMethods();
+
+#if defined(Q_OS_UNIX)
+    // Close the wallet cleanly, so its cache is stored, when the process is asked to terminate
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) == 0) {
+        auto *notifier = new QSocketNotifier(signalFds[1], QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, [this, notifier]{
+            char c;
+            [[maybe_unused]] ssize_t r = ::read(signalFds[1], &c, sizeof(c));
+            notifier->setEnabled(false);
+            this->shutdown(EXIT_SUCCESS);
+        });
+        std::signal(SIGINT, onTerminationSignal);
+        std::signal(SIGTERM, onTerminationSignal);
+    }
+#endif
+}
+
+Headless::~Headless() {
+    qDebug() << "~Headless";
+}
+
+bool Headless::start() {
+    QString absolutePath = m_walletPath;
+    if (absolutePath.startsWith("~")) {
+        absolutePath.replace(0, 1, QDir::homePath());
+    }
+
+    if (!Utils::fileExists(absolutePath)) {
+        qCritical() << "Wallet not found:" << absolutePath;
+        return false;
+    }
+
+    // No window is going to be painted, don't hold back deferred startup work
+    startup()->setInteractive();
+
+    // Same as WindowManager::onInitialNetworkConfigured, Tor is started if the config asks for it
+    appData();
+    if (!Utils::isTorsocks()) {
+        applyProxySettings();
+    }
+
+    qInfo() << "Opening wallet:" << absolutePath;
+    m_walletManager->openWalletAsync(absolutePath, m_password, constants::networkType, constants::kdfRounds, Utils::ringDatabasePath());
+    m_password.clear();
+    return true;
+}
+
+void Headless::onWalletOpened(Wallet *wallet) {
+    if (!wallet) {
+        qCritical() << "Unable to open wallet";
+        this->shutdown(EXIT_FAILURE);
+        return;
+    }
+
+    if (wallet->status() != Wallet::Status_Ok) {
+        qCritical() << "Unable to open wallet:" << wallet->errorString();
+        wallet->deleteLater();
+        this->shutdown(EXIT_FAILURE);
+        return;
+    }
+
+    m_wallet = wallet;
+    m_wallet->setRingDatabase(Utils::ringDatabasePath());
+    m_wallet->updateBalance();
+    m_wallet->subaddress()->refresh();
+    m_wallet->history()->refresh();
+    m_wallet->coins()->refresh();
+
+    connect(m_wallet, &Wallet::transactionCreated, this, &Headless::onTransactionCreated);
+    connect(m_wallet, &Wallet::transactionCommitted, this, &Headless::onTransactionCommitted);
+    connect(m_wallet, &Wallet::subaddressesGenerated, this, &Headless::onSubaddressesGenerated);
+
+    m_nodes = new Nodes(this, m_wallet);
+    m_nodes->allowConnection();
+    m_nodes->connectToNode();
+
+    if (!m_server->listen(m_socketName)) {
+        this->shutdown(EXIT_FAILURE);
+        return;
+    }
+}
+
+void Headless::shutdown(int exitCode) {
+    qInfo() << "Headless: shutting down";
+
+    delete m_nodes;
+    m_nodes = nullptr;
+
+    if (m_wallet) {
+        m_wallet->disconnect(this);
+        for (auto *tx : m_pending) {
+            m_wallet->disposeTransaction(tx);
+        }
+        m_pending.clear();
+
+        // Stores the wallet cache
+        delete m_wallet;
+        m_wallet = nullptr;
+    }
+
+    torManager()->stop();
+    QCoreApplication::exit(exitCode);
+}
+
+void Headless::registerMethods() {
+    auto add = [this](const QString &method, void (Headless::*handler)(const RpcCallPtr &), bool needsWallet = true) {
+        m_server->registerMethod(method, [this, handler, needsWallet](const RpcCallPtr &call) {
+            if (needsWallet && !this->requireWallet(call)) {
+                return;
+            }
+            (this->*handler)(call);
+        });
+    };
+
+    add("get_status", &Headless::getStatus);
+    add("get_node_stats", &Headless::getNodeStats);
+    add("get_balance", &Headless::getBalance);
+    add("get_address", &Headless::getAddress);
+    add("create_address", &Headless::createAddress);
+    add("create_addresses", &Headless::createAddresses);
+    add("select_account", &Headless::selectAccount);
+    add("get_history", &Headless::getHistory);
+    add("get_coins", &Headless::getCoins);
+    add("set_tx_note", &Headless::setTxNote);
+    add("set_tx_notes", &Headless::setTxNotes);
+    add("create_transaction", &Headless::createTransaction);
+    add("commit_transaction", &Headless::commitTransaction);
+    add("discard_transaction", &Headless::discardTransaction);
+    add("export_key_images", &Headless::exportKeyImages);
+    add("export_outputs", &Headless::exportOutputs);
+    add("store", &Headless::store);
+
+    m_server->registerMethod("stop", [this](const RpcCallPtr &call) {
+        call->result(true);
+        QTimer::singleShot(0, this, [this]{
+            this->shutdown(EXIT_SUCCESS);
+        });
+    });
+}
+
+bool Headless::requireWallet(const RpcCallPtr &call) {
+    if (!m_wallet) {
+        call->error(RpcServer::WalletError, "No wallet open");
+        return false;
+    }
+    return true;
+}
+
+void Headless::getStatus(const RpcCallPtr &call) {
+    QJsonObject result;
+    result["wallet"] = m_wallet->keysPath();
+    result["nettype"] = static_cast<int>(m_wallet->nettype());
+    result["connection_status"] = static_cast<int>(m_wallet->connectionStatus());
+    result["synchronized"] = m_wallet->isSynchronized();
+    result["height"] = static_cast<qint64>(m_wallet->blockChainHeight());
+    result["daemon_height"] = static_cast<qint64>(m_wallet->daemonBlockChainTargetHeight());
+    result["account"] = static_cast<qint64>(m_wallet->currentSubaddressAccount());
+    result["accounts"] = static_cast<qint64>(m_wallet->numSubaddressAccounts());
+
+    SyncTelemetry *telemetry = m_nodes ? m_nodes->telemetry() : nullptr;
+    if (telemetry && telemetry->isSyncing()) {
+        QJsonObject sync;
+        sync["blocks_per_second"] = telemetry->blocksPerSecond();
+        sync["bytes_per_block"] = telemetry->bytesPerBlock();
+        sync["eta"] = telemetry->eta();
+        sync["network_seconds"] = telemetry->networkSeconds();
+        sync["scan_seconds"] = telemetry->scanSeconds();
+        result["sync"] = sync;
+    }
+
+    call->result(result);
+}
+
+void Headless::getNodeStats(const RpcCallPtr &call) {
+    SyncTelemetry *telemetry = m_nodes ? m_nodes->telemetry() : nullptr;
+    if (!telemetry) {
+        call->error(RpcServer::InternalError, "No sync telemetry");
+        return;
+    }
+
+    QJsonObject result;
+    const auto stats = telemetry->allStats();
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it) {
+        QJsonObject node = it.value().toJson();
+        node["blocks_per_second"] = it.value().blocksPerSecond();
+        node["bytes_per_block"] = it.value().bytesPerBlock();
+        result[it.key()] = node;
+    }
+    call->result(result);
+}
+
+void Headless::getBalance(const RpcCallPtr &call) {
+    auto account = static_cast<quint32>(call->params().value("account").toInteger(m_wallet->currentSubaddressAccount()));
+    if (account >= m_wallet->numSubaddressAccounts()) {
+        call->error(RpcServer::InvalidParams, "Invalid account");
+        return;
+    }
+
+    QJsonObject result;
+    result["account"] = static_cast<qint64>(account);
+    result["balance"] = static_cast<qint64>(m_wallet->balance(account));
+    result["unlocked_balance"] = static_cast<qint64>(m_wallet->unlockedBalance(account));
+    result["balance_all"] = static_cast<qint64>(m_wallet->balanceAll());
+    result["unlocked_balance_all"] = static_cast<qint64>(m_wallet->unlockedBalanceAll());
+    call->result(result);
+}
+
+void Headless::getAddress(const RpcCallPtr &call) {
+    auto account = static_cast<quint32>(call->params().value("account").toInteger(m_wallet->currentSubaddressAccount()));
+    auto index = static_cast<quint32>(call->params().value("index").toInteger(0));
+    if (account >= m_wallet->numSubaddressAccounts() || index >= m_wallet->numSubaddresses(account)) {
+        call->error(RpcServer::InvalidParams, "Invalid subaddress index");
+        return;
+    }
+
+    QJsonObject result;
+    result["address"] = m_wallet->address(account, index);
+    call->result(result);
+}
+
+void Headless::createAddress(const RpcCallPtr &call) {
+    QString label = call->params().value("label").toString();
+    quint32 account = m_wallet->currentSubaddressAccount();
+    quint32 index = m_wallet->numSubaddresses(account);
+
+    if (!m_wallet->subaddress()->addRow(label)) {
+        call->error(RpcServer::WalletError, m_wallet->subaddress()->getError());
+        return;
+    }
+
+    QJsonObject result;
+    result["account"] = static_cast<qint64>(account);
+    result["index"] = static_cast<qint64>(index);
+    result["address"] = m_wallet->address(account, index);
+    call->result(result);
+}
+
+void Headless::createAddresses(const RpcCallPtr &call) {
+    qint64 count = call->params().value("count").toInteger(0);
+    if (count <= 0 || count > 1000000) {
+        call->error(RpcServer::InvalidParams, "count must be between 1 and 1000000");
+        return;
+    }
+
+    if (m_addressesCall || !m_wallet->addSubaddresses(static_cast<quint32>(count), call->params().value("label").toString())) {
+        call->error(RpcServer::Busy, "Subaddresses are already being generated");
+        return;
+    }
+    m_addressesCall = call;
+}
+
+void Headless::onSubaddressesGenerated(quint32 accountIndex, quint32 first, quint32 count, const QString &error) {
+    RpcCallPtr call = m_addressesCall;
+    m_addressesCall.reset();
+    if (!call) {
+        return;
+    }
+
+    if (!error.isEmpty()) {
+        call->error(RpcServer::WalletError, error);
+        return;
+    }
+
+    QString exportPath = call->params().value("export_path").toString();
+    if (!exportPath.isEmpty() && !m_wallet->subaddress()->exportRows(exportPath, first, count)) {
+        call->error(RpcServer::WalletError, m_wallet->subaddress()->getError());
+        return;
+    }
+
+    QJsonObject result;
+    result["account"] = static_cast<qint64>(accountIndex);
+    result["first"] = static_cast<qint64>(first);
+    result["count"] = static_cast<qint64>(count);
+    call->result(result);
+}
+
+void Headless::selectAccount(const RpcCallPtr &call) {
+    QJsonValue account = call->params().value("account");
+    if (!account.isDouble() || account.toInteger() < 0 || account.toInteger() >= m_wallet->numSubaddressAccounts()) {
+        call->error(RpcServer::InvalidParams, "Invalid account");
+        return;
+    }
+
+    m_wallet->switchSubaddressAccount(static_cast<quint32>(account.toInteger()));
+    call->result(true);
+}
+
+void Headless::getHistory(const RpcCallPtr &call) {
+    // No views are attached in headless mode, so per-block refreshes are deferred until rows are read
+    m_wallet->history()->refreshIfStale();
+    streamRows<TransactionRow>(call, m_wallet->history()->getRows(), transactionToJson);
+}
+
+void Headless::getCoins(const RpcCallPtr &call) {
+    m_wallet->coins()->refreshIfStale();
+
+    bool includeSpent = call->params().value("include_spent").toBool(false);
+    streamRows<CoinsInfo>(call, m_wallet->coins()->getRows(), coinToJson, [includeSpent](const CoinsInfo &coin) {
+        return includeSpent || !coin.spent;
+    });
+}
+
+void Headless::setTxNote(const RpcCallPtr &call) {
+    QString txid = call->params().value("txid").toString();
+    if (txid.isEmpty()) {
+        call->error(RpcServer::InvalidParams, "Missing txid");
+        return;
+    }
+
+    if (!m_wallet->setUserNote(txid, call->params().value("note").toString())) {
+        call->error(RpcServer::WalletError, m_wallet->errorString());
+        return;
+    }
+
+    m_wallet->history()->requestRefresh();
+    call->result(true);
+}
+
+void Headless::setTxNotes(const RpcCallPtr &call) {
+    const QJsonArray notes = call->params().value("notes").toArray();
+    if (notes.isEmpty()) {
+        call->error(RpcServer::InvalidParams, "Missing notes");
+        return;
+    }
+
+    QList<QPair<QString, QString>> pairs;
+    pairs.reserve(notes.size());
+    for (const auto &note : notes) {
+        QJsonObject obj = note.toObject();
+        pairs.append({obj.value("txid").toString(), obj.value("note").toString()});
+    }
+
+    TxNotesResult notesResult = m_wallet->history()->setTxNotes(pairs);
+
+    QJsonObject result;
+    result["updated"] = static_cast<qint64>(notesResult.updated);
+    result["invalid"] = static_cast<qint64>(notesResult.invalid);
+    result["unmatched"] = static_cast<qint64>(notesResult.unmatched);
+    result["invalid_sample"] = QJsonArray::fromStringList(notesResult.invalidSample);
+    result["unmatched_sample"] = QJsonArray::fromStringList(notesResult.unmatchedSample);
+    call->result(result);
+}
+
+void Headless::createTransaction(const RpcCallPtr &call) {
+    if (m_createCall) {
+        call->error(RpcServer::Busy, "Another transaction is being constructed");
+        return;
+    }
+
+    const QJsonArray destinations = call->params().value("destinations").toArray();
+    if (destinations.isEmpty()) {
+        call->error(RpcServer::InvalidParams, "Missing destinations");
+        return;
+    }
+
+    QVector<QString> addresses;
+    QVector<quint64> amounts;
+    for (const auto &destination : destinations) {
+        QString address = destination.toObject().value("address").toString();
+        qint64 amount = destination.toObject().value("amount").toInteger(0);
+
+        if (!WalletManager::addressValid(address, m_wallet->nettype())) {
+            call->error(RpcServer::InvalidParams, QString("Invalid address: %1").arg(address));
+            return;
+        }
+        if (amount <= 0) {
+            call->error(RpcServer::InvalidParams, "Amounts must be positive integers in atomic units");
+            return;
+        }
+
+        addresses.append(address);
+        amounts.append(static_cast<quint64>(amount));
+    }
+
+    QStringList inputs;
+    for (const auto &keyImage : call->params().value("inputs").toArray()) {
+        inputs.append(keyImage.toString());
+    }
+    m_wallet->setSelectedInputs(inputs);
+
+    m_createCall = call;
+    m_wallet->createTransactionMultiDest(addresses, amounts,
+                                         call->params().value("description").toString(),
+                                         call->params().value("priority").toInt(0),
+                                         call->params().value("subtract_fee_from_amount").toBool(false));
+}
+
+void Headless::onTransactionCreated(PendingTransaction *tx, const QVector<QString> &address) {
+    Q_UNUSED(address)
+
+    RpcCallPtr call = m_createCall;
+    m_createCall.reset();
+    m_wallet->setSelectedInputs({});
+
+    if (!call) {
+        m_wallet->disposeTransaction(tx);
+        return;
+    }
+
+    if (tx->status() != PendingTransaction::Status_Ok) {
+        call->error(RpcServer::WalletError, tx->errorString());
+        m_wallet->disposeTransaction(tx);
+        return;
+    }
+
+    QStringList txids = tx->txid();
+    if (txids.isEmpty()) {
+        call->error(RpcServer::WalletError, "No transaction was constructed");
+        m_wallet->disposeTransaction(tx);
+        return;
+    }
+
+    m_pending.insert(txids.first(), tx);
+
+    QJsonObject result;
+    result["handle"] = txids.first();
+    result["txids"] = QJsonArray::fromStringList(txids);
+    result["amount"] = static_cast<qint64>(tx->amount());
+    result["fee"] = static_cast<qint64>(tx->fee());
+    result["tx_count"] = static_cast<qint64>(tx->txCount());
+    call->result(result);
+}
+
+void Headless::commitTransaction(const RpcCallPtr &call) {
+    QString handle = call->params().value("handle").toString();
+    PendingTransaction *tx = m_pending.take(handle);
+    if (!tx) {
+        call->error(RpcServer::InvalidParams, "Unknown transaction handle");
+        return;
+    }
+
+    m_commitCalls.insert(tx, call);
+    m_wallet->commitTransaction(tx, call->params().value("description").toString());
+}
+
+void Headless::onTransactionCommitted(bool success, PendingTransaction *tx, const QStringList &txid) {
+    RpcCallPtr call = m_commitCalls.take(tx);
+
+    if (call) {
+        if (success) {
+            QJsonObject result;
+            result["txids"] = QJsonArray::fromStringList(txid);
+            call->result(result);
+        } else {
+            call->error(RpcServer::WalletError, tx->errorString());
+        }
+    }
+
+    m_wallet->disposeTransaction(tx);
+    m_wallet->history()->requestRefresh();
+    m_wallet->coins()->requestRefresh();
+}
+
+void Headless::discardTransaction(const RpcCallPtr &call) {
+    PendingTransaction *tx = m_pending.take(call->params().value("handle").toString());
+    if (!tx) {
+        call->error(RpcServer::InvalidParams, "Unknown transaction handle");
+        return;
+    }
+
+    m_wallet->disposeTransaction(tx);
+    call->result(true);
+}
+
+void Headless::exportKeyImages(const RpcCallPtr &call) {
+    QString path = call->params().value("path").toString();
+    if (path.isEmpty()) {
+        call->error(RpcServer::InvalidParams, "Missing path");
+        return;
+    }
+
+    bool all = call->params().value("all").toBool(false);
+    if (!call->params().value("compress").toBool(false)) {
+        if (!m_wallet->exportKeyImages(path, all)) {
+            call->error(RpcServer::WalletError, m_wallet->errorString());
+            return;
+        }
+        call->result(true);
+        return;
+    }
+
+    std::string data;
+    if (!m_wallet->exportKeyImagesToStr(data, all)) {
+        call->error(RpcServer::WalletError, m_wallet->errorString());
+        return;
+    }
+    QString error = "Compression failed";
+    if (!OtsContainer::pack(data) || !OtsContainer::writeFile(path, data, &error)) {
+        call->error(RpcServer::InternalError, error);
+        return;
+    }
+    call->result(true);
+}
+
+void Headless::exportOutputs(const RpcCallPtr &call) {
+    QString path = call->params().value("path").toString();
+    if (path.isEmpty()) {
+        call->error(RpcServer::InvalidParams, "Missing path");
+        return;
+    }
+
+    bool all = call->params().value("all").toBool(false);
+    if (!call->params().value("compress").toBool(false)) {
+        if (!m_wallet->exportOutputs(path, all)) {
+            call->error(RpcServer::WalletError, m_wallet->errorString());
+            return;
+        }
+        call->result(true);
+        return;
+    }
+
+    std::string data;
+    if (!m_wallet->exportOutputsToStr(data, all)) {
+        call->error(RpcServer::WalletError, m_wallet->errorString());
+        return;
+    }
+    QString error = "Compression failed";
+    if (!OtsContainer::pack(data) || !OtsContainer::writeFile(path, data, &error)) {
+        call->error(RpcServer::InternalError, error);
+        return;
+    }
+    call->result(true);
+}
+
+void Headless::store(const RpcCallPtr &call) {
+    m_wallet->store();
+    call->result(true);
+}
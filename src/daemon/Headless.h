@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_HEADLESS_H
+#define FEATHER_HEADLESS_H
+
+#include <QHash>
+#include <QObject>
+
+#include "daemon/RpcServer.h"
+
+class Nodes;
+class PendingTransaction;
+class Wallet;
+class WalletManager;
+
+// Runs a single wallet without any windows and serves it over RpcServer, for scripting and benchmarks.
+//
+// Node selection and Tor are set up exactly as in the GUI, from the same config.
+class Headless : public QObject
+{
+    Q_OBJECT
+
+public:
+    Headless(QString walletPath, QString password, QString socketName, QObject *parent = nullptr);
+    ~Headless() override;
+
+    //! starts opening the wallet, the RPC server starts listening once it is open
+    bool start();
+
+private slots:
+    void onWalletOpened(Wallet *wallet);
+    void onTransactionCreated(PendingTransaction *tx, const QVector<QString> &address);
+    void onTransactionCommitted(bool success, PendingTransaction *tx, const QStringList &txid);
+    void onSubaddressesGenerated(quint32 accountIndex, quint32 first, quint32 count, const QString &error);
+
+private:
+    void registerMethods();
+    void shutdown(int exitCode);
+
+    //! finishes the call with an error and returns false if no wallet is open
+    bool requireWallet(const RpcCallPtr &call);
+
+    void getStatus(const RpcCallPtr &call);
+    void getNodeStats(const RpcCallPtr &call);
+    void getBalance(const RpcCallPtr &call);
+    void getAddress(const RpcCallPtr &call);
+    void createAddress(const RpcCallPtr &call);
+    void createAddresses(const RpcCallPtr &call);
+    void selectAccount(const RpcCallPtr &call);
+    void getHistory(const RpcCallPtr &call);
+    void getCoins(const RpcCallPtr &call);
+    void setTxNote(const RpcCallPtr &call);
+    void setTxNotes(const RpcCallPtr &call);
+    void createTransaction(const RpcCallPtr &call);
+    void commitTransaction(const RpcCallPtr &call);
+    void discardTransaction(const RpcCallPtr &call);
+    void exportKeyImages(const RpcCallPtr &call);
+    void exportOutputs(const RpcCallPtr &call);
+    void store(const RpcCallPtr &call);
+
+    QString m_walletPath;
+    QString m_password;
+    QString m_socketName;
+
+    WalletManager *m_walletManager;
+    RpcServer *m_server;
+    Wallet *m_wallet = nullptr;
+    Nodes *m_nodes = nullptr;
+
+    // Constructed transactions waiting for commit_transaction, keyed by the txid of their first transaction
+    QHash<QString, PendingTransaction*> m_pending;
+    RpcCallPtr m_createCall;
+    QHash<PendingTransaction*, RpcCallPtr> m_commitCalls;
+    RpcCallPtr m_addressesCall;
+};
+
+#endif //FEATHER_HEADLESS_H
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "RpcServer.h"
+
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "utils/Metrics.h"
+
+namespace {
+    // Requests are small, anything bigger than this is a client bug
+    constexpr qsizetype maxRequestSize = 4 * 1024 * 1024;
+}
+
+RpcCall::RpcCall(QLocalSocket *socket, QJsonValue id, QString method, QJsonObject params)
+    : m_socket(socket)
+    , m_id(std::move(id))
+    , m_method(std::move(method))
+    , m_params(std::move(params))
+{
+}
+
+void RpcCall::stream(const QJsonArray &rows) {
+    if (m_finished) {
+        return;
+    }
+
+    QJsonObject params;
+    params["id"] = m_id;
+    params["rows"] = rows;
+
+    QJsonObject message;
+    message["jsonrpc"] = "2.0";
+    message["method"] = "stream";
+    message["params"] = params;
+    this->send(message);
+}
+
+void RpcCall::result(const QJsonValue &result) {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    QJsonObject message;
+    message["jsonrpc"] = "2.0";
+    message["id"] = m_id;
+    message["result"] = result;
+    this->send(message);
+}
+
+void RpcCall::error(int code, const QString &message) {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    QJsonObject error;
+    error["code"] = code;
+    error["message"] = message;
+
+    QJsonObject response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = m_id;
+    response["error"] = error;
+    this->send(response);
+}
+
+void RpcCall::send(const QJsonObject &message) {
+    if (!m_socket) {
+        return;
+    }
+
+    m_socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+    m_socket->flush();
+}
+
+RpcServer::RpcServer(QObject *parent)
+    : QObject(parent)
+    , m_server(new QLocalServer(this))
+{
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &RpcServer::onNewConnection);
+}
+
+RpcServer::~RpcServer() {
+    m_server->close();
+}
+
+bool RpcServer::listen(const QString &name) {
+    // A socket left behind by a crashed instance would make listen() fail, but don't steal a live one
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(150)) {
+        probe.abort();
+        qCritical() << "RPC server: another instance is already listening on" << name;
+        return false;
+    }
+    QLocalServer::removeServer(name);
+
+    if (!m_server->listen(name)) {
+        qCritical() << "RPC server: unable to listen on" << name << ":" << m_server->errorString();
+        return false;
+    }
+
+    qInfo() << "RPC server: listening on" << m_server->fullServerName();
+    return true;
+}
+
+QString RpcServer::serverName() const {
+    return m_server->fullServerName();
+}
+
+QString RpcServer::errorString() const {
+    return m_server->errorString();
+}
+
+void RpcServer::registerMethod(const QString &method, Handler handler) {
+    m_methods.insert(method, std::move(handler));
+}
+
+void RpcServer::onNewConnection() {
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        m_buffers.insert(socket, {});
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]{
+            this->onReadyRead(socket);
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]{
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void RpcServer::onReadyRead(QLocalSocket *socket) {
+    QByteArray &buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    qsizetype start = 0;
+    qsizetype end;
+    while ((end = buffer.indexOf('\n', start)) >= 0) {
+        QByteArray line = buffer.mid(start, end - start).trimmed();
+        start = end + 1;
+        if (!line.isEmpty()) {
+            this->dispatch(socket, line);
+        }
+    }
+    buffer.remove(0, start);
+
+    if (buffer.size() > maxRequestSize) {
+        qWarning() << "RPC server: request too large, closing connection";
+        m_buffers.remove(socket);
+        socket->abort();
+    }
+}
+
+void RpcServer::dispatch(QLocalSocket *socket, const QByteArray &line) {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        RpcCall(socket, QJsonValue::Null, {}, {}).error(ParseError, "Parse error");
+        return;
+    }
+
+    QJsonObject request = doc.object();
+    QJsonValue id = request.value("id");
+    QString method = request.value("method").toString();
+    if (method.isEmpty()) {
+        RpcCall(socket, id, {}, {}).error(InvalidRequest, "Invalid request");
+        return;
+    }
+
+    QJsonValue params = request.value("params");
+    if (!params.isUndefined() && !params.isNull() && !params.isObject()) {
+        RpcCall(socket, id, method, {}).error(InvalidParams, "Params must be an object");
+        return;
+    }
+
+    auto call = RpcCallPtr::create(socket, id, method, params.toObject());
+
+    auto handler = m_methods.constFind(method);
+    if (handler == m_methods.constEnd()) {
+        call->error(MethodNotFound, QString("Method not found: %1").arg(method));
+        return;
+    }
+
+    METRICS_SCOPE("RpcServer::dispatch");
+    try {
+        (*handler)(call);
+    }
+    catch (const std::exception &e) {
+        call->error(InternalError, QString::fromStdString(e.what()));
+    }
+}
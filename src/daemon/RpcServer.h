@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_RPCSERVER_H
+#define FEATHER_RPCSERVER_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+
+#include <functional>
+
+class QLocalServer;
+class QLocalSocket;
+
+// A single JSON-RPC request. Handlers may keep the call around and answer it later, e.g. once a transaction is
+// constructed on the wallet thread. If the client disconnects in the meantime, replies are dropped.
+class RpcCall
+{
+public:
+    RpcCall(QLocalSocket *socket, QJsonValue id, QString method, QJsonObject params);
+
+    const QString& method() const { return m_method; }
+    const QJsonObject& params() const { return m_params; }
+
+    //! sends a chunk of a streamed result as a "stream" notification, ahead of the final response
+    void stream(const QJsonArray &rows);
+    void result(const QJsonValue &result);
+    void error(int code, const QString &message);
+
+    bool isFinished() const { return m_finished; }
+
+private:
+    void send(const QJsonObject &message);
+
+    QPointer<QLocalSocket> m_socket;
+    QJsonValue m_id;
+    QString m_method;
+    QJsonObject m_params;
+    bool m_finished = false;
+};
+
+using RpcCallPtr = QSharedPointer<RpcCall>;
+
+// JSON-RPC 2.0 over a local socket (a Unix domain socket, or a named pipe on Windows).
+//
+// Messages are single-line JSON objects separated by '\n', in both directions. Requests from one client are handled
+// in order, but a response may arrive after responses to later requests if its handler is asynchronous.
+class RpcServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum ErrorCode {
+        ParseError = -32700,
+        InvalidRequest = -32600,
+        MethodNotFound = -32601,
+        InvalidParams = -32602,
+        InternalError = -32603,
+        WalletError = -1,
+        Busy = -2
+    };
+
+    using Handler = std::function<void(const RpcCallPtr &call)>;
+
+    explicit RpcServer(QObject *parent = nullptr);
+    ~RpcServer() override;
+
+    bool listen(const QString &name);
+    QString serverName() const;
+    QString errorString() const;
+
+    void registerMethod(const QString &method, Handler handler);
+
+private:
+    void onNewConnection();
+    void onReadyRead(QLocalSocket *socket);
+    void dispatch(QLocalSocket *socket, const QByteArray &line);
+
+    QLocalServer *m_server;
+    QHash<QString, Handler> m_methods;
+    QHash<QLocalSocket*, QByteArray> m_buffers;
+};
+
+#endif //FEATHER_RPCSERVER_H
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ConsolidateDialog.h"
+#include "ui_ConsolidateDialog.h"
+
+#include <QMessageBox>
+#include <QTreeWidgetItem>
+
+#include "utils/Utils.h"
+#include "libwalletqt/WalletManager.h"
+
+ConsolidateDialog::ConsolidateDialog(QWidget *parent, Wallet *wallet)
+        : QDialog(parent)
+        , ui(new Ui::ConsolidateDialog)
+        , m_wallet(wallet)
+{
+    ui->setupUi(this);
+
+    connect(ui->btn_plan, &QPushButton::clicked, this, &ConsolidateDialog::plan);
+    connect(ui->btn_consolidate, &QPushButton::clicked, this, &ConsolidateDialog::consolidate);
+    connect(ui->btn_cancel, &QPushButton::clicked, [this] {
+        m_wallet->cancelConsolidation();
+        ui->btn_cancel->setEnabled(false);
+        ui->label_status->setText("Cancelling after the current transaction..");
+    });
+
+    connect(m_wallet, &Wallet::consolidationPlanned, this, &ConsolidateDialog::onPlanned);
+    connect(m_wallet, &Wallet::consolidationProgress, this, &ConsolidateDialog::onProgress);
+    connect(m_wallet, &Wallet::consolidationFinished, this, &ConsolidateDialog::onFinished);
+
+    ui->label_maxInputs->setText(QString("Up to %1 outputs per transaction").arg(ConsolidationPlanner::maxInputsPerTx()));
+    ui->progressBar->hide();
+    ui->btn_consolidate->setEnabled(false);
+    ui->btn_cancel->setEnabled(false);
+    ui->label_summary->setText("");
+    ui->label_status->setText("");
+
+    this->setBusy(m_wallet->isConsolidating());
+}
+
+void ConsolidateDialog::plan() {
+    ConsolidationPlanner::Params params;
+    params.maxOutputAmount = WalletManager::amountFromString(ui->line_maxOutputAmount->text());
+    params.feeBudget = WalletManager::amountFromString(ui->line_feeBudget->text());
+    m_feeLevel = ui->combo_feePriority->currentIndex();
+
+    if (!m_wallet->planConsolidation(params, m_feeLevel)) {
+        ui->label_status->setText("Wallet is busy, try again later");
+        return;
+    }
+
+    ui->btn_plan->setEnabled(false);
+    ui->btn_consolidate->setEnabled(false);
+    ui->label_status->setText("Planning..");
+}
+
+void ConsolidateDialog::onPlanned(const ConsolidationPlan &plan, const QString &error) {
+    ui->btn_plan->setEnabled(!m_wallet->isConsolidating());
+    ui->tree_batches->clear();
+    m_plan = plan;
+
+    if (!error.isEmpty()) {
+        ui->label_summary->setText("");
+        ui->label_status->setText(QString("Unable to plan: %1").arg(error));
+        return;
+    }
+
+    for (const auto &batch : plan.batches) {
+        auto *item = new QTreeWidgetItem(ui->tree_batches);
+        item->setText(0, QString("%1/%2").arg(QString::number(batch.accountIndex), QString::number(batch.subaddressIndex)));
+        item->setText(1, QString::number(batch.keyImages.size()));
+        item->setText(2, WalletManager::displayAmount(batch.amount));
+        item->setText(3, QString("%1 kB").arg(QString::number(batch.weight / 1000.0, 'f', 1)));
+        item->setText(4, WalletManager::displayAmount(batch.fee));
+        for (int i = 1; i < 5; i++) {
+            item->setTextAlignment(i, Qt::AlignRight);
+        }
+    }
+
+    QStringList skipped;
+    if (plan.skippedFrozen > 0) {
+        skipped << QString("%1 frozen").arg(plan.skippedFrozen);
+    }
+    if (plan.skippedLocked > 0) {
+        skipped << QString("%1 locked").arg(plan.skippedLocked);
+    }
+    if (plan.skippedUneconomical > 0) {
+        skipped << QString("%1 worth less than their fee").arg(plan.skippedUneconomical);
+    }
+    if (plan.skippedOverBudget > 0) {
+        skipped << QString("%1 over budget").arg(plan.skippedOverBudget);
+    }
+
+    QString summary = QString("%1 outputs in %2 transactions, estimated fee %3 XMR (%4 piconero/byte)")
+            .arg(QString::number(plan.inputs), QString::number(plan.batches.size()),
+                 WalletManager::displayAmount(plan.totalFee, false), QString::number(plan.feePerByte));
+    if (!skipped.isEmpty()) {
+        summary += QString("\nSkipped: %1").arg(skipped.join(", "));
+    }
+    ui->label_summary->setText(summary);
+
+    ui->label_status->setText(plan.batches.isEmpty() ? "Nothing to consolidate" : "");
+    ui->btn_consolidate->setEnabled(!plan.batches.isEmpty() && !m_wallet->isConsolidating());
+}
+
+void ConsolidateDialog::consolidate() {
+    if (m_plan.batches.isEmpty()) {
+        return;
+    }
+
+    auto result = QMessageBox::question(this, "Consolidate outputs",
+                                        QString("Send %1 transactions for an estimated fee of %2 XMR?\n\n"
+                                                "Transactions are sent one after another without further confirmation.")
+                                                .arg(QString::number(m_plan.batches.size()), WalletManager::displayAmount(m_plan.totalFee, false)));
+    if (result != QMessageBox::Yes) {
+        return;
+    }
+
+    quint64 feeBudget = WalletManager::amountFromString(ui->line_feeBudget->text());
+    if (!m_wallet->consolidateOutputs(m_plan.batches, m_feeLevel, feeBudget)) {
+        ui->label_status->setText("Unable to start consolidation");
+        return;
+    }
+
+    ui->progressBar->setMaximum(m_plan.batches.size());
+    ui->progressBar->setValue(0);
+    ui->label_status->setText("Sending transaction 1..");
+    this->setBusy(true);
+}
+
+void ConsolidateDialog::onProgress(int completed, int total, quint64 feePaid) {
+    ui->progressBar->setMaximum(total);
+    ui->progressBar->setValue(completed);
+    ui->label_status->setText(QString("Sent %1 of %2 transactions, fee paid: %3 XMR")
+                                      .arg(QString::number(completed), QString::number(total), WalletManager::displayAmount(feePaid, false)));
+}
+
+void ConsolidateDialog::onFinished(int completed, int total, quint64 feePaid, const QString &error) {
+    this->setBusy(false);
+    m_plan = {};
+    ui->tree_batches->clear();
+    ui->btn_consolidate->setEnabled(false);
+
+    QString status = QString("Sent %1 of %2 transactions, fee paid: %3 XMR")
+            .arg(QString::number(completed), QString::number(total), WalletManager::displayAmount(feePaid, false));
+    if (!error.isEmpty()) {
+        status += QString("\nStopped: %1").arg(error);
+    }
+    ui->label_status->setText(status);
+}
+
+void ConsolidateDialog::setBusy(bool busy) {
+    ui->progressBar->setVisible(busy);
+    ui->btn_cancel->setEnabled(busy);
+    ui->btn_plan->setEnabled(!busy);
+    ui->btn_consolidate->setEnabled(!busy && !m_plan.batches.isEmpty());
+    ui->frame_params->setEnabled(!busy);
+}
+
+ConsolidateDialog::~ConsolidateDialog() = default;
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_CONSOLIDATEDIALOG_H
+#define FEATHER_CONSOLIDATEDIALOG_H
+
+#include <QDialog>
+
+#include "components.h"
+#include "libwalletqt/Wallet.h"
+
+namespace Ui {
+    class ConsolidateDialog;
+}
+
+class ConsolidateDialog : public QDialog
+{
+Q_OBJECT
+
+public:
+    explicit ConsolidateDialog(QWidget *parent, Wallet *wallet);
+    ~ConsolidateDialog() override;
+
+private:
+    void plan();
+    void consolidate();
+    void onPlanned(const ConsolidationPlan &plan, const QString &error);
+    void onProgress(int completed, int total, quint64 feePaid);
+    void onFinished(int completed, int total, quint64 feePaid, const QString &error);
+    void setBusy(bool busy);
+
+    QScopedPointer<Ui::ConsolidateDialog> ui;
+    Wallet *m_wallet;
+    ConsolidationPlan m_plan;
+    int m_feeLevel = 0;
+};
+
+
+#endif //FEATHER_CONSOLIDATEDIALOG_H
@@ -4,7 +4,13 @@
 #include "DebugInfoDialog.h"
 #include "ui_DebugInfoDialog.h"
 
+#include <QJsonDocument>
+
+#include "libwalletqt/Coins.h"
+#include "libwalletqt/Subaddress.h"
+#include "libwalletqt/TransactionHistory.h"
 #include "utils/AppData.h"
+#include "utils/Metrics.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
 #include "utils/TorManager.h"
@@ -20,6 +26,9 @@ DebugInfoDialog::DebugInfoDialog(Wallet *wallet, Nodes *nodes, QWidget *parent)
     ui->setupUi(this);
 
     connect(ui->btn_Copy, &QPushButton::clicked, this, &DebugInfoDialog::copyToClipboard);
+    connect(ui->btn_exportMetrics, &QPushButton::clicked, this, &DebugInfoDialog::exportMetrics);
+
+    ui->tree_metrics->header()->setSectionResizeMode(0, QHeaderView::Stretch);
 
     m_updateTimer.start(5000);
     connect(&m_updateTimer, &QTimer::timeout, this, &DebugInfoDialog::updateInfo);
@@ -123,6 +132,62 @@ void DebugInfoDialog::updateInfo() {
     }
     ui->label_OS->setText(os);
     ui->label_timestamp->setText(QString::number(QDateTime::currentSecsSinceEpoch()));
+
+    this->updateMetrics();
+}
+
+void DebugInfoDialog::updateMetrics() {
+    Metrics::gauge("history.rows")->set(m_wallet->history()->count());
+    Metrics::gauge("coins.rows")->set(m_wallet->coins()->count());
+    Metrics::gauge("subaddresses.rows")->set(m_wallet->subaddress()->count());
+    Metrics::gauge("network.bytesReceived")->set(m_wallet->getBytesReceived());
+    Metrics::gauge("network.bytesSent")->set(m_wallet->getBytesSent());
+    Metrics::gauge("memory.resident")->set(Metrics::residentMemory());
+
+    auto formatDuration = [](qint64 us) {
+        if (us < 1000) {
+            return QString("%1 µs").arg(us);
+        }
+        return QString("%1 ms").arg(us / 1000.0, 0, 'f', 1);
+    };
+
+    ui->tree_metrics->clear();
+
+    for (const auto &s : Metrics::histograms()) {
+        auto *item = new QTreeWidgetItem({s.name, QString::number(s.count), formatDuration(s.p50), formatDuration(s.p99), formatDuration(s.max)});
+        ui->tree_metrics->addTopLevelItem(item);
+    }
+
+    for (const auto &g : Metrics::gauges()) {
+        QString value;
+        if (g.second < 0) {
+            value = "n/a";
+        } else if (g.first.startsWith("network.") || g.first.startsWith("memory.")) {
+            value = Utils::formatBytes(g.second);
+        } else {
+            value = QString::number(g.second);
+        }
+        ui->tree_metrics->addTopLevelItem(new QTreeWidgetItem({g.first, value}));
+    }
+}
+
+void DebugInfoDialog::exportMetrics() {
+    QString fn = Utils::getSaveFileName(this, "Export performance counters", "feather_metrics.json", "JSON (*.json)");
+    if (fn.isEmpty()) {
+        return;
+    }
+
+    this->updateMetrics();
+
+    QFile file(fn);
+    if (!file.open(QIODevice::WriteOnly)) {
+        Utils::showError(this, "Unable to export performance counters", QString("Could not open file %1 for writing").arg(fn));
+        return;
+    }
+    file.write(QJsonDocument(Metrics::toJson()).toJson());
+    file.close();
+
+    Utils::showInfo(this, "Performance counters exported", QString("Exported to: %1").arg(fn));
 }
 
 QString DebugInfoDialog::statusToString(Wallet::ConnectionStatus status) {
@@ -26,6 +26,8 @@ private:
     QString statusToString(Wallet::ConnectionStatus status);
     void copyToClipboard();
     void updateInfo();
+    void updateMetrics();
+    void exportMetrics();
 
     QScopedPointer<Ui::DebugInfoDialog> ui;
     Wallet *m_wallet;
@@ -89,6 +89,7 @@ void HistoryExportDialog::exportHistory()
         return;
     }
 
+    m_wallet->history()->refreshIfStale();
     auto num_transactions = m_wallet->history()->count();
 
     QList<QPair<uint64_t, QString>> csvData;
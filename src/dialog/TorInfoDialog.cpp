@@ -20,6 +20,9 @@ TorInfoDialog::TorInfoDialog(QWidget *parent)
     connect(torManager(), &TorManager::statusChanged, this, &TorInfoDialog::onStatusChanged);
     connect(torManager(), &TorManager::connectionStateChanged, this, &TorInfoDialog::onConnectionStatusChanged);
     connect(torManager(), &TorManager::logsUpdated, this, &TorInfoDialog::onLogsUpdated);
+    connect(torManager(), &TorManager::bootstrapProgressChanged, [this] {
+        this->onConnectionStatusChanged(torManager()->torConnected);
+    });
 
     this->adjustSize();
 }
@@ -37,6 +40,10 @@ void TorInfoDialog::onConnectionStatusChanged(bool connected) {
         ui->icon_connectionStatus->setPixmap(QPixmap(":/assets/images/status_connected.svg").scaledToWidth(16, Qt::SmoothTransformation));
         ui->label_testConnectionStatus->setText("Connected");
     }
+    else if (torManager()->bootstrapProgress > 0 && torManager()->bootstrapProgress < 100) {
+        ui->icon_connectionStatus->setPixmap(QPixmap(":/assets/images/status_disconnected.svg").scaledToWidth(16, Qt::SmoothTransformation));
+        ui->label_testConnectionStatus->setText(QString("Bootstrapping (%1%): %2").arg(QString::number(torManager()->bootstrapProgress), torManager()->bootstrapSummary));
+    }
     else {
         ui->icon_connectionStatus->setPixmap(QPixmap(":/assets/images/status_disconnected.svg").scaledToWidth(16, Qt::SmoothTransformation));
         ui->label_testConnectionStatus->setText("Disconnected");
@@ -10,6 +10,8 @@
 
 #include "constants.h"
 #include "dialog/QrCodeDialog.h"
+#include "libwalletqt/AddressResolver.h"
+#include "libwalletqt/FeeHistory.h"
 #include "libwalletqt/rows/Input.h"
 #include "libwalletqt/rows/Output.h"
 #include "libwalletqt/WalletManager.h"
@@ -50,6 +52,9 @@ TxConfAdvDialog::TxConfAdvDialog(Wallet *wallet, const QString &description, QWi
         ui->label_txid->hide();
     }
 
+    ui->confirmation->hide();
+    ui->label_confirmation->hide();
+
     ui->treeInputs->setContextMenuPolicy(Qt::CustomContextMenu);
     ui->treeOutputs->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(ui->treeInputs, &QTreeView::customContextMenuRequested, [this](const QPoint &point){
@@ -83,6 +88,7 @@ void TxConfAdvDialog::setTransaction(PendingTransaction *tx, bool isSigned) {
     ui->txid->setText(m_txid);
 
     this->setAmounts(tx->amount(), tx->fee());
+    this->setConfirmationEstimate(ptx.fee, tx->weight(0));
 
     this->setupConstructionData(ptx);
 }
@@ -136,6 +142,48 @@ void TxConfAdvDialog::setAmounts(quint64 amount, quint64 fee) {
     }
 }
 
+void TxConfAdvDialog::setConfirmationEstimate(quint64 fee, quint64 weight) {
+    if (m_offline || weight == 0) {
+        return;
+    }
+
+    const FeeHistory *history = m_wallet->feeHistory();
+    const QVector<FeeEstimate> estimates = history->estimates();
+    if (estimates.isEmpty()) {
+        return;
+    }
+
+    // The highest tier the fee pays for
+    const quint64 feePerByte = fee / weight;
+    int tier = -1;
+    for (const auto &estimate : estimates) {
+        if (feePerByte >= estimate.feePerByte) {
+            tier = estimate.tier;
+        }
+    }
+    if (tier < 0) {
+        return;
+    }
+
+    const QStringList tierNames = {"Low", "Normal", "High", "Highest"};
+    QString text = QString("%1 (%2 fee)").arg(FeeHistory::formatEstimate(estimates[tier].seconds), tierNames.value(tier));
+
+    const int deadline = conf()->get(Config::confirmationDeadline).toInt();
+    if (deadline > 0) {
+        const int cheapest = history->cheapestTier(deadline * 60);
+        if (cheapest < 0) {
+            text += QString(", no fee tier is expected to confirm within %1 min").arg(deadline);
+        }
+        else if (cheapest != tier) {
+            text += QString(", a %1 fee is expected to confirm within %2 min").arg(tierNames.value(cheapest).toLower(), QString::number(deadline));
+        }
+    }
+
+    ui->confirmation->setText(text);
+    ui->confirmation->show();
+    ui->label_confirmation->show();
+}
+
 void TxConfAdvDialog::setupConstructionData(const ConstructionInfo& ci) {
     for (const auto &in: ci.inputs) {
         auto *item = new QTreeWidgetItem(ui->treeInputs);
@@ -154,17 +202,21 @@ void TxConfAdvDialog::setupConstructionData(const ConstructionInfo& ci) {
         item->setText(0, out.address);
         item->setText(1, WalletManager::displayAmount(out.amount));
         item->setFont(0, Utils::getMonospaceFont());
-        auto index = m_wallet->subaddressIndex(out.address);
+        AddressIdentity identity = m_wallet->addressResolver()->identify(out.address);
         QBrush brush;
-        if (index.isChange()) {
+        if (identity.subaddressIndex.isChange()) {
             brush = QBrush(ColorScheme::YELLOW.asColor(true));
             item->setToolTip(0, "Wallet change/primary address");
             // item->setHidden(true);
         }
-        else if (index.isValid()) {
+        else if (identity.isOwn()) {
             brush = QBrush(ColorScheme::GREEN.asColor(true));
             item->setToolTip(0, "Wallet receive address");
         }
+        else if (identity.isContact()) {
+            brush = QBrush(ColorScheme::BLUE.asColor(true));
+            item->setToolTip(0, QString("Contact: %1").arg(identity.contactLabel));
+        }
         else if (out.amount == 0) {
             brush = QBrush(ColorScheme::GRAY.asColor(true));
             item->setToolTip(0, "Dummy output (Min. 2 outs consensus rule)");
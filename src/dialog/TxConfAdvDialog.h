@@ -35,6 +35,7 @@ private:
     void broadcastTransaction();
     void closeDialog();
     void setAmounts(quint64 amount, quint64 fee);
+    void setConfirmationEstimate(quint64 fee, quint64 weight);
     void setupContextMenu(const QPoint &point, QTreeWidget *tree);
     void copyFromTree(const QPoint &point, int column, QTreeWidget *tree);
 
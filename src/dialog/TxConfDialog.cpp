@@ -6,6 +6,7 @@
 
 #include "constants.h"
 #include "TxConfAdvDialog.h"
+#include "libwalletqt/AddressResolver.h"
 #include "utils/AppData.h"
 #include "utils/ColorScheme.h"
 #include "utils/config.h"
@@ -52,7 +53,8 @@ TxConfDialog::TxConfDialog(Wallet *wallet, PendingTransaction *tx, const QString
     ui->label_fee->setText(QString("%1 (%2 %3)").arg(amounts[1], amounts_fiat[1], preferredCur));
     ui->label_total->setText(QString("%1 (%2 %3)").arg(amounts[2], amounts_fiat[2], preferredCur));
 
-    auto subaddressIndex = m_wallet->subaddressIndex(address);
+    AddressIdentity identity = m_wallet->addressResolver()->identify(address);
+    SubaddressIndex subaddressIndex = identity.subaddressIndex;
     QString addressExtra;
 
     ui->label_address->setText(Utils::displayAddress(address, 2));
@@ -71,6 +73,11 @@ TxConfDialog::TxConfDialog(Wallet *wallet, PendingTransaction *tx, const QString
         ui->label_address->setToolTip("Wallet change/primary address");
     }
 
+    if (!identity.isOwn() && identity.isContact()) {
+        ui->label_address->setStyleSheet(ColorScheme::BLUE.asStylesheet(true));
+        ui->label_address->setToolTip(QString("Contact: %1\n%2").arg(identity.contactLabel, address));
+    }
+
     if (tx->fee() > WalletManager::amountFromDouble(0.01)) {
         ui->label_fee->setStyleSheet(ColorScheme::RED.asStylesheet(true));
         ui->label_fee->setToolTip("Unrealistic fee. You may be connected to a malicious node.");
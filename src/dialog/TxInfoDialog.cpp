@@ -9,6 +9,7 @@
 
 #include "config.h"
 #include "constants.h"
+#include "libwalletqt/AddressResolver.h"
 #include "libwalletqt/Coins.h"
 #include "libwalletqt/rows/CoinsInfo.h"
 #include "libwalletqt/TransactionHistory.h"
@@ -36,6 +37,8 @@ TxInfoDialog::TxInfoDialog(Wallet *wallet, const TransactionRow &txInfo, QWidget
     connect(ui->btn_CopyTxKey, &QPushButton::clicked, this, &TxInfoDialog::copyTxKey);
     connect(ui->btn_createTxProof, &QPushButton::clicked, this, &TxInfoDialog::createTxProof);
 
+    // Keep confirmations up to date while the history tab is hidden
+    m_wallet->history()->attachView(this);
     connect(m_wallet, &Wallet::newBlock, this, &TxInfoDialog::updateData);
 
     this->setData(txInfo);
@@ -76,16 +79,17 @@ TxInfoDialog::TxInfoDialog(Wallet *wallet, const TransactionRow &txInfo, QWidget
     auto transfers = txInfo.transfers;
     if (!transfers.isEmpty()) {
         bool hasIntegrated = false;
+        AddressResolver *resolver = m_wallet->addressResolver();
 
         for (const auto& transfer : transfers) {
             auto address = transfer.address;
             auto amount = WalletManager::displayAmount(transfer.amount);
-            auto index = m_wallet->subaddressIndex(address);
-            cursor.insertText(address, Utils::addressTextFormat(index, transfer.amount));
+            AddressIdentity identity = resolver->identify(address);
+            cursor.insertText(address, Utils::addressTextFormat(identity, transfer.amount));
             cursor.insertText(QString(" %1").arg(amount), QTextCharFormat());
             cursor.insertBlock();
 
-            if (WalletManager::baseAddressFromIntegratedAddress(transfer.address, constants::networkType) != transfer.address) {
+            if (identity.integrated) {
                 hasIntegrated = true;
             }
         }
@@ -4,118 +4,73 @@
 #include "TxPoolViewerDialog.h"
 #include "ui_TxPoolViewerDialog.h"
 
+#include <QDateTime>
 #include <QTreeWidgetItem>
 
 #include "utils/Utils.h"
-#include "utils/ColorScheme.h"
 #include "libwalletqt/WalletManager.h"
 
 TxPoolViewerDialog::TxPoolViewerDialog(QWidget *parent, Wallet *wallet)
         : QDialog(parent)
         , ui(new Ui::TxPoolViewerDialog)
         , m_wallet(wallet)
+        , m_model(new TxPoolModel(this))
+        , m_proxyModel(new TxPoolProxyModel(this))
 {
     ui->setupUi(this);
 
+    m_proxyModel->setSourceModel(m_model);
+    ui->tree_pool->setModel(m_proxyModel);
+    ui->tree_pool->header()->setSectionResizeMode(TxPoolModel::Weight, QHeaderView::ResizeToContents);
+    ui->tree_pool->header()->setSectionResizeMode(TxPoolModel::Fee, QHeaderView::ResizeToContents);
+    ui->tree_pool->sortByColumn(TxPoolModel::FeePerByte, Qt::DescendingOrder);
+
     connect(ui->btn_refresh, &QPushButton::clicked, this, &TxPoolViewerDialog::refresh);
     connect(m_wallet, &Wallet::poolStats, this, &TxPoolViewerDialog::onTxPoolBacklog);
 
-    ui->tree_pool->sortByColumn(2, Qt::DescendingOrder);
+    // Only the difference to the previous poll is applied, so polling in the background is cheap
+    m_refreshTimer.setInterval(refreshInterval);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &TxPoolViewerDialog::refresh);
+    m_refreshTimer.start();
 
     this->refresh();
 }
 
 void TxPoolViewerDialog::refresh() {
+    if (m_refreshing || (!this->isVisible() && m_model->rowCount() > 0)) {
+        return;
+    }
+    m_refreshing = true;
     ui->btn_refresh->setEnabled(false);
     m_wallet->getTxPoolStatsAsync();
 }
 
-class TxPoolSortItem : public QTreeWidgetItem {
-public:
-    using QTreeWidgetItem::QTreeWidgetItem;
-
-    bool operator<(const QTreeWidgetItem &other) const override {
-        int column = treeWidget()->sortColumn();
-
-        return this->data(column, Qt::UserRole).toUInt() < other.data(column, Qt::UserRole).toUInt();
-    }
-};
-
 void TxPoolViewerDialog::onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit) {
+    m_refreshing = false;
     ui->btn_refresh->setEnabled(true);
 
     if (baseFees.size() != 4) {
         return;
     }
 
-    ui->tree_pool->clear();
-    ui->tree_feeTiers->clear();
-
-    m_feeTierStats.clear();
-    for (int i = 0; i < 4; i++) {
-        m_feeTierStats.push_back(FeeTierStats{});
-    }
-
-    ui->label_transactions->setText(QString::number(txPool.size()));
-
-    uint64_t totalWeight = 0;
-    uint64_t totalFees = 0;
-    for (const auto &entry : txPool) {
-        totalWeight += entry.weight;
-        totalFees += entry.fee;
-
-        auto* item = new TxPoolSortItem();
-        item->setText(0, QString("%1 B").arg(QString::number(entry.weight)));
-        item->setData(0, Qt::UserRole, entry.weight);
-        item->setTextAlignment(0, Qt::AlignRight);
-
-        item->setText(1, QString("%1 XMR").arg(WalletManager::displayAmount(entry.fee)));
-        item->setData(1, Qt::UserRole, entry.fee);
-        item->setTextAlignment(1, Qt::AlignRight);
-
-        quint64 fee_per_byte = entry.fee / entry.weight;
-        item->setText(2, QString::number(entry.fee / entry.weight));
-        item->setData(2, Qt::UserRole, entry.fee / entry.weight);
-        item->setTextAlignment(2, Qt::AlignRight);
-
-        if (fee_per_byte == baseFees[0]) {
-            item->setBackground(2, QBrush(ColorScheme::BLUE.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[1]) {
-            item->setBackground(2, QBrush(ColorScheme::GREEN.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[2]) {
-            item->setBackground(2, QBrush(ColorScheme::YELLOW.asColor(true)));
-        }
-        if (fee_per_byte == baseFees[3]) {
-            item->setBackground(2, QBrush(ColorScheme::RED.asColor(true)));
-        }
-
-        if (fee_per_byte >= baseFees[3]) {
-            m_feeTierStats[3].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[2]) {
-            m_feeTierStats[2].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[1]) {
-            m_feeTierStats[1].weightFromTip += entry.weight;
-        }
-        if (fee_per_byte >= baseFees[0]) {
-            m_feeTierStats[0].weightFromTip += entry.weight;
-        }
+    m_model->setBaseFees(baseFees);
+    m_model->applySnapshot(txPool, QDateTime::currentSecsSinceEpoch());
 
-        ui->tree_pool->addTopLevelItem(item);
-    }
+    ui->label_transactions->setText(QString::number(m_model->rowCount()));
+    ui->label_totalWeight->setText(Utils::formatBytes(m_model->totalWeight()));
+    ui->label_totalFees->setText(QString("%1 XMR").arg(WalletManager::displayAmount(m_model->totalFees())));
 
-    ui->tree_pool->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
-    ui->tree_pool->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    ui->histogram->setHistogram(m_model->histogram(), baseFees);
+    this->updateFeeTiers(blockWeightLimit);
+}
 
-    ui->label_totalWeight->setText(Utils::formatBytes(totalWeight));
-    ui->label_totalFees->setText(QString("%1 XMR").arg(WalletManager::displayAmount(totalFees)));
+void TxPoolViewerDialog::updateFeeTiers(quint64 blockWeightLimit) {
+    ui->tree_feeTiers->clear();
 
     quint64 fullRewardZone = blockWeightLimit >> 1;
     ui->label_blockWeightLimit->setText(Utils::formatBytes(fullRewardZone));
 
+    const QVector<quint64> &baseFees = m_model->baseFees();
     for (int i = 0; i < 4; i++) {
         QString tierName;
         switch (i) {
@@ -134,16 +89,18 @@ void TxPoolViewerDialog::onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool,
                 break;
         }
 
+        quint64 weightFromTip = m_model->tierWeight(i);
+
         auto* item = new QTreeWidgetItem();
         item->setText(0, tierName);
 
         item->setText(1, QString::number(baseFees[i]));
         item->setTextAlignment(1, Qt::AlignRight);
 
-        item->setText(2, QString(" %1 blocks").arg(QString::number(m_feeTierStats[i].weightFromTip / fullRewardZone))); // approximation
+        item->setText(2, QString(" %1 blocks").arg(QString::number(fullRewardZone ? weightFromTip / fullRewardZone : 0))); // approximation
         item->setTextAlignment(2, Qt::AlignRight);
 
-        item->setText(3, QString("%1 kB").arg(QString::number(m_feeTierStats[i].weightFromTip / 1000)));
+        item->setText(3, QString("%1 kB").arg(QString::number(weightFromTip / 1000)));
         item->setTextAlignment(3, Qt::AlignRight);
 
         ui->tree_feeTiers->addTopLevelItem(item);
@@ -5,20 +5,16 @@
 #define FEATHER_TXPOOLVIEWERDIALOG_H
 
 #include <QDialog>
+#include <QTimer>
 
 #include "components.h"
 #include "libwalletqt/Wallet.h"
+#include "model/TxPoolModel.h"
 
 namespace Ui {
     class TxPoolViewerDialog;
 }
 
-struct FeeTierStats {
-  quint64 transactions = 0;
-  quint64 totalWeight = 0;
-  quint64 weightFromTip = 0;
-};
-
 class TxPoolViewerDialog : public QDialog
 {
 Q_OBJECT
@@ -30,10 +26,16 @@ public:
 private:
     void refresh();
     void onTxPoolBacklog(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit);
+    void updateFeeTiers(quint64 blockWeightLimit);
 
-    QVector<FeeTierStats> m_feeTierStats;
     QScopedPointer<Ui::TxPoolViewerDialog> ui;
     Wallet *m_wallet;
+    TxPoolModel *m_model;
+    TxPoolProxyModel *m_proxyModel;
+    QTimer m_refreshTimer;
+    bool m_refreshing = false;
+
+    static constexpr int refreshInterval = 30 * 1000;
 };
 
 
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "AddressResolver.h"
+
+#include "AddressBook.h"
+#include "Subaddress.h"
+
+#include <wallet/wallet2.h>
+
+namespace {
+    QByteArray publicKeys(const cryptonote::account_public_address &address) {
+        QByteArray keys;
+        keys.reserve(2 * sizeof(crypto::public_key));
+        keys.append(reinterpret_cast<const char*>(&address.m_spend_public_key), sizeof(crypto::public_key));
+        keys.append(reinterpret_cast<const char*>(&address.m_view_public_key), sizeof(crypto::public_key));
+        return keys;
+    }
+}
+
+AddressResolver::AddressResolver(tools::wallet2 *wallet2, QReadWriteLock *subaddressLock, AddressBook *addressBook, Subaddress *subaddress, QObject *parent)
+    : QObject(parent)
+    , m_wallet2(wallet2)
+    , m_subaddressLock(subaddressLock)
+    , m_addressBook(addressBook)
+{
+    connect(m_addressBook, &AddressBook::refreshFinished, this, &AddressResolver::invalidate);
+
+    // Subaddresses are only ever added, so only addresses that weren't ours can change
+    auto dropForeign = [this]{
+        m_identities.removeIf([](const QHash<QString, AddressIdentity>::iterator it){
+            return !it->isOwn();
+        });
+    };
+    connect(subaddress, &Subaddress::refreshFinished, this, dropForeign);
+    connect(subaddress, &Subaddress::endAddRow, this, dropForeign);
+    connect(subaddress, &Subaddress::endAddRows, this, dropForeign);
+}
+
+AddressIdentity AddressResolver::identify(const QString &address) {
+    auto it = m_identities.constFind(address);
+    if (it != m_identities.cend()) {
+        return it.value();
+    }
+
+    if (m_identities.size() >= maxIdentities) {
+        m_identities.clear();
+    }
+    return m_identities.insert(address, this->resolve(address)).value();
+}
+
+void AddressResolver::invalidate() {
+    m_identities.clear();
+    m_contacts.clear();
+    m_contactsIndexed = false;
+}
+
+AddressIdentity AddressResolver::resolve(const QString &address) {
+    AddressIdentity identity;
+
+    cryptonote::address_parse_info info;
+    if (!cryptonote::get_account_address_from_str(info, m_wallet2->nettype(), address.toStdString())) {
+        return identity;
+    }
+    identity.valid = true;
+    identity.integrated = info.has_payment_id;
+
+    {
+        QReadLocker locker(m_subaddressLock);
+        auto index = m_wallet2->get_subaddress_index(info.address);
+        if (index) {
+            identity.subaddressIndex = SubaddressIndex(index->major, index->minor);
+        }
+    }
+
+    if (!m_contactsIndexed) {
+        this->indexContacts();
+    }
+    identity.contactIndex = m_contacts.value(publicKeys(info.address), -1);
+    if (identity.isContact()) {
+        identity.contactLabel = m_addressBook->getRows().at(identity.contactIndex).label;
+    }
+
+    return identity;
+}
+
+void AddressResolver::indexContacts() {
+    m_contacts.clear();
+
+    const auto &rows = m_wallet2->get_address_book();
+    for (size_t i = 0; i < rows.size() && i < static_cast<size_t>(m_addressBook->count()); i++) {
+        // The first contact wins if several share an address
+        QByteArray keys = publicKeys(rows[i].m_address);
+        if (!m_contacts.contains(keys)) {
+            m_contacts.insert(keys, static_cast<qsizetype>(i));
+        }
+    }
+
+    m_contactsIndexed = true;
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_ADDRESSRESOLVER_H
+#define FEATHER_ADDRESSRESOLVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include "Wallet.h"
+
+namespace tools {
+    class wallet2;
+}
+
+class AddressBook;
+class Subaddress;
+
+struct AddressIdentity
+{
+    bool valid = false;          // an address of the wallet's network
+    bool integrated = false;
+    SubaddressIndex subaddressIndex{-1, -1};
+    qsizetype contactIndex = -1; // row in the address book
+    QString contactLabel;
+
+    bool isOwn() const {
+        return subaddressIndex.isValid();
+    }
+
+    bool isContact() const {
+        return contactIndex >= 0;
+    }
+};
+
+// Tells whose an address is, for views that annotate lists of addresses.
+//
+// Every address is decoded once. The result is kept until the address book or the subaddresses change, so opening the
+// details of a transaction with hundreds of destinations doesn't decode each of them again. Contacts are indexed by
+// their public keys, which also matches integrated addresses built from a contact's address.
+//
+// Not thread-safe, call from the GUI thread.
+class AddressResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AddressResolver(tools::wallet2 *wallet2, QReadWriteLock *subaddressLock, AddressBook *addressBook, Subaddress *subaddress, QObject *parent);
+
+    AddressIdentity identify(const QString &address);
+
+    //! drops everything looked up so far, done automatically on address book and subaddress changes
+    void invalidate();
+
+private:
+    AddressIdentity resolve(const QString &address);
+    void indexContacts();
+
+    tools::wallet2 *m_wallet2;
+    QReadWriteLock *m_subaddressLock;
+    AddressBook *m_addressBook;
+
+    QHash<QString, AddressIdentity> m_identities;
+
+    // Spend and view public key of each contact to its row
+    QHash<QByteArray, qsizetype> m_contacts;
+    bool m_contactsIndexed = false;
+
+    // Bounds the memory held for views of many distinct addresses
+    static constexpr qsizetype maxIdentities = 10000;
+};
+
+#endif //FEATHER_ADDRESSRESOLVER_H
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "BalanceLedger.h"
+
+#include <algorithm>
+
+#include <wallet/wallet2.h>
+
+#include "utils/Metrics.h"
+
+BalanceLedger::BalanceLedger(tools::wallet2 *wallet2)
+        : m_wallet2(wallet2)
+{
+}
+
+bool BalanceLedger::update() {
+    METRICS_SCOPE("BalanceLedger::update");
+
+    boost::shared_lock<boost::shared_mutex> transfers_lock(m_wallet2->m_transfers_mutex);
+
+    const quint64 height = m_wallet2->get_blockchain_current_height();
+    const size_t count = m_wallet2->get_num_transfer_details();
+
+    // Transfers are only ever appended, unless blocks were detached or the wallet was rescanned
+    bool consistent = !m_invalidated && count >= m_entries.size() && height >= m_height;
+    if (consistent && !m_entries.empty()) {
+        const auto &td = m_wallet2->get_transfer_details(m_entries.size() - 1);
+        consistent = td.m_global_output_index == m_entries.back().globalIndex;
+    }
+
+    bool changed = false;
+    if (!consistent) {
+        this->rebuild();
+        changed = true;
+    }
+    m_height = height;
+
+    for (size_t i = m_entries.size(); i < count; i++) {
+        this->addEntry(i, height);
+        changed = true;
+    }
+
+    changed |= this->watchEntries(height);
+    changed |= this->processUnlocks(height);
+    changed |= this->updatePendingChange();
+
+    return changed;
+}
+
+void BalanceLedger::invalidate() {
+    m_invalidated = true;
+}
+
+void BalanceLedger::rebuild() {
+    m_entries.clear();
+    m_watched.clear();
+    m_timeLocked.clear();
+    m_pendingUnlocks = {};
+    m_accounts.clear();
+    m_subaddresses.clear();
+    m_total = {};
+    m_height = 0;
+    m_invalidated = false;
+}
+
+void BalanceLedger::addEntry(size_t index, quint64 height) {
+    const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(index);
+
+    Entry entry;
+    entry.account = td.m_subaddr_index.major;
+    entry.subaddress = td.m_subaddr_index.minor;
+    entry.amount = td.amount();
+    entry.globalIndex = td.m_global_output_index;
+    entry.spent = td.m_spent;
+    entry.spentHeight = td.m_spent_height;
+    entry.frozen = td.m_frozen;
+
+    // Same rules as wallet2::is_transfer_unlocked()
+    const quint64 unlockTime = td.m_tx.unlock_time;
+    if (unlockTime < CRYPTONOTE_MAX_BLOCK_NUMBER) {
+        entry.unlockHeight = std::max<quint64>(td.m_block_height + CRYPTONOTE_DEFAULT_TX_SPENDABLE_AGE, unlockTime);
+        entry.unlocked = height >= entry.unlockHeight;
+    } else {
+        entry.unlocked = m_wallet2->is_transfer_unlocked(td);
+    }
+
+    m_entries.push_back(entry);
+    this->apply(entry, true);
+
+    if (!entry.unlocked) {
+        if (entry.unlockHeight > 0) {
+            m_pendingUnlocks.emplace(entry.unlockHeight, index);
+        } else {
+            m_timeLocked.push_back(index);
+        }
+    }
+
+    if (!entry.spent || entry.spentHeight == 0 || entry.spentHeight + reorgHorizon > height) {
+        m_watched.push_back(index);
+    }
+}
+
+bool BalanceLedger::watchEntries(quint64 height) {
+    bool changed = false;
+
+    size_t kept = 0;
+    for (size_t index : m_watched) {
+        const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(index);
+        Entry &entry = m_entries[index];
+
+        if (td.m_spent != entry.spent || td.m_frozen != entry.frozen) {
+            this->apply(entry, false);
+            entry.spent = td.m_spent;
+            entry.frozen = td.m_frozen;
+            this->apply(entry, true);
+            changed = true;
+        }
+        entry.spentHeight = td.m_spent_height;
+
+        // A spend in the pool (spent height 0) or in a recent block can still be undone
+        if (!entry.spent || entry.spentHeight == 0 || entry.spentHeight + reorgHorizon > height) {
+            m_watched[kept++] = index;
+        }
+    }
+    m_watched.resize(kept);
+
+    return changed;
+}
+
+bool BalanceLedger::processUnlocks(quint64 height) {
+    bool changed = false;
+
+    auto unlock = [this, &changed](Entry &entry) {
+        this->apply(entry, false);
+        entry.unlocked = true;
+        this->apply(entry, true);
+        changed |= !entry.spent && !entry.frozen;
+    };
+
+    while (!m_pendingUnlocks.empty() && m_pendingUnlocks.top().first <= height) {
+        Entry &entry = m_entries[m_pendingUnlocks.top().second];
+        m_pendingUnlocks.pop();
+        if (!entry.unlocked) {
+            unlock(entry);
+        }
+    }
+
+    // Unlock times given as a timestamp are rare, these are checked on every update
+    size_t kept = 0;
+    for (size_t index : m_timeLocked) {
+        if (m_wallet2->is_transfer_unlocked(m_wallet2->get_transfer_details(index))) {
+            unlock(m_entries[index]);
+        } else {
+            m_timeLocked[kept++] = index;
+        }
+    }
+    m_timeLocked.resize(kept);
+
+    return changed;
+}
+
+bool BalanceLedger::updatePendingChange() {
+    std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> payments;
+    m_wallet2->get_unconfirmed_payments_out(payments);
+
+    QHash<quint32, quint64> pendingChange;
+    quint64 total = 0;
+    for (const auto &payment : payments) {
+        const auto &details = payment.second;
+        if (details.m_state == tools::wallet2::unconfirmed_transfer_details::failed) {
+            continue;
+        }
+        pendingChange[details.m_subaddr_account] += details.m_change;
+        total += details.m_change;
+    }
+
+    if (pendingChange == m_pendingChange) {
+        return false;
+    }
+
+    m_pendingChange = pendingChange;
+    m_pendingChangeTotal = total;
+    return true;
+}
+
+void BalanceLedger::apply(const Entry &entry, bool add) {
+    if (entry.spent || entry.frozen) {
+        return;
+    }
+
+    const quint64 unlocked = entry.unlocked ? entry.amount : 0;
+    auto adjust = [&entry, unlocked, add](Totals &totals) {
+        if (add) {
+            totals.balance += entry.amount;
+            totals.unlocked += unlocked;
+        } else {
+            totals.balance -= entry.amount;
+            totals.unlocked -= unlocked;
+        }
+    };
+
+    adjust(m_accounts[entry.account]);
+    adjust(m_subaddresses[{entry.account, entry.subaddress}]);
+    adjust(m_total);
+}
+
+quint64 BalanceLedger::balance(quint32 accountIndex) const {
+    return m_accounts.value(accountIndex).balance + m_pendingChange.value(accountIndex);
+}
+
+quint64 BalanceLedger::unlockedBalance(quint32 accountIndex) const {
+    return m_accounts.value(accountIndex).unlocked;
+}
+
+quint64 BalanceLedger::balance(quint32 accountIndex, quint32 addressIndex) const {
+    // Change always goes to the first subaddress of the account
+    quint64 change = (addressIndex == 0) ? m_pendingChange.value(accountIndex) : 0;
+    return m_subaddresses.value({accountIndex, addressIndex}).balance + change;
+}
+
+quint64 BalanceLedger::unlockedBalance(quint32 accountIndex, quint32 addressIndex) const {
+    return m_subaddresses.value({accountIndex, addressIndex}).unlocked;
+}
+
+quint64 BalanceLedger::balanceAll() const {
+    return m_total.balance + m_pendingChangeTotal;
+}
+
+quint64 BalanceLedger::unlockedBalanceAll() const {
+    return m_total.unlocked;
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_BALANCELEDGER_H
+#define FEATHER_BALANCELEDGER_H
+
+#include <QHash>
+#include <QPair>
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace tools {
+    class wallet2;
+}
+
+// Per-account and per-subaddress balances, kept up to date incrementally.
+//
+// wallet2 computes a balance by walking every transfer the wallet ever received and checking whether it is unlocked.
+// The ledger instead remembers what each transfer contributes and on update() only looks at:
+//   - transfers received since the last update,
+//   - transfers that can still change: unspent ones, and spent ones that a reorg or a failed transaction could still
+//     return to the wallet,
+//   - transfers whose unlock height was reached, taken from a min-heap.
+// Balances match wallet2's non-strict balance() and unlocked_balance(): frozen outputs are excluded and the change of
+// pending outgoing transactions counts towards the balance of subaddress 0.
+//
+// Not thread-safe, call from the GUI thread.
+class BalanceLedger
+{
+public:
+    explicit BalanceLedger(tools::wallet2 *wallet2);
+
+    //! applies everything that happened since the last call, returns true if any balance changed
+    bool update();
+
+    //! rebuilds from scratch on the next update, for changes that bypass the regular refresh (imports, rescans)
+    void invalidate();
+
+    quint64 balance(quint32 accountIndex) const;
+    quint64 unlockedBalance(quint32 accountIndex) const;
+    quint64 balance(quint32 accountIndex, quint32 addressIndex) const;
+    quint64 unlockedBalance(quint32 accountIndex, quint32 addressIndex) const;
+    quint64 balanceAll() const;
+    quint64 unlockedBalanceAll() const;
+
+    //! spent outputs stay watched until their spend is this many blocks deep
+    static constexpr quint64 reorgHorizon = 100;
+
+private:
+    struct Entry {
+        quint32 account = 0;
+        quint32 subaddress = 0;
+        quint64 amount = 0;
+        quint64 globalIndex = 0;
+        quint64 unlockHeight = 0;  // 0 if the unlock time is a timestamp
+        quint64 spentHeight = 0;
+        bool spent = false;
+        bool frozen = false;
+        bool unlocked = false;
+    };
+
+    struct Totals {
+        quint64 balance = 0;
+        quint64 unlocked = 0;
+    };
+
+    void rebuild();
+    void addEntry(size_t index, quint64 height);
+    bool watchEntries(quint64 height);
+    bool processUnlocks(quint64 height);
+    bool updatePendingChange();
+
+    void apply(const Entry &entry, bool add);
+
+    tools::wallet2 *m_wallet2;
+
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_watched;
+    std::vector<size_t> m_timeLocked;
+
+    using PendingUnlock = std::pair<quint64, size_t>;
+    std::priority_queue<PendingUnlock, std::vector<PendingUnlock>, std::greater<>> m_pendingUnlocks;
+
+    QHash<quint32, Totals> m_accounts;
+    QHash<QPair<quint32, quint32>, Totals> m_subaddresses;
+    Totals m_total;
+
+    // Change of pending outgoing transactions, per account
+    QHash<quint32, quint64> m_pendingChange;
+    quint64 m_pendingChangeTotal = 0;
+
+    quint64 m_height = 0;
+    bool m_invalidated = true;
+};
+
+#endif //FEATHER_BALANCELEDGER_H
@@ -4,30 +4,97 @@
 #include "Coins.h"
 #include "rows/CoinsInfo.h"
 #include "Wallet.h"
+#include "utils/LazyRefresh.h"
+#include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
 #include <wallet/wallet2.h>
 
+#include <cstring>
+
 Coins::Coins(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent)
         : QObject(parent)
         , m_wallet(wallet)
         , m_wallet2(wallet2)
 {
-
+    m_lazyRefresh = new LazyRefresh([this]{ this->refresh(); }, this);
 }
 
 void Coins::refresh()
 {
-    qDebug() << Q_FUNC_INFO;
+    qCDebug(lcWallet) << Q_FUNC_INFO;
+    TRACE_SCOPE("Coins::refresh");
+    METRICS_SCOPE("Coins::refresh");
 
+    m_lazyRefresh->markFresh();
     emit refreshStarted();
 
+    {
+        QWriteLocker locker(&m_lock);
+
+        // Only accounts whose coins changed are built again, once they are shown
+        const QHash<quint32, quint64> signatures = this->accountSignatures();
+        for (auto it = m_accountRows.begin(); it != m_accountRows.end();) {
+            it = (signatures.value(it.key()) != m_accountSignatures.value(it.key())) ? m_accountRows.erase(it) : std::next(it);
+        }
+        m_accountSignatures = signatures;
+
+        m_rows = this->buildRows(m_wallet->currentSubaddressAccount());
+    }
+
+    emit refreshFinished();
+}
+
+QHash<quint32, quint64> Coins::accountSignatures() const
+{
+    // Changes whenever a coin of the account is received, spent, frozen, thawed or unlocked
+    auto mix = [](quint64 &signature, quint64 value) {
+        signature ^= value + 0x9e3779b97f4a7c15ULL + (signature << 6) + (signature >> 2);
+    };
+
     boost::shared_lock<boost::shared_mutex> transfers_lock(m_wallet2->m_transfers_mutex);
 
-    m_rows.clear();
+    QHash<quint32, quint64> signatures;
     for (size_t i = 0; i < m_wallet2->get_num_transfer_details(); ++i)
     {
         const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(i);
+        quint64 txid;
+        std::memcpy(&txid, td.m_txid.data, sizeof(txid));
+
+        quint64 &signature = signatures[td.m_subaddr_index.major];
+        mix(signature, txid);
+        mix(signature, td.m_internal_output_index);
+        mix(signature, td.m_spent_height);
+        mix(signature, (td.m_spent ? 1 : 0) | (td.m_frozen ? 2 : 0) | (td.m_key_image_known ? 4 : 0)
+                       | (m_wallet2->is_transfer_unlocked(td) ? 8 : 0));
+    }
+    return signatures;
+}
+
+void Coins::invalidate(quint32 accountIndex)
+{
+    {
+        QWriteLocker locker(&m_lock);
+        m_accountRows.remove(accountIndex);
+    }
+    this->requestRefresh();
+}
+
+QList<CoinsInfo> Coins::buildRows(quint32 accountIndex)
+{
+    auto cached = m_accountRows.constFind(accountIndex);
+    if (cached != m_accountRows.cend()) {
+        return cached.value();
+    }
 
-        if (td.m_subaddr_index.major != m_wallet->currentSubaddressAccount()) {
+    boost::shared_lock<boost::shared_mutex> transfers_lock(m_wallet2->m_transfers_mutex);
+    QReadLocker subaddressLocker(m_wallet->subaddressLock());
+
+    QList<CoinsInfo> rows;
+    for (size_t i = 0; i < m_wallet2->get_num_transfer_details(); ++i)
+    {
+        const tools::wallet2::transfer_details &td = m_wallet2->get_transfer_details(i);
+        if (td.m_subaddr_index.major != accountIndex) {
             continue;
         }
 
@@ -56,14 +123,42 @@ void Coins::refresh()
         ci.description = m_wallet->getCacheAttribute(QString("coin.description:%1").arg(ci.pubKey));
         ci.change = m_wallet2->is_change(td);
 
-        m_rows.push_back(ci);
+        rows.push_back(ci);
     }
 
+    m_accountRows.insert(accountIndex, rows);
+    return rows;
+}
+
+void Coins::requestRefresh()
+{
+    m_lazyRefresh->request();
+}
+
+void Coins::refreshIfStale()
+{
+    m_lazyRefresh->flush();
+}
+
+void Coins::attachView(QWidget *view)
+{
+    m_lazyRefresh->attachView(view);
+}
+
+void Coins::selectAccount(quint32 accountIndex)
+{
+    emit refreshStarted();
+    {
+        QWriteLocker locker(&m_lock);
+        m_rows = this->buildRows(accountIndex);
+    }
     emit refreshFinished();
 }
 
 quint64 Coins::count() const
 {
+    QReadLocker locker(&m_lock);
+
     return m_rows.length();
 }
 
@@ -83,6 +178,10 @@ const QList<CoinsInfo>& Coins::getRows()
 void Coins::setDescription(const QString &publicKey, quint32 accountIndex, const QString &description)
 {
     m_wallet->setCacheAttribute(QString("coin.description:%1").arg(publicKey), description);
+    {
+        QWriteLocker locker(&m_lock);
+        m_accountRows.remove(accountIndex);
+    }
     this->refresh();
     emit descriptionChanged();
 }
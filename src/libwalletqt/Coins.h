@@ -5,6 +5,7 @@
 #define FEATHER_COINS_H
 
 #include <QObject>
+#include <QHash>
 #include <QList>
 #include <QReadWriteLock>
 
@@ -17,6 +18,8 @@ namespace tools {
 }
 
 class CoinsInfo;
+class LazyRefresh;
+class QWidget;
 class Wallet;
 class Coins : public QObject
 {
@@ -26,6 +29,17 @@ public:
     void refresh();
     quint64 count() const;
 
+    //! refreshes now if a view of the coins is visible, otherwise once one is shown
+    void requestRefresh();
+    //! runs a deferred refresh, call before reading rows outside of a view
+    void refreshIfStale();
+    void attachView(QWidget *view);
+
+    //! shows the coins of another account, built once and kept until its coins change
+    void selectAccount(quint32 accountIndex);
+    //! drops the cached coins of an account, e.g. after one of its labels changed
+    void invalidate(quint32 accountIndex);
+
     const CoinsInfo& getRow(qsizetype i);
     const QList<CoinsInfo>& getRows();
 
@@ -43,9 +57,21 @@ private:
     explicit Coins(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent = nullptr);
     friend class Wallet;
 
+    //! coins of an account, cached until they change. Call with m_lock held.
+    QList<CoinsInfo> buildRows(quint32 accountIndex);
+    //! a value per account that changes with its coins, much cheaper than building the rows
+    QHash<quint32, quint64> accountSignatures() const;
+
+    mutable QReadWriteLock m_lock;
+
     Wallet *m_wallet;
     tools::wallet2 *m_wallet2;
     QList<CoinsInfo> m_rows;
+    LazyRefresh *m_lazyRefresh;
+
+    // Coins of the accounts shown so far, and the signatures they were checked against at the last refresh
+    QHash<quint32, QList<CoinsInfo>> m_accountRows;
+    QHash<quint32, quint64> m_accountSignatures;
 };
 
 #endif //FEATHER_COINS_H
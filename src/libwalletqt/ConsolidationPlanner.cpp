@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "ConsolidationPlanner.h"
+
+#include <QMap>
+#include <QPair>
+
+#include <algorithm>
+
+namespace ConsolidationPlanner
+{
+
+namespace {
+    // A sweep to a single destination gets a dummy second output
+    constexpr int sweepOutputs = 2;
+
+    // tx.extra: tx public key and a dummy encrypted payment id
+    constexpr quint64 extraSize = 33 + 11;
+
+    quint64 inputWeight() {
+        return estimateWeight(2, sweepOutputs) - estimateWeight(1, sweepOutputs);
+    }
+}
+
+quint64 estimateWeight(int inputs, int outputs) {
+    // Mirrors wallet2's estimate_rct_tx_size() / estimate_tx_weight()
+    outputs = std::max(outputs, 2);
+
+    int logPaddedOutputs = 0;
+    while ((1 << logPaddedOutputs) < outputs) {
+        ++logPaddedOutputs;
+    }
+
+    quint64 size = 1 + 6;                                      // version, unlock time
+    size += inputs * (1 + 6 + ringSize * 2 + 32);              // vin: key offsets and key image
+    size += outputs * (6 + 32);                                // vout
+    size += extraSize;
+    size += 1;                                                 // rct type
+    size += (2 * (6 + logPaddedOutputs) + 6) * 32 + 3;         // bulletproof+
+    size += inputs * (32 * ringSize + 64);                     // clsag
+    size += 32 * inputs;                                       // pseudo outs
+    size += 8 * outputs;                                       // ecdh info
+    size += 32 * outputs;                                      // out pk
+    size += 4;                                                 // fee
+    size += outputs;                                           // view tags
+
+    if (outputs > 2) {
+        // Clawback for the sublinear size of aggregated range proofs
+        const quint64 bpBase = (32 * (6 + 7 * 2)) / 2;
+        const quint64 paddedOutputs = 1ull << logPaddedOutputs;
+        const quint64 bpSize = 32 * (6 + 2 * (6 + logPaddedOutputs));
+        size += (bpBase * paddedOutputs - bpSize) * 4 / 5;
+    }
+
+    return size;
+}
+
+quint64 estimateFee(quint64 weight, quint64 feePerByte, quint64 quantizationMask) {
+    quint64 fee = weight * feePerByte;
+    if (quantizationMask > 1) {
+        fee = (fee + quantizationMask - 1) / quantizationMask * quantizationMask;
+    }
+    return fee;
+}
+
+int maxInputsPerTx() {
+    const quint64 fixed = estimateWeight(0, sweepOutputs);
+    return static_cast<int>((maxTxWeight - fixed) / inputWeight());
+}
+
+ConsolidationPlan plan(const QList<CoinsInfo> &coins, const Params &params) {
+    ConsolidationPlan result;
+    result.feePerByte = params.feePerByte;
+
+    const quint64 marginalFee = inputWeight() * params.feePerByte;
+    const int maxInputs = std::max(2, params.maxInputs > 0 ? std::min(params.maxInputs, maxInputsPerTx()) : maxInputsPerTx());
+
+    // Ordered, so plans are stable between runs
+    QMap<QPair<quint32, quint32>, QList<const CoinsInfo*>> groups;
+    for (const auto &coin : coins) {
+        if (coin.spent) {
+            continue;
+        }
+        if (params.maxOutputAmount > 0 && coin.amount > params.maxOutputAmount) {
+            continue;
+        }
+        if (coin.frozen) {
+            result.skippedFrozen += 1;
+            continue;
+        }
+        if (!coin.unlocked || !coin.keyImageKnown || coin.keyImage.isEmpty()) {
+            result.skippedLocked += 1;
+            continue;
+        }
+        if (coin.amount <= marginalFee) {
+            result.skippedUneconomical += 1;
+            continue;
+        }
+        groups[{coin.subaddrAccount, coin.subaddrIndex}].append(&coin);
+    }
+
+    QList<ConsolidationBatch> candidates;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+        const auto &group = it.value();
+        if (group.size() < 2) {
+            // Nothing to merge
+            continue;
+        }
+
+        // Spread the outputs evenly, a small trailing batch would carry the fixed cost for only a few inputs
+        const qsizetype batches = (group.size() + maxInputs - 1) / maxInputs;
+        const qsizetype base = group.size() / batches;
+        const qsizetype extra = group.size() % batches;
+
+        qsizetype offset = 0;
+        for (qsizetype b = 0; b < batches; b++) {
+            const qsizetype count = base + (b < extra ? 1 : 0);
+
+            ConsolidationBatch batch;
+            batch.accountIndex = it.key().first;
+            batch.subaddressIndex = it.key().second;
+            batch.keyImages.reserve(count);
+            for (qsizetype i = offset; i < offset + count; i++) {
+                batch.keyImages.append(group[i]->keyImage);
+                batch.amount += group[i]->amount;
+            }
+            offset += count;
+
+            batch.weight = estimateWeight(static_cast<int>(count), sweepOutputs);
+            batch.fee = estimateFee(batch.weight, params.feePerByte, params.quantizationMask);
+            if (batch.fee >= batch.amount) {
+                result.skippedUneconomical += static_cast<int>(count);
+                continue;
+            }
+            candidates.append(batch);
+        }
+    }
+
+    // Under a budget, prefer the batches that remove the most outputs per unit of fee
+    std::stable_sort(candidates.begin(), candidates.end(), [](const ConsolidationBatch &a, const ConsolidationBatch &b) {
+        return a.keyImages.size() * b.fee > b.keyImages.size() * a.fee;
+    });
+
+    for (const auto &batch : candidates) {
+        if (params.feeBudget > 0 && result.totalFee + batch.fee > params.feeBudget) {
+            result.skippedOverBudget += static_cast<int>(batch.keyImages.size());
+            continue;
+        }
+        result.batches.append(batch);
+        result.totalFee += batch.fee;
+        result.totalAmount += batch.amount;
+        result.inputs += static_cast<int>(batch.keyImages.size());
+    }
+
+    return result;
+}
+
+}
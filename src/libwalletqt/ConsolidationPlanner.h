@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_CONSOLIDATIONPLANNER_H
+#define FEATHER_CONSOLIDATIONPLANNER_H
+
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+#include "rows/CoinsInfo.h"
+
+// One sweep transaction: a set of outputs from a single subaddress, sent back to that same subaddress
+struct ConsolidationBatch
+{
+    quint32 accountIndex = 0;
+    quint32 subaddressIndex = 0;
+    QVector<QString> keyImages;
+    quint64 amount = 0;
+    quint64 weight = 0;  // estimated
+    quint64 fee = 0;     // estimated
+};
+
+struct ConsolidationPlan
+{
+    QList<ConsolidationBatch> batches;
+    quint64 feePerByte = 0;
+    quint64 totalAmount = 0;
+    quint64 totalFee = 0;
+    int inputs = 0;
+
+    int skippedFrozen = 0;
+    int skippedLocked = 0;
+    int skippedUneconomical = 0;  // worth less than the fee to spend them
+    int skippedOverBudget = 0;
+};
+
+Q_DECLARE_METATYPE(ConsolidationPlan)
+
+// Groups unlocked outputs into sweep transactions that each merge as many outputs as fit under the wallet's
+// transaction weight target, so the fixed cost of a transaction is shared by as many inputs as possible.
+//
+// Outputs of different subaddresses are never spent together, frozen and locked outputs are left alone, and
+// outputs that cost more to spend than they are worth are skipped. Weights follow wallet2's estimate for
+// CLSAG + Bulletproofs+ transactions with view tags at the current ring size.
+namespace ConsolidationPlanner
+{
+    constexpr int ringSize = 16;
+
+    //! wallet2 splits transactions above 2/3 of the maximum transaction weight
+    constexpr quint64 maxTxWeight = 99600;
+
+    //! fees are rounded up to a multiple of this (what nodes report as the fee quantization mask)
+    constexpr quint64 defaultQuantizationMask = 10000;
+
+    struct Params {
+        quint64 feePerByte = 0;
+        quint64 quantizationMask = defaultQuantizationMask;
+        quint64 feeBudget = 0;      // total for all batches, 0 for no limit
+        quint64 maxOutputAmount = 0;  // only consolidate outputs up to this amount, 0 for all
+        int maxInputs = 0;          // per transaction, 0 to derive it from maxTxWeight
+    };
+
+    quint64 estimateWeight(int inputs, int outputs);
+    quint64 estimateFee(quint64 weight, quint64 feePerByte, quint64 quantizationMask = defaultQuantizationMask);
+
+    //! how many inputs fit into a single sweep transaction
+    int maxInputsPerTx();
+
+    ConsolidationPlan plan(const QList<CoinsInfo> &coins, const Params &params);
+}
+
+#endif //FEATHER_CONSOLIDATIONPLANNER_H
@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "FeeHistory.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QLockFile>
+
+#include <cmath>
+
+#include "Wallet.h"
+#include "constants.h"
+#include "utils/config.h"
+#include "utils/Utils.h"
+
+namespace {
+    constexpr quint32 magic = 0x52484646;  // "FFHR"
+    constexpr int headerSize = 4 * 5;      // magic, record size, capacity, next slot, count
+
+    void writeRecordTo(QDataStream &stream, const FeeHistoryRecord &record) {
+        stream << record.time << record.height << record.seconds << record.blocks << record.fullRewardZone;
+        for (int i = 0; i < FeeHistoryRecord::tiers; i++) {
+            stream << record.baseFees[i] << record.queued[i] << record.cleared[i] << record.arrivedAbove[i];
+        }
+    }
+
+    void readRecordFrom(QDataStream &stream, FeeHistoryRecord &record) {
+        stream >> record.time >> record.height >> record.seconds >> record.blocks >> record.fullRewardZone;
+        for (int i = 0; i < FeeHistoryRecord::tiers; i++) {
+            stream >> record.baseFees[i] >> record.queued[i] >> record.cleared[i] >> record.arrivedAbove[i];
+        }
+    }
+}
+
+FeeHistory::FeeHistory(Wallet *wallet, QObject *parent)
+    : QObject(parent)
+    , m_wallet(wallet)
+{
+    this->load();
+
+    connect(m_wallet, &Wallet::poolStats, this, &FeeHistory::onPoolStats);
+
+    m_sampleTimer.setInterval(sampleInterval);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &FeeHistory::sample);
+    m_sampleTimer.start();
+}
+
+void FeeHistory::requestUpdate() {
+    if (m_wallet->connectionStatus() != Wallet::ConnectionStatus_Synchronized) {
+        return;
+    }
+    m_wallet->getTxPoolStatsAsync();
+}
+
+void FeeHistory::sample() {
+    if (!conf()->get(Config::recordFeeHistory).toBool()) {
+        return;
+    }
+    this->requestUpdate();
+}
+
+void FeeHistory::onPoolStats(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit) {
+    if (baseFees.size() != FeeHistoryRecord::tiers) {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    const quint64 height = m_wallet->daemonBlockChainHeight();
+    const bool newBlocks = m_havePool && m_current.height > 0 && height > m_current.height;
+
+    PoolDiff diff = diffPool(m_pool, txPool, now);
+
+    QVector<PoolTransaction> pool;
+    pool.reserve(m_pool.size() - diff.removed + diff.added.size());
+    for (int i = 0; i < m_pool.size(); i++) {
+        const PoolTransaction &tx = m_pool[i];
+        if (diff.kept[i]) {
+            pool.append(tx);
+            continue;
+        }
+        if (!newBlocks) {
+            // Dropped without a block, e.g. a double spend or an expired transaction
+            continue;
+        }
+        for (int t = 0; t < FeeHistoryRecord::tiers; t++) {
+            if (tx.feePerByte() >= baseFees[t]) {
+                m_pending.cleared[t] += tx.weight;
+            }
+        }
+    }
+    for (const auto &tx : diff.added) {
+        if (m_havePool) {
+            // Everything is new on the first poll
+            for (int t = 0; t < FeeHistoryRecord::tiers; t++) {
+                if (tx.feePerByte() > baseFees[t]) {
+                    m_pending.arrivedAbove[t] += tx.weight;
+                }
+            }
+        }
+        pool.append(tx);
+    }
+    m_pool = std::move(pool);
+
+    if (newBlocks) {
+        m_pending.blocks += static_cast<quint32>(height - m_current.height);
+    }
+
+    m_current = FeeHistoryRecord{};
+    m_current.time = now;
+    m_current.height = height;
+    m_current.fullRewardZone = blockWeightLimit >> 1;
+    for (int t = 0; t < FeeHistoryRecord::tiers; t++) {
+        m_current.baseFees[t] = baseFees[t];
+    }
+    for (const auto &tx : m_pool) {
+        for (int t = 0; t < FeeHistoryRecord::tiers; t++) {
+            if (tx.feePerByte() >= baseFees[t]) {
+                m_current.queued[t] += tx.weight;
+            }
+        }
+    }
+    m_havePool = true;
+
+    // The pool viewer polls more often, record at the sample interval only
+    if (!m_sinceRecord.isValid() || m_sinceRecord.elapsed() >= sampleInterval - 5000) {
+        if (conf()->get(Config::recordFeeHistory).toBool()) {
+            FeeHistoryRecord record = m_current;
+            if (m_sinceRecord.isValid() && m_sinceRecord.elapsed() <= 3 * sampleInterval) {
+                record.seconds = static_cast<quint32>(m_sinceRecord.elapsed() / 1000);
+                record.blocks = m_pending.blocks;
+                record.cleared = m_pending.cleared;
+                record.arrivedAbove = m_pending.arrivedAbove;
+            }
+            this->append(record);
+        }
+
+        m_pending = FeeHistoryRecord{};
+        m_sinceRecord.start();
+    }
+
+    emit estimatesChanged();
+}
+
+QVector<FeeEstimate> FeeHistory::estimates() const {
+    if (!m_havePool) {
+        return {};
+    }
+
+    constexpr int tiers = FeeHistoryRecord::tiers;
+
+    double seconds = 0;
+    quint64 blocks = 0;
+    std::array<double, tiers> arrived{};
+    std::array<quint64, tiers> saturatedCleared{};
+    std::array<quint64, tiers> saturatedBlocks{};
+
+    const FeeHistoryRecord *previous = nullptr;
+    for (const auto &record : m_records) {
+        if (record.time >= m_current.time - predictionWindow && record.seconds > 0 && previous) {
+            seconds += record.seconds;
+            blocks += record.blocks;
+            for (int t = 0; t < tiers; t++) {
+                arrived[t] += record.arrivedAbove[t];
+
+                // Transactions of the tier were left behind, so the blocks had no room for more
+                if (record.blocks > 0 && previous->queued[t] > record.cleared[t]) {
+                    saturatedCleared[t] += record.cleared[t];
+                    saturatedBlocks[t] += record.blocks;
+                }
+            }
+        }
+        previous = &record;
+    }
+
+    const bool fromHistory = seconds >= minimumHistory && blocks > 0;
+    const double blockTime = fromHistory ? seconds / blocks : targetBlockTime;
+
+    QVector<FeeEstimate> result;
+    for (int t = 0; t < tiers; t++) {
+        FeeEstimate estimate;
+        estimate.tier = t;
+        estimate.feePerByte = m_current.baseFees[t];
+        estimate.fromHistory = fromHistory;
+
+        double perBlock = static_cast<double>(m_current.fullRewardZone);
+        if (fromHistory && saturatedBlocks[t] > 0 && saturatedCleared[t] > 0) {
+            perBlock = static_cast<double>(saturatedCleared[t]) / saturatedBlocks[t];
+        }
+        const double competing = fromHistory ? arrived[t] / seconds * blockTime : 0;
+        const double drain = perBlock - competing;
+        const double queued = static_cast<double>(m_current.queued[t]);
+
+        if (queued < perBlock) {
+            estimate.seconds = std::llround(blockTime);
+        }
+        else if (drain > 0) {
+            estimate.seconds = std::llround(std::ceil(queued / drain) * blockTime);
+        }
+        result.append(estimate);
+    }
+
+    return result;
+}
+
+int FeeHistory::cheapestTier(qint64 deadline) const {
+    for (const auto &estimate : this->estimates()) {
+        if (estimate.seconds >= 0 && estimate.seconds <= deadline) {
+            return estimate.tier;
+        }
+    }
+    return -1;
+}
+
+QString FeeHistory::formatEstimate(qint64 seconds) {
+    if (seconds < 0) {
+        return "queue not draining";
+    }
+    if (seconds < 3600) {
+        return QString("≈ %1 min").arg(std::max<qint64>(1, (seconds + 59) / 60));
+    }
+    if (seconds < 24 * 3600) {
+        return QString("≈ %1 h").arg((seconds + 1799) / 3600);
+    }
+    return "> 1 day";
+}
+
+QString FeeHistory::filePath() const {
+    QString netType = Utils::QtEnumToString(constants::networkType).toLower();
+    return Config::defaultConfigDir().filePath(QString("fee_history_%1.bin").arg(netType));
+}
+
+void FeeHistory::load() {
+    QFile file{this->filePath()};
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream{&file};
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 fileMagic = 0, recordSize = 0, fileCapacity = 0, nextSlot = 0, count = 0;
+    stream >> fileMagic >> recordSize >> fileCapacity >> nextSlot >> count;
+    if (fileMagic != magic || recordSize != FeeHistoryRecord::size || fileCapacity != capacity || nextSlot >= capacity || count > capacity) {
+        qWarning() << "Ignoring incompatible fee history:" << file.fileName();
+        return;
+    }
+
+    // Oldest first, the ring starts at the next slot once it is full
+    const int first = (count == capacity) ? static_cast<int>(nextSlot) : 0;
+    m_records.reserve(count);
+    for (quint32 i = 0; i < count; i++) {
+        const int slot = static_cast<int>((first + i) % capacity);
+        if (!file.seek(headerSize + static_cast<qint64>(slot) * FeeHistoryRecord::size)) {
+            break;
+        }
+        FeeHistoryRecord record;
+        readRecordFrom(stream, record);
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+        m_records.append(record);
+    }
+}
+
+void FeeHistory::append(const FeeHistoryRecord &record) {
+    if (!this->writeRecord(record)) {
+        return;
+    }
+
+    m_records.append(record);
+    if (m_records.size() > capacity) {
+        m_records.removeFirst();
+    }
+}
+
+bool FeeHistory::writeRecord(const FeeHistoryRecord &record) {
+    // Every open wallet of the network type shares the file, the ring position is taken from it under the lock
+    QLockFile lock{this->filePath() + ".lock"};
+    if (!lock.tryLock(1000)) {
+        qWarning() << "Unable to lock fee history:" << lock.error();
+        return false;
+    }
+
+    QFile file{this->filePath()};
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "Unable to write fee history:" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 fileMagic = 0, recordSize = 0, fileCapacity = 0, nextSlot = 0, count = 0;
+    if (file.size() >= headerSize) {
+        stream >> fileMagic >> recordSize >> fileCapacity >> nextSlot >> count;
+    }
+    if (fileMagic != magic || recordSize != FeeHistoryRecord::size || fileCapacity != capacity || nextSlot >= capacity || count > capacity) {
+        // New or incompatible, start over
+        nextSlot = 0;
+        count = 0;
+    }
+
+    if (count > 0) {
+        // Another wallet may have sampled the same pool moments ago
+        FeeHistoryRecord last;
+        file.seek(headerSize + static_cast<qint64>((nextSlot + capacity - 1) % capacity) * FeeHistoryRecord::size);
+        readRecordFrom(stream, last);
+        if (stream.status() == QDataStream::Ok && record.time - last.time < sampleInterval / 2000) {
+            return false;
+        }
+        stream.resetStatus();
+    }
+
+    file.seek(headerSize + static_cast<qint64>(nextSlot) * FeeHistoryRecord::size);
+    writeRecordTo(stream, record);
+
+    file.seek(0);
+    stream << magic << quint32(FeeHistoryRecord::size) << quint32(capacity) << (nextSlot + 1) % capacity << std::min(count + 1, quint32(capacity));
+
+    return stream.status() == QDataStream::Ok;
+}
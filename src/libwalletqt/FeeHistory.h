@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_FEEHISTORY_H
+#define FEATHER_FEEHISTORY_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <array>
+
+#include "rows/TxBacklogEntry.h"
+#include "utils/TxPoolDiff.h"
+
+class Wallet;
+
+//! Pool state and block inclusion between two samples, stored as a fixed-size record
+struct FeeHistoryRecord
+{
+    static constexpr int tiers = 4;
+
+    qint64 time = 0;              // seconds since epoch
+    quint64 height = 0;
+    quint32 seconds = 0;          // since the previous record, 0 after a gap
+    quint32 blocks = 0;           // mined since the previous record
+    quint64 fullRewardZone = 0;
+    std::array<quint64, tiers> baseFees{};
+    std::array<quint64, tiers> queued{};        // pool weight paying at least the tier's fee per byte
+    std::array<quint64, tiers> cleared{};       // of which left the pool with a new block
+    std::array<quint64, tiers> arrivedAbove{};  // weight that arrived paying more than the tier, it goes ahead
+
+    static constexpr int size = 8 + 8 + 4 + 4 + 8 + 4 * tiers * 8;
+};
+
+struct FeeEstimate
+{
+    int tier = 0;
+    quint64 feePerByte = 0;
+    qint64 seconds = -1;  // expected time to the first confirmation, -1 if the queue doesn't drain
+    bool fromHistory = false;
+};
+
+// Records the transaction pool over time and predicts confirmation times per fee tier.
+//
+// The pool backlog is sampled every few minutes while the wallet is synchronized. Each sample keeps how much weight
+// was queued per tier, how much of it was mined since the previous sample and how much arrived with a higher fee.
+// Samples are written to a ring of fixed-size binary records in the config directory, one file per network type
+// shared by all open wallets, which take the ring position from the file under a lock file.
+//
+// The predictor takes the rates from the recent history: the weight per block that got mined while a tier's queue
+// didn't fully clear (so blocks were full for that tier), the block interval and the arrival rate of higher paying
+// transactions. The current queue divided by what remains of the block space gives the wait. Without enough history
+// it assumes full-reward-zone blocks every two minutes and no competition.
+class FeeHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FeeHistory(Wallet *wallet, QObject *parent = nullptr);
+
+    //! polls the pool now, estimates follow with estimatesChanged
+    void requestUpdate();
+
+    //! one estimate per fee tier, empty until the pool was seen once
+    QVector<FeeEstimate> estimates() const;
+    //! cheapest tier expected to confirm within deadline seconds, -1 if none is
+    int cheapestTier(qint64 deadline) const;
+    //! e.g. "≈ 6 min"
+    static QString formatEstimate(qint64 seconds);
+
+    const QVector<FeeHistoryRecord>& records() const { return m_records; }
+
+    static constexpr int sampleInterval = 2 * 60 * 1000;
+    static constexpr int capacity = 4096;             // ~5.7 days at the sample interval
+    static constexpr qint64 predictionWindow = 6 * 3600;
+    static constexpr qint64 minimumHistory = 30 * 60;
+    static constexpr qint64 targetBlockTime = 120;
+
+signals:
+    void estimatesChanged();
+
+private:
+    void sample();
+    void onPoolStats(const QVector<TxBacklogEntry> &txPool, const QVector<quint64> &baseFees, quint64 blockWeightLimit);
+    void append(const FeeHistoryRecord &record);
+
+    QString filePath() const;
+    void load();
+    bool writeRecord(const FeeHistoryRecord &record);
+
+    Wallet *m_wallet;
+    QTimer m_sampleTimer;
+
+    QVector<FeeHistoryRecord> m_records;  // oldest first
+
+    // Latest poll, which may not have been recorded yet
+    QVector<PoolTransaction> m_pool;
+    FeeHistoryRecord m_current;
+    bool m_havePool = false;
+
+    // Accumulated since the last record
+    FeeHistoryRecord m_pending;
+    QElapsedTimer m_sinceRecord;
+};
+
+#endif //FEATHER_FEEHISTORY_H
@@ -4,8 +4,19 @@
 #include "Subaddress.h"
 
 #include "Wallet.h"
+#include "utils/config.h"
+#include "utils/LazyRefresh.h"
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
 #include <wallet/wallet2.h>
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent/QtConcurrent>
+
+#include "utils/Utils.h"
+
 Subaddress::Subaddress(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent)
     : QObject(parent)
     , m_wallet(wallet)
@@ -17,20 +28,31 @@ Subaddress::Subaddress(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent)
     QString hidden = m_wallet->getCacheAttribute("feather.hiddenaddresses");
     m_hidden = hidden.split(",");
 
+    m_lazyUpdateUsed = new LazyRefresh([this]{ this->updateUsed(m_wallet->currentSubaddressAccount()); }, this);
+
     connect(this, &Subaddress::noUnusedSubaddresses, [this] {
-        this->addRow("");
+        // With a pool configured, poolLow tops it up in the background instead
+        if (conf()->get(Config::subaddressPoolSize).toInt() <= 0) {
+            this->addRow("");
+        }
     });
 }
 
 bool Subaddress::refresh()
 {
+    TRACE_SCOPE("Subaddress::refresh");
+    METRICS_SCOPE("Subaddress::refresh");
+    m_lazyUpdateUsed->markFresh();
     emit refreshStarted();
+    QReadLocker locker(m_wallet->subaddressLock());
 
     m_rows.clear();
+    m_accountRows.clear();
 
     bool potentialWalletFileCorruption = false;
 
     quint32 accountIndex = m_wallet->currentSubaddressAccount();
+    m_rowsAccount = accountIndex;
     for (quint32 i = 0; i < m_wallet2->get_num_subaddresses(accountIndex); ++i)
     {
         bool r = emplaceRow(i);
@@ -39,6 +61,7 @@ bool Subaddress::refresh()
             break;
         }
     }
+    locker.unlock();
 
     // Make sure keys are intact. We NEVER want to display incorrect addresses in case of memory corruption.
     potentialWalletFileCorruption = potentialWalletFileCorruption || (m_wallet2->get_device_type() == hw::device::SOFTWARE && !m_wallet2->verify_keys());
@@ -54,9 +77,58 @@ bool Subaddress::refresh()
     return !potentialWalletFileCorruption;
 }
 
+bool Subaddress::switchAccount(quint32 accountIndex)
+{
+    METRICS_SCOPE("Subaddress::switchAccount");
+
+    auto cached = m_accountRows.find(accountIndex);
+    if (cached == m_accountRows.end()) {
+        QList<SubaddressRow> rows = m_rows;
+        quint32 rowsAccount = m_rowsAccount;
+        bool r = this->refresh();
+        if (r && rowsAccount != accountIndex) {
+            m_accountRows.insert(rowsAccount, rows);
+        }
+        return r;
+    }
+
+    emit refreshStarted();
+    QReadLocker locker(m_wallet->subaddressLock());
+
+    m_accountRows.insert(m_rowsAccount, m_rows);
+    m_rows = m_accountRows.take(accountIndex);
+    m_rowsAccount = accountIndex;
+
+    // Subaddresses may have been used or added since the rows were cached, labels and keys can't change
+    for (quint32 i = 0; i < m_rows.count(); i++) {
+        m_rows[i].used = m_wallet2->get_subaddress_used({accountIndex, i});
+    }
+    bool potentialWalletFileCorruption = false;
+    for (quint32 i = m_rows.count(); i < m_wallet2->get_num_subaddresses(accountIndex); ++i) {
+        if (!emplaceRow(i)) {
+            potentialWalletFileCorruption = true;
+            break;
+        }
+    }
+    locker.unlock();
+
+    if (potentialWalletFileCorruption) {
+        LOG_ERROR("KEY INCONSISTENCY DETECTED, WALLET IS IN CORRUPT STATE.");
+        m_rows.clear();
+        m_accountRows.clear();
+        emit corrupted();
+    }
+
+    emit refreshFinished();
+
+    return !potentialWalletFileCorruption;
+}
+
 void Subaddress::updateUsed(quint32 accountIndex)
 {
-    bool haveUnused = false;
+    METRICS_SCOPE("Subaddress::updateUsed");
+    m_lazyUpdateUsed->markFresh();
+    quint32 unused = 0;
     for (quint32 i = 0; i < m_rows.count(); i++) {
         SubaddressRow& row = m_rows[i];
 
@@ -66,12 +138,28 @@ void Subaddress::updateUsed(quint32 accountIndex)
             emit rowUpdated(i);
         }
         if (!used && i > 0) {
-            haveUnused = true;
+            unused++;
         }
     }
-    if (!haveUnused) {
+    if (unused == 0) {
         emit noUnusedSubaddresses();
     }
+
+    // Refill to twice the low-water mark, so a busy shop doesn't generate a batch for every payment
+    auto poolSize = static_cast<quint32>(std::max(0, conf()->get(Config::subaddressPoolSize).toInt()));
+    if (unused < poolSize) {
+        emit poolLow(2 * poolSize - unused);
+    }
+}
+
+void Subaddress::requestUpdateUsed()
+{
+    m_lazyUpdateUsed->request();
+}
+
+void Subaddress::attachView(QWidget *view)
+{
+    m_lazyUpdateUsed->attachView(view);
 }
 
 qsizetype Subaddress::count() const
@@ -133,6 +221,12 @@ bool Subaddress::emplaceRow(quint32 addressIndex)
 
 bool Subaddress::addRow(const QString &label)
 {
+    // The batch would write its labels over the new row
+    if (m_wallet->isGeneratingSubaddresses()) {
+        m_errorString = "Subaddresses are being generated";
+        return false;
+    }
+
     // This can fail if hardware device is unplugged during operating, catch here to prevent crash
     // Todo: Notify GUI that it was a device error
     try
@@ -158,10 +252,14 @@ bool Subaddress::addRow(const QString &label)
 bool Subaddress::setLabel(quint32 addressIndex, const QString &label)
 {
     try {
-        m_wallet2->set_subaddress_label({m_wallet->currentSubaddressAccount(), addressIndex}, label.toStdString());
+        {
+            QWriteLocker locker(m_wallet->subaddressLock());
+            m_wallet2->set_subaddress_label({m_wallet->currentSubaddressAccount(), addressIndex}, label.toStdString());
+        }
         SubaddressRow& row = m_rows[addressIndex];
         row.label = label;
         emit rowUpdated(addressIndex);
+        emit labelChanged(m_wallet->currentSubaddressAccount());
     }
     catch (const std::exception& e)
     {
@@ -223,6 +321,130 @@ bool Subaddress::isPinned(const QString &address)
     return m_pinned.contains(address);
 }
 
+QString Subaddress::expandLabel(const QString &labelTemplate, quint32 accountIndex, quint32 addressIndex, quint32 n)
+{
+    if (!labelTemplate.contains('{')) {
+        return labelTemplate;
+    }
+
+    QString label = labelTemplate;
+    label.replace("{account}", QString::number(accountIndex));
+    label.replace("{index}", QString::number(addressIndex));
+    label.replace("{n}", QString::number(n));
+    return label;
+}
+
+bool Subaddress::generateRows(quint32 accountIndex, quint32 first, quint32 count, bool parallel, QList<SubaddressRow> &rows) const
+{
+    // Only const wallet2 calls are made here, the caller holds the subaddress lock for reading.
+    METRICS_SCOPE("Subaddress::generateRows");
+
+    constexpr quint32 chunkSize = 256;
+
+    QVector<QString> addresses(count);
+    QVector<QString> labels(count);
+    std::atomic<bool> mappingValid{true};
+
+    auto derive = [&](quint32 begin) {
+        quint32 end = std::min(count, begin + chunkSize);
+        for (quint32 i = begin; i < end && mappingValid; i++) {
+            cryptonote::subaddress_index index = {accountIndex, first + i};
+            cryptonote::account_public_address address = m_wallet2->get_subaddress(index);
+
+            // Same checks as emplaceRow, we NEVER want to display an address the wallet won't recognize
+            auto idx = m_wallet2->get_subaddress_index(address);
+            if (!idx || idx != index) {
+                mappingValid = false;
+                return;
+            }
+
+            addresses[i] = QString::fromStdString(cryptonote::get_account_address_as_str(m_wallet2->nettype(), !index.is_zero(), address));
+            labels[i] = QString::fromStdString(m_wallet2->get_subaddress_label(index));
+        }
+    };
+
+    QVector<quint32> chunks;
+    for (quint32 begin = 0; begin < count; begin += chunkSize) {
+        chunks.append(begin);
+    }
+
+    if (parallel) {
+        QtConcurrent::blockingMap(chunks, derive);
+    } else {
+        for (quint32 begin : chunks) {
+            derive(begin);
+        }
+    }
+
+    if (!mappingValid) {
+        return false;
+    }
+
+    rows.clear();
+    rows.reserve(count);
+    for (quint32 i = 0; i < count; i++) {
+        // Subaddresses past the previous end of the list can't have received funds, or it would have been expanded
+        rows.emplace_back(addresses[i], labels[i], false, false, false, first + i == 0 && accountIndex == 0);
+    }
+    return true;
+}
+
+void Subaddress::appendRows(quint32 accountIndex, quint32 first, const QList<SubaddressRow> &rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    if (accountIndex != m_rowsAccount) {
+        // The account was switched while the batch was generated, switchAccount picks up the new rows
+        m_accountRows.remove(accountIndex);
+        return;
+    }
+
+    if (first != m_rows.size()) {
+        // Rows were added in the meantime, rebuild instead of guessing
+        this->refresh();
+        return;
+    }
+
+    emit beginAddRows(first, first + rows.size() - 1);
+    m_rows.append(rows);
+    emit endAddRows();
+}
+
+bool Subaddress::exportRows(const QString &path, quint32 first, quint32 count)
+{
+    quint32 end = std::min(static_cast<quint32>(m_rows.size()), first + count);
+
+    QString data;
+    if (path.endsWith(".json", Qt::CaseInsensitive)) {
+        QJsonArray arr;
+        for (quint32 i = first; i < end; i++) {
+            QJsonObject obj;
+            obj["account"] = static_cast<qint64>(m_rowsAccount);
+            obj["index"] = static_cast<qint64>(i);
+            obj["address"] = m_rows[i].address;
+            obj["label"] = m_rows[i].label;
+            arr.append(obj);
+        }
+        data = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Indented));
+    }
+    else {
+        data = "accountIndex,addressIndex,address,label";
+        for (quint32 i = first; i < end; i++) {
+            QString label = m_rows[i].label;
+            label.replace("\"", "\"\"");
+            data += QString("\n%1,%2,%3,\"%4\"").arg(QString::number(m_rowsAccount), QString::number(i), m_rows[i].address, label);
+        }
+    }
+
+    if (!Utils::fileWrite(path, data)) {
+        m_errorString = QString("Unable to write to %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
 QString Subaddress::getError() const {
     return m_errorString;
 }
@@ -4,6 +4,7 @@
 #ifndef SUBADDRESS_H
 #define SUBADDRESS_H
 
+#include <QHash>
 #include <QObject>
 #include <QString>
 
@@ -13,6 +14,8 @@ namespace tools {
     class wallet2;
 }
 
+class LazyRefresh;
+class QWidget;
 class Wallet;
 class Subaddress : public QObject
 {
@@ -20,7 +23,12 @@ class Subaddress : public QObject
 
 public:
     bool refresh();
+    //! shows the rows of another account, reusing them if the account was shown before
+    bool switchAccount(quint32 accountIndex);
     void updateUsed(quint32 accountIndex);
+    //! updates used flags now if a view of the subaddresses is visible, otherwise once one is shown
+    void requestUpdateUsed();
+    void attachView(QWidget *view);
     [[nodiscard]] qsizetype count() const;
 
     const SubaddressRow& row(int index) const;
@@ -28,6 +36,15 @@ public:
     const QList<SubaddressRow>& getRows();
 
     bool addRow(const QString &label);
+
+    //! label for the n-th subaddress of a batch, {account}, {index} and {n} are replaced
+    static QString expandLabel(const QString &labelTemplate, quint32 accountIndex, quint32 addressIndex, quint32 n);
+    //! derives rows for already generated subaddresses, on multiple threads if parallel is set
+    bool generateRows(quint32 accountIndex, quint32 first, quint32 count, bool parallel, QList<SubaddressRow> &rows) const;
+    //! appends a batch of generated rows to the current account in one model insert
+    void appendRows(quint32 accountIndex, quint32 first, const QList<SubaddressRow> &rows);
+    //! writes rows [first, first + count) of the current account as CSV, or JSON if path ends in .json
+    bool exportRows(const QString &path, quint32 first, quint32 count);
     bool setLabel(quint32 addressIndex, const QString &label);
     bool setHidden(const QString& address, bool hidden);
     bool setPinned(const QString& address, bool pinned);
@@ -40,10 +57,15 @@ signals:
     void refreshStarted() const;
     void refreshFinished() const;
     void rowUpdated(qsizetype index) const;
+    void labelChanged(quint32 accountIndex) const;
     void corrupted() const;
     void noUnusedSubaddresses() const;
     void beginAddRow(qsizetype index) const;
     void endAddRow() const;
+    void beginAddRows(qsizetype first, qsizetype last) const;
+    void endAddRows() const;
+    //! fewer unused subaddresses than Config::subaddressPoolSize are left in the current account
+    void poolLow(quint32 missing) const;
 
 private:
     bool emplaceRow(quint32 addressIndex);
@@ -54,7 +76,12 @@ private:
     Wallet* m_wallet;
     tools::wallet2 *m_wallet2;
     QList<SubaddressRow> m_rows;
-    
+    quint32 m_rowsAccount = 0;
+    LazyRefresh *m_lazyUpdateUsed;
+
+    // Rows of previously shown accounts, dropped whenever the current account is rebuilt from scratch
+    QHash<quint32, QList<SubaddressRow>> m_accountRows;
+
     QStringList m_pinned;
     QStringList m_hidden;
 
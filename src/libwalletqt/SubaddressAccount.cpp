@@ -2,11 +2,14 @@
 // SPDX-FileCopyrightText: The Monero Project
 
 #include "SubaddressAccount.h"
+#include "BalanceLedger.h"
 #include <wallet/wallet2.h>
 
-SubaddressAccount::SubaddressAccount(tools::wallet2 *wallet2, QObject *parent)
+SubaddressAccount::SubaddressAccount(tools::wallet2 *wallet2, const BalanceLedger *balanceLedger, QReadWriteLock *subaddressLock, QObject *parent)
     : QObject(parent)
     , m_wallet2(wallet2)
+    , m_balanceLedger(balanceLedger)
+    , m_subaddressLock(subaddressLock)
 {
 }
 
@@ -16,14 +19,16 @@ void SubaddressAccount::refresh()
 
     m_rows.clear();
 
+    QReadLocker locker(m_subaddressLock);
     for (uint32_t i = 0; i < m_wallet2->get_num_subaddress_accounts(); ++i)
     {
         m_rows.emplace_back(
             QString::fromStdString(m_wallet2->get_subaddress_as_str({i,0})),
             QString::fromStdString(m_wallet2->get_subaddress_label({i,0})),
-            m_wallet2->balance(i, false),
-            m_wallet2->unlocked_balance(i, false));
+            m_balanceLedger->balance(i),
+            m_balanceLedger->unlockedBalance(i));
     }
+    locker.unlock();
 
     emit refreshFinished();
 }
@@ -48,12 +53,18 @@ const QList<AccountRow>& SubaddressAccount::getRows()
 
 void SubaddressAccount::addRow(const QString &label)
 {
-    m_wallet2->add_subaddress_account(label.toStdString());
+    {
+        QWriteLocker locker(m_subaddressLock);
+        m_wallet2->add_subaddress_account(label.toStdString());
+    }
     refresh();
 }
 
 void SubaddressAccount::setLabel(quint32 accountIndex, const QString &label)
 {
-    m_wallet2->set_subaddress_label({accountIndex, 0}, label.toStdString());
+    {
+        QWriteLocker locker(m_subaddressLock);
+        m_wallet2->set_subaddress_label({accountIndex, 0}, label.toStdString());
+    }
     refresh();
 }
@@ -6,6 +6,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QReadWriteLock>
 
 #include "rows/AccountRow.h"
 
@@ -13,6 +14,8 @@ namespace tools {
     class wallet2;
 }
 
+class BalanceLedger;
+
 class SubaddressAccount : public QObject
 {
     Q_OBJECT
@@ -32,10 +35,12 @@ signals:
     void refreshFinished() const;
 
 private:
-    explicit SubaddressAccount(tools::wallet2 *wallet2, QObject *parent);
+    explicit SubaddressAccount(tools::wallet2 *wallet2, const BalanceLedger *balanceLedger, QReadWriteLock *subaddressLock, QObject *parent);
     friend class Wallet;
 
     tools::wallet2 *m_wallet2;
+    const BalanceLedger *m_balanceLedger;
+    QReadWriteLock *m_subaddressLock;
     QList<AccountRow> m_rows;
 };
 
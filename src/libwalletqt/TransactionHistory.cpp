@@ -2,9 +2,17 @@
 // SPDX-FileCopyrightText: The Monero Project
 
 #include "TransactionHistory.h"
+
+#include <cstring>
+
 #include "utils/Utils.h"
 #include "utils/AppData.h"
 #include "utils/config.h"
+#include "utils/CsvReader.h"
+#include "utils/LazyRefresh.h"
+#include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
 #include "constants.h"
 #include "Wallet.h"
 #include "WalletManager.h"
@@ -17,7 +25,7 @@ TransactionHistory::TransactionHistory(Wallet *wallet, tools::wallet2 *wallet2,
     , m_wallet2(wallet2)
     , m_locked(false)
 {
-
+    m_lazyRefresh = new LazyRefresh([this]{ this->refresh(); }, this);
 }
 
 QString description(tools::wallet2 *wallet2, const tools::wallet2::payment_details &pd)
@@ -37,226 +45,368 @@ QString description(tools::wallet2 *wallet2, const tools::wallet2::payment_detai
     return description;
 }
 
+namespace {
+    void mix(quint64 &signature, quint64 value) {
+        signature ^= value + 0x9e3779b97f4a7c15ULL + (signature << 6) + (signature >> 2);
+    }
+
+    void mix(quint64 &signature, const crypto::hash &hash) {
+        quint64 prefix;
+        std::memcpy(&prefix, hash.data, sizeof(prefix));
+        mix(signature, prefix);
+    }
+}
+
 void TransactionHistory::refresh()
 {
-    qDebug() << Q_FUNC_INFO;
+    qCDebug(lcHistory) << Q_FUNC_INFO;
+    TRACE_SCOPE("TransactionHistory::refresh");
+    METRICS_SCOPE("TransactionHistory::refresh");
 
+    m_lazyRefresh->markFresh();
     emit refreshStarted();
 
     {
         QWriteLocker locker(&m_lock);
 
-        m_rows.clear();
-
-        quint64 lastTxHeight = 0;
-        bool hasFakePaymentId = m_wallet->isTrezor();
         m_locked = false;
 
-        uint64_t min_height = 0;
-        uint64_t max_height = (uint64_t)-1;
-        uint64_t wallet_height = m_wallet->blockChainHeight();
-        uint32_t account = m_wallet->currentSubaddressAccount();
+        // A new block usually touches no account at all, only the rows of accounts whose transactions changed
+        // are built again, once they are shown
+        const QHash<quint32, quint64> signatures = this->accountSignatures();
+        for (auto it = m_accountRows.begin(); it != m_accountRows.end();) {
+            bool changed = (it.key() == allAccounts) ? signatures != m_accountSignatures
+                                                     : signatures.value(it.key()) != m_accountSignatures.value(it.key());
+            it = changed ? m_accountRows.erase(it) : std::next(it);
+        }
+        m_accountSignatures = signatures;
 
-        // transactions are stored in wallet2:
-        // - confirmed_transfer_details   - out transfers
-        // - unconfirmed_transfer_details - pending out transfers
-        // - payment_details              - input transfers
+        m_rows = this->buildRows(m_wallet->currentSubaddressAccount());
+    }
 
-        // payments are "input transactions";
-        // one input transaction contains only one transfer. e.g. <transaction_id> - <100XMR>
+    emit refreshFinished();
+}
 
-        std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
-        m_wallet2->get_payments(in_payments, min_height, max_height);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::payment_details>>::const_iterator i = in_payments.begin(); i != in_payments.end(); ++i)
+QList<TransactionRow> TransactionHistory::buildRows(quint32 account)
+{
+    // Only the rows shown are built, a transaction of another account costs no more than the check of its account
+    const quint32 key = m_showAllAccounts ? allAccounts : account;
+    auto cached = m_accountRows.find(key);
+    if (cached != m_accountRows.end()) {
+        // Confirmations are the only thing a new block changes in rows that are still valid
+        const quint64 walletHeight = m_wallet->blockChainHeight();
+        for (auto &row : cached.value()) {
+            row.confirmations = (!row.pending && walletHeight > row.blockHeight) ? walletHeight - row.blockHeight : 0;
+        }
+        return cached.value();
+    }
+
+    // Rows carry subaddress labels
+    QReadLocker subaddressLocker(m_wallet->subaddressLock());
+
+    QList<TransactionRow> rows;
+    auto skip = [this, account](uint32_t major) {
+        return !m_showAllAccounts && major != account;
+    };
+
+    bool hasFakePaymentId = m_wallet->isTrezor();
+
+    uint64_t min_height = 0;
+    uint64_t max_height = (uint64_t)-1;
+    uint64_t wallet_height = m_wallet->blockChainHeight();
+
+    // transactions are stored in wallet2:
+    // - confirmed_transfer_details   - out transfers
+    // - unconfirmed_transfer_details - pending out transfers
+    // - payment_details              - input transfers
+
+    // payments are "input transactions";
+    // one input transaction contains only one transfer. e.g. <transaction_id> - <100XMR>
+
+    std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
+    m_wallet2->get_payments(in_payments, min_height, max_height);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::payment_details>>::const_iterator i = in_payments.begin(); i != in_payments.end(); ++i)
+    {
+        const tools::wallet2::payment_details &pd = i->second;
+        if (skip(pd.m_subaddr_index.major)) {
+            continue;
+        }
+
+        std::string payment_id = epee::string_tools::pod_to_hex(i->first);
+        if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
+            payment_id = payment_id.substr(0,16);
+
+        TransactionRow t;
+        t.paymentId = QString::fromStdString(payment_id);
+        t.coinbase = pd.m_coinbase;
+        t.amount = pd.m_amount;
+        t.balanceDelta = pd.m_amount;
+        t.fee = pd.m_fee;
+        t.direction = TransactionRow::Direction_In;
+        t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
+        t.blockHeight = pd.m_block_height;
+        t.subaddrIndex = { pd.m_subaddr_index.minor };
+        t.subaddrAccount = pd.m_subaddr_index.major;
+        t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
+        t.unlockTime = pd.m_unlock_time;
+        t.description = description(m_wallet2, pd);
+
+        rows.append(std::move(t));
+    }
+
+    // confirmed output transactions
+    // one output transaction may contain more than one money transfer, e.g.
+    // <transaction_id>:
+    //    transfer1: 100XMR to <address_1>
+    //    transfer2: 50XMR  to <address_2>
+    //    fee: fee charged per transaction
+    //
+
+    std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+    m_wallet2->get_payments_out(out_payments, min_height, max_height);
+
+    for (std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>>::const_iterator i = out_payments.begin();
+         i != out_payments.end(); ++i) {
+
+        const crypto::hash &hash = i->first;
+        const tools::wallet2::confirmed_transfer_details &pd = i->second;
+        if (skip(pd.m_subaddr_account)) {
+            continue;
+        }
+
+        uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change; // change may not be known
+        uint64_t fee = pd.m_amount_in - pd.m_amount_out;
+
+        std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
+        if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
+            payment_id = payment_id.substr(0,16);
+
+        TransactionRow t;
+        t.paymentId = QString::fromStdString(payment_id);
+
+        t.amount = pd.m_amount_out - change;
+        t.balanceDelta = change - pd.m_amount_in;
+        t.fee = fee;
+
+        t.direction = TransactionRow::Direction_Out;
+        t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
+        t.blockHeight = pd.m_block_height;
+        t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
+        t.subaddrAccount = pd.m_subaddr_account;
+        t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
+
+        for (uint32_t idx : t.subaddrIndex)
+        {
+            t.subaddrIndex.insert(idx);
+        }
+
+        // single output transaction might contain multiple transfers
+        for (auto const &d: pd.m_dests)
+        {
+            t.transfers.emplace_back(
+                d.amount,
+                QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
+        }
+        for (auto const &r: pd.m_rings)
         {
-            const tools::wallet2::payment_details &pd = i->second;
-            if (pd.m_subaddr_index.major != account) {
-                continue;
-            }
-
-            std::string payment_id = epee::string_tools::pod_to_hex(i->first);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-            t.coinbase = pd.m_coinbase;
-            t.amount = pd.m_amount;
-            t.balanceDelta = pd.m_amount;
-            t.fee = pd.m_fee;
-            t.direction = TransactionRow::Direction_In;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
-            t.blockHeight = pd.m_block_height;
-            t.subaddrIndex = { pd.m_subaddr_index.minor };
-            t.subaddrAccount = pd.m_subaddr_index.major;
-            t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
-            t.unlockTime = pd.m_unlock_time;
-            t.description = description(m_wallet2, pd);
-
-            m_rows.append(std::move(t));
+            t.rings.emplace_back(
+                QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
+                cryptonote::relative_output_offsets_to_absolute(r.second));
         }
 
-        // confirmed output transactions
-        // one output transaction may contain more than one money transfer, e.g.
-        // <transaction_id>:
-        //    transfer1: 100XMR to <address_1>
-        //    transfer2: 50XMR  to <address_2>
-        //    fee: fee charged per transaction
-        //
+        rows.append(std::move(t));
+    }
 
-        std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
-        m_wallet2->get_payments_out(out_payments, min_height, max_height);
-
-        for (std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>>::const_iterator i = out_payments.begin();
-             i != out_payments.end(); ++i) {
-
-            const crypto::hash &hash = i->first;
-            const tools::wallet2::confirmed_transfer_details &pd = i->second;
-            if (pd.m_subaddr_account != account) {
-                continue;
-            }
-
-            uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change; // change may not be known
-            uint64_t fee = pd.m_amount_in - pd.m_amount_out;
-
-            std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-
-            t.amount = pd.m_amount_out - change;
-            t.balanceDelta = change - pd.m_amount_in;
-            t.fee = fee;
-
-            t.direction = TransactionRow::Direction_Out;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
-            t.blockHeight = pd.m_block_height;
-            t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
-            t.subaddrAccount = pd.m_subaddr_account;
-            t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = (wallet_height > pd.m_block_height) ? wallet_height - pd.m_block_height : 0;
-
-            for (uint32_t idx : t.subaddrIndex)
-            {
-                t.subaddrIndex.insert(idx);
-            }
-
-            // single output transaction might contain multiple transfers
-            for (auto const &d: pd.m_dests)
-            {
-                t.transfers.emplace_back(
-                    d.amount,
-                    QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
-            }
-            for (auto const &r: pd.m_rings)
-            {
-                t.rings.emplace_back(
-                    QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
-                    cryptonote::relative_output_offsets_to_absolute(r.second));
-            }
-
-            m_rows.append(std::move(t));
+    // unconfirmed output transactions
+    std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+    m_wallet2->get_unconfirmed_payments_out(upayments_out);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>>::const_iterator i = upayments_out.begin(); i != upayments_out.end(); ++i) {
+        const tools::wallet2::unconfirmed_transfer_details &pd = i->second;
+        if (skip(pd.m_subaddr_account)) {
+            continue;
         }
 
-        // unconfirmed output transactions
-        std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
-        m_wallet2->get_unconfirmed_payments_out(upayments_out);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>>::const_iterator i = upayments_out.begin(); i != upayments_out.end(); ++i) {
-            const tools::wallet2::unconfirmed_transfer_details &pd = i->second;
-            if (pd.m_subaddr_account != account) {
-                continue;
-            }
-
-            const crypto::hash &hash = i->first;
-            uint64_t amount = pd.m_amount_in;
-            uint64_t fee = amount - pd.m_amount_out;
-            uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change;
-            std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-            bool is_failed = pd.m_state == tools::wallet2::unconfirmed_transfer_details::failed;
-
-            TransactionRow t;
-            t.paymentId = QString::fromStdString(payment_id);
-
-            t.amount = pd.m_amount_out - change;
-            t.balanceDelta = change - pd.m_amount_in;
-            t.fee = fee;
-
-            t.direction = TransactionRow::Direction_Out;
-            t.failed = is_failed;
-            t.pending = true;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
-            t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
-            t.subaddrAccount = pd.m_subaddr_account;
-            t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = 0;
-            for (uint32_t idx : t.subaddrIndex)
-            {
-                t.subaddrIndex.insert(idx);
-            }
-
-            for (auto const &d: pd.m_dests)
-            {
-                t.transfers.emplace_back(
-                    d.amount,
-                    QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
-            }
-            for (auto const &r: pd.m_rings)
-            {
-                t.rings.emplace_back(
-                    QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
-                    cryptonote::relative_output_offsets_to_absolute(r.second));
-            }
-
-            m_rows.append(std::move(t));
+        const crypto::hash &hash = i->first;
+        uint64_t amount = pd.m_amount_in;
+        uint64_t fee = amount - pd.m_amount_out;
+        uint64_t change = pd.m_change == (uint64_t)-1 ? 0 : pd.m_change;
+        std::string payment_id = epee::string_tools::pod_to_hex(i->second.m_payment_id);
+        if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
+            payment_id = payment_id.substr(0,16);
+        bool is_failed = pd.m_state == tools::wallet2::unconfirmed_transfer_details::failed;
+
+        TransactionRow t;
+        t.paymentId = QString::fromStdString(payment_id);
+
+        t.amount = pd.m_amount_out - change;
+        t.balanceDelta = change - pd.m_amount_in;
+        t.fee = fee;
+
+        t.direction = TransactionRow::Direction_Out;
+        t.failed = is_failed;
+        t.pending = true;
+        t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(hash));
+        t.description = QString::fromStdString(m_wallet2->get_tx_note(hash));
+        t.subaddrAccount = pd.m_subaddr_account;
+        t.label = QString::fromStdString(pd.m_subaddr_indices.size() == 1 ? m_wallet2->get_subaddress_label({pd.m_subaddr_account, *pd.m_subaddr_indices.begin()}) : "");
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = 0;
+        for (uint32_t idx : t.subaddrIndex)
+        {
+            t.subaddrIndex.insert(idx);
         }
 
+        for (auto const &d: pd.m_dests)
+        {
+            t.transfers.emplace_back(
+                d.amount,
+                QString::fromStdString(d.address(m_wallet2->nettype(), pd.m_payment_id, !hasFakePaymentId)));
+        }
+        for (auto const &r: pd.m_rings)
+        {
+            t.rings.emplace_back(
+                QString::fromStdString(epee::string_tools::pod_to_hex(r.first)),
+                cryptonote::relative_output_offsets_to_absolute(r.second));
+        }
 
-        // unconfirmed payments (tx pool)
-        std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
-        m_wallet2->get_unconfirmed_payments(upayments);
-        for (std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>>::const_iterator i = upayments.begin(); i != upayments.end(); ++i) {
-            const tools::wallet2::payment_details &pd = i->second.m_pd;
-            if (pd.m_subaddr_index.major != account) {
-                continue;
-            }
-
-            std::string payment_id = epee::string_tools::pod_to_hex(i->first);
-            if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
-                payment_id = payment_id.substr(0,16);
-
-            TransactionRow t;
-
-            t.paymentId = QString::fromStdString(payment_id);
-            t.amount = pd.m_amount;
-            t.balanceDelta = pd.m_amount;
-            t.direction = TransactionRow::Direction_In;
-            t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
-            t.blockHeight = pd.m_block_height;
-            t.pending = true;
-            t.subaddrIndex = { pd.m_subaddr_index.minor };
-            t.subaddrAccount = pd.m_subaddr_index.major;
-            t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
-            t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
-            t.confirmations = 0;
-            t.description = description(m_wallet2, pd);
-
-            m_rows.append(std::move(t));
-
-            LOG_PRINT_L1(__FUNCTION__ << ": Unconfirmed payment found " << pd.m_amount);
+        rows.append(std::move(t));
+    }
+
+
+    // unconfirmed payments (tx pool)
+    std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
+    m_wallet2->get_unconfirmed_payments(upayments);
+    for (std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>>::const_iterator i = upayments.begin(); i != upayments.end(); ++i) {
+        const tools::wallet2::payment_details &pd = i->second.m_pd;
+        if (skip(pd.m_subaddr_index.major)) {
+            continue;
         }
+
+        std::string payment_id = epee::string_tools::pod_to_hex(i->first);
+        if (payment_id.substr(16).find_first_not_of('0') == std::string::npos)
+            payment_id = payment_id.substr(0,16);
+
+        TransactionRow t;
+
+        t.paymentId = QString::fromStdString(payment_id);
+        t.amount = pd.m_amount;
+        t.balanceDelta = pd.m_amount;
+        t.direction = TransactionRow::Direction_In;
+        t.hash = QString::fromStdString(epee::string_tools::pod_to_hex(pd.m_tx_hash));
+        t.blockHeight = pd.m_block_height;
+        t.pending = true;
+        t.subaddrIndex = { pd.m_subaddr_index.minor };
+        t.subaddrAccount = pd.m_subaddr_index.major;
+        t.label = QString::fromStdString(m_wallet2->get_subaddress_label(pd.m_subaddr_index));
+        t.timestamp = QDateTime::fromSecsSinceEpoch(pd.m_timestamp);
+        t.confirmations = 0;
+        t.description = description(m_wallet2, pd);
+
+        rows.append(std::move(t));
+
+        LOG_PRINT_L1(__FUNCTION__ << ": Unconfirmed payment found " << pd.m_amount);
+    }
+
+    m_accountRows.insert(key, rows);
+    return rows;
+}
+
+QHash<quint32, quint64> TransactionHistory::accountSignatures() const
+{
+    // Changes whenever a transaction of the account is added, removed, confirmed or fails
+    QHash<quint32, quint64> signatures;
+    const uint64_t min_height = 0;
+    const uint64_t max_height = (uint64_t)-1;
+
+    std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
+    m_wallet2->get_payments(in_payments, min_height, max_height);
+    for (const auto &payment : in_payments) {
+        quint64 &signature = signatures[payment.second.m_subaddr_index.major];
+        mix(signature, payment.second.m_tx_hash);
+        mix(signature, payment.second.m_block_height);
+        mix(signature, payment.second.m_amount);
+    }
+
+    std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+    m_wallet2->get_payments_out(out_payments, min_height, max_height);
+    for (const auto &payment : out_payments) {
+        quint64 &signature = signatures[payment.second.m_subaddr_account];
+        mix(signature, payment.first);
+        mix(signature, payment.second.m_block_height);
+    }
+
+    std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+    m_wallet2->get_unconfirmed_payments_out(upayments_out);
+    for (const auto &payment : upayments_out) {
+        quint64 &signature = signatures[payment.second.m_subaddr_account];
+        mix(signature, payment.first);
+        mix(signature, static_cast<quint64>(payment.second.m_state) + 1);
+    }
+
+    std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
+    m_wallet2->get_unconfirmed_payments(upayments);
+    for (const auto &payment : upayments) {
+        quint64 &signature = signatures[payment.second.m_pd.m_subaddr_index.major];
+        mix(signature, payment.second.m_pd.m_tx_hash);
+        mix(signature, payment.second.m_pd.m_amount);
+    }
+
+    return signatures;
+}
+
+void TransactionHistory::invalidate(quint32 accountIndex)
+{
+    {
+        QWriteLocker locker(&m_lock);
+        m_accountRows.remove(accountIndex);
+        m_accountRows.remove(allAccounts);
     }
+    this->requestRefresh();
+}
+
+void TransactionHistory::requestRefresh()
+{
+    m_lazyRefresh->request();
+}
+
+void TransactionHistory::refreshIfStale()
+{
+    m_lazyRefresh->flush();
+}
 
+void TransactionHistory::attachView(QWidget *view)
+{
+    m_lazyRefresh->attachView(view);
+}
+
+void TransactionHistory::selectAccount(quint32 accountIndex)
+{
+    emit refreshStarted();
+    {
+        QWriteLocker locker(&m_lock);
+        m_rows = this->buildRows(accountIndex);
+    }
     emit refreshFinished();
 }
 
+void TransactionHistory::setShowAllAccounts(bool show)
+{
+    if (m_showAllAccounts == show) {
+        return;
+    }
+    m_showAllAccounts = show;
+    this->selectAccount(m_wallet->currentSubaddressAccount());
+}
+
+bool TransactionHistory::showAllAccounts() const
+{
+    return m_showAllAccounts;
+}
+
 quint64 TransactionHistory::count() const
 {
     QReadLocker locker(&m_lock);
@@ -288,6 +438,10 @@ void TransactionHistory::setTxNote(const QString &txid, const QString &note)
     const crypto::hash htxid = *reinterpret_cast<const crypto::hash*>(txid_data.data());
 
     m_wallet2->set_tx_note(htxid, note.toStdString());
+    {
+        QWriteLocker locker(&m_lock);
+        m_accountRows.clear();
+    }
     emit txNoteChanged();
 }
 
@@ -296,100 +450,158 @@ bool TransactionHistory::locked() const
     return m_locked;
 }
 
-QStringList parseCSVLine(const QString &line) {
-    QStringList result;
-    QString currentField;
-    bool inQuotes = false;
-
-    for (int i = 0; i < line.length(); ++i) {
-        QChar currentChar = line[i];
-
-        if (currentChar == '"') {
-            if (inQuotes && i + 1 < line.length() && line[i + 1] == '"') {
-                currentField.append('"');
-                ++i;
-            } else {
-                inQuotes = !inQuotes;
-            }
-        } else if (currentChar == ',' && !inQuotes) {
-            result.append(currentField.trimmed());
-            currentField.clear();
-        } else {
-            currentField.append(currentChar);
+namespace {
+    using TxidIndex = std::unordered_set<crypto::hash>;
+
+    // Every transaction of the wallet, confirmed or not, of all accounts
+    TxidIndex buildTxidIndex(tools::wallet2 *wallet2) {
+        TxidIndex index;
+        const uint64_t min_height = 0;
+        const uint64_t max_height = (uint64_t)-1;
+
+        std::list<std::pair<crypto::hash, tools::wallet2::payment_details>> in_payments;
+        wallet2->get_payments(in_payments, min_height, max_height);
+        for (const auto &payment : in_payments) {
+            index.insert(payment.second.m_tx_hash);
+        }
+
+        std::list<std::pair<crypto::hash, tools::wallet2::confirmed_transfer_details>> out_payments;
+        wallet2->get_payments_out(out_payments, min_height, max_height);
+        for (const auto &payment : out_payments) {
+            index.insert(payment.first);
+        }
+
+        std::list<std::pair<crypto::hash, tools::wallet2::unconfirmed_transfer_details>> upayments_out;
+        wallet2->get_unconfirmed_payments_out(upayments_out);
+        for (const auto &payment : upayments_out) {
+            index.insert(payment.first);
+        }
+
+        std::list<std::pair<crypto::hash, tools::wallet2::pool_payment_details>> upayments;
+        wallet2->get_unconfirmed_payments(upayments);
+        for (const auto &payment : upayments) {
+            index.insert(payment.second.m_pd.m_tx_hash);
+        }
+
+        return index;
+    }
+
+    void reject(qsizetype &count, QStringList &sample, const QString &txid) {
+        if (count++ < TxNotesResult::maxSamples) {
+            sample.append(txid);
+        }
+    }
+
+    // Counts txids that aren't valid or not in the index in result
+    bool matchTxid(const TxidIndex &index, const QString &txid, crypto::hash &hash, TxNotesResult &result) {
+        if (!epee::string_tools::hex_to_pod(txid.toStdString(), hash)) {
+            reject(result.invalid, result.invalidSample, txid);
+            return false;
+        }
+        if (index.find(hash) == index.end()) {
+            reject(result.unmatched, result.unmatchedSample, txid);
+            return false;
+        }
+        return true;
+    }
+}
+
+TxNotesResult TransactionHistory::setTxNotes(const QList<QPair<QString, QString>> &notes)
+{
+    TxNotesResult result;
+    const TxidIndex index = buildTxidIndex(m_wallet2);
+
+    for (const auto &note : notes) {
+        crypto::hash hash;
+        if (!matchTxid(index, note.first, hash, result)) {
+            continue;
         }
+        m_wallet2->set_tx_note(hash, note.second.toStdString());
+        result.updated++;
     }
 
-    result.append(currentField.trimmed());
+    this->onTxNotesChanged(result.updated);
     return result;
 }
 
-QString TransactionHistory::importLabelsFromCSV(const QString &fileName) {
-    QFile file(fileName);
+void TransactionHistory::onTxNotesChanged(qsizetype updated)
+{
+    if (updated == 0) {
+        return;
+    }
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return QString("Could not open file: %1").arg(fileName);
+    qCDebug(lcHistory) << "Set" << updated << "transaction notes";
+    {
+        // Notes are shown as descriptions, in any account
+        QWriteLocker locker(&m_lock);
+        m_accountRows.clear();
     }
+    emit txNoteChanged();
+    this->requestRefresh();
+}
 
-    QTextStream in(&file);
+QString TransactionHistory::importLabelsFromCSV(const QString &fileName, TxNotesResult &result) {
+    TRACE_SCOPE("TransactionHistory::importLabelsFromCSV");
+    result = TxNotesResult();
 
-    QList<QStringList> fields;
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        fields.append(parseCSVLine(line));
-    }
+    QFile file(fileName);
 
-    if (fields.empty()) {
-        return "CSV file appears to be empty";
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString("Could not open file: %1").arg(fileName);
     }
 
-    qint64 txidField = -1;
-    qint64 descriptionField = -1;
+    CsvReader reader(&file);
 
-    QStringList header = fields[0];
-    for (int i = 0; i < header.length(); i++) {
-        if (header[i] == "txid") {
-            txidField = i;
-            continue;
-        }
-        if (header[i] == "description") {
-            descriptionField = i;
-        }
+    QStringList header;
+    if (!reader.readRecord(header)) {
+        return reader.hasError() ? reader.errorString() : "CSV file appears to be empty";
     }
 
+    const qsizetype txidField = header.indexOf("txid");
+    const qsizetype descriptionField = header.indexOf("description");
+
     if (txidField < 0) {
         return "'txid' field not found in CSV header";
     }
     if (descriptionField < 0) {
         return "'description' field not found in CSV header";
     }
-    qint64 maxIndex = std::max(txidField, descriptionField);
+    const qsizetype maxIndex = std::max(txidField, descriptionField);
 
-    QList<QPair<QString, QString>> descriptions;
+    // Rows for unknown transactions are dropped here, so only as many notes as the wallet has transactions are held
+    const TxidIndex index = buildTxidIndex(m_wallet2);
+    std::unordered_map<crypto::hash, std::string> notes;
 
-    for (int i = 1; i < fields.length(); i++) {
-        const auto& row = fields[i];
+    QStringList row;
+    while (reader.readRecord(row)) {
         if (maxIndex >= row.length()) {
-            qDebug() << "Row with invalid length in CSV";
+            qCDebug(lcHistory) << "Row with invalid length in CSV on line" << reader.lineNumber();
             continue;
         }
 
-        if (row[txidField].isEmpty()) {
+        const QString &txid = row[txidField];
+        const QString &description = row[descriptionField];
+        if (txid.isEmpty() || description.isEmpty()) {
             continue;
         }
 
-        if (row[descriptionField].isEmpty()) {
+        crypto::hash hash;
+        if (!matchTxid(index, txid, hash, result)) {
             continue;
         }
-
-        descriptions.push_back({row[txidField], row[descriptionField]});
+        notes[hash] = description.toStdString();
     }
 
-    for (const auto& description : descriptions) {
-        qDebug() << "Setting note for tx:" << description.first << "description:" << description.second;
-        this->setTxNote(description.first, description.second);
+    if (reader.hasError()) {
+        result = TxNotesResult();
+        return reader.errorString();
     }
 
-    this->refresh();
+    for (const auto &note : notes) {
+        m_wallet2->set_tx_note(note.first, note.second);
+    }
+    result.updated = static_cast<qsizetype>(notes.size());
 
+    this->onTxNotesChanged(result.updated);
     return {};
 }
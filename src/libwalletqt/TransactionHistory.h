@@ -4,7 +4,11 @@
 #ifndef FEATHER_TRANSACTIONHISTORY_H
 #define FEATHER_TRANSACTIONHISTORY_H
 
+#include <QHash>
 #include <QReadWriteLock>
+#include <QStringList>
+
+#include <limits>
 
 #include "rows/TransactionRow.h"
 
@@ -16,8 +20,22 @@ namespace Monero {
 struct TransactionHistory;
 }
 
+class LazyRefresh;
+class QWidget;
 class TransactionInfo;
 class Wallet;
+
+struct TxNotesResult
+{
+    static constexpr qsizetype maxSamples = 10;
+
+    qsizetype updated = 0;
+    qsizetype invalid = 0;          // not a transaction id
+    qsizetype unmatched = 0;        // no transaction of this wallet
+    QStringList invalidSample;      // the first maxSamples of them
+    QStringList unmatchedSample;
+};
+
 class TransactionHistory : public QObject
 {
     Q_OBJECT
@@ -26,13 +44,30 @@ public:
     void refresh();
     quint64 count() const;
 
+    //! refreshes now if a view of the history is visible, otherwise once one is shown
+    void requestRefresh();
+    //! runs a deferred refresh, call before reading rows outside of a view
+    void refreshIfStale();
+    void attachView(QWidget *view);
+
+    //! shows the rows of another account, built once and kept until its transactions change
+    void selectAccount(quint32 accountIndex);
+    //! drops the cached rows of an account, e.g. after one of its labels changed
+    void invalidate(quint32 accountIndex);
+    //! shows transactions of all accounts instead of only the current one
+    void setShowAllAccounts(bool show);
+    bool showAllAccounts() const;
+
     const TransactionRow& transaction(int index);
     const QList<TransactionRow>& getRows();
 
     void setTxNote(const QString &txid, const QString &note);
+    //! sets the notes of the wallet's transactions among {txid, note} pairs, emits txNoteChanged once
+    TxNotesResult setTxNotes(const QList<QPair<QString, QString>> &notes);
     bool locked() const;
 
-    QString importLabelsFromCSV(const QString &fileName);
+    //! sets notes from the 'txid' and 'description' columns, returns an error message. Nothing is set on error.
+    QString importLabelsFromCSV(const QString &fileName, TxNotesResult &result);
 
 signals:
     void refreshStarted() const;
@@ -44,6 +79,12 @@ signals:
 private:
     explicit TransactionHistory(Wallet *wallet, tools::wallet2 *wallet2, QObject *parent = nullptr);
 
+    void onTxNotesChanged(qsizetype updated);
+    //! rows of account, or of all accounts if they are shown, cached until they change. Call with m_lock held.
+    QList<TransactionRow> buildRows(quint32 account);
+    //! a value per account that changes with its transactions, much cheaper than building the rows
+    QHash<quint32, quint64> accountSignatures() const;
+
 private:
     friend class Wallet;
     mutable QReadWriteLock m_lock;
@@ -51,14 +92,20 @@ private:
     Wallet *m_wallet;
     tools::wallet2 *m_wallet2;
     QList<TransactionRow> m_rows;
+    LazyRefresh *m_lazyRefresh;
+
+    // Rows of the accounts shown so far, and the signatures they were checked against at the last refresh.
+    // m_rows shares data with one of these.
+    QHash<quint32, QList<TransactionRow>> m_accountRows;
+    QHash<quint32, quint64> m_accountSignatures;
+    static constexpr quint32 allAccounts = std::numeric_limits<quint32>::max();
+    bool m_showAllAccounts = false;
 
     mutable QDateTime   m_firstDateTime;
     mutable QDateTime   m_lastDateTime;
     mutable int m_minutesToUnlock;
     // history contains locked transfers
     mutable bool m_locked;
-
-    quint32 lastAccountIndex = 0;
 };
 
 #endif // FEATHER_TRANSACTIONHISTORY_H
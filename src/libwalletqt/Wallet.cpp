@@ -3,11 +3,15 @@
 
 #include "Wallet.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 #include "AddressBook.h"
+#include "AddressResolver.h"
+#include "BalanceLedger.h"
 #include "Coins.h"
+#include "FeeHistory.h"
 #include "Subaddress.h"
 #include "SubaddressAccount.h"
 #include "TransactionHistory.h"
@@ -24,18 +28,23 @@
 #include "model/SubaddressAccountModel.h"
 #include "model/CoinsModel.h"
 
+#include "utils/RestoreHeightLookup.h"
 #include "utils/ScopeGuard.h"
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
 
 #include "wallet/wallet2.h"
 
 namespace {
     constexpr char ATTRIBUTE_SUBADDRESS_ACCOUNT[] = "feather.subaddress_account";
+    constexpr char ATTRIBUTE_RESTORE_DATE[] = "feather.restore_date";
 }
 
 Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
         : QObject(parent)
         , m_walletImpl(wallet)
         , m_wallet2(wallet->getWallet())
+        , m_balanceLedger(new BalanceLedger(wallet->getWallet()))
         , m_history(new TransactionHistory(this, wallet->getWallet(), this))
         , m_historyModel(nullptr)
         , m_addressBook(new AddressBook(wallet->getWallet(), this))
@@ -45,7 +54,7 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
         , m_connectionStatus(Wallet::ConnectionStatus_Disconnected)
         , m_currentSubaddressAccount(0)
         , m_subaddress(new Subaddress(this, wallet->getWallet(), this))
-        , m_subaddressAccount(new SubaddressAccount(wallet->getWallet(), this))
+        , m_subaddressAccount(new SubaddressAccount(wallet->getWallet(), m_balanceLedger.data(), &m_subaddressLock, this))
         , m_refreshNow(false)
         , m_refreshEnabled(false)
         , m_scheduler(this)
@@ -56,11 +65,15 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
     m_walletListener = new WalletListenerImpl(this);
     m_walletImpl->setListener(m_walletListener);
     m_currentSubaddressAccount = getCacheAttribute(ATTRIBUTE_SUBADDRESS_ACCOUNT).toUInt();
+    m_restoreDate = getCacheAttribute(ATTRIBUTE_RESTORE_DATE).toLongLong();
+    m_restoreHeightMargin = conf()->get(Config::restoreHeightMargin).toInt();
 
     m_addressBookModel = new AddressBookModel(this, m_addressBook);
     m_subaddressModel = new SubaddressModel(this, m_subaddress);
     m_subaddressAccountModel = new SubaddressAccountModel(this, m_subaddressAccount);
     m_coinsModel = new CoinsModel(this, m_coins);
+    m_feeHistory = new FeeHistory(this, this);
+    m_addressResolver = new AddressResolver(wallet->getWallet(), &m_subaddressLock, m_addressBook, m_subaddress, this);
 
     if (this->status() == Status_Ok) {
         startRefreshThread();
@@ -83,6 +96,14 @@ Wallet::Wallet(Monero::Wallet *wallet, QObject *parent)
     connect(m_subaddress, &Subaddress::corrupted, [this]{
        emit keysCorrupted();
     });
+    connect(m_subaddress, &Subaddress::labelChanged, this, [this](quint32 accountIndex){
+        // History and coins show subaddress labels
+        m_history->invalidate(accountIndex);
+        m_coins->invalidate(accountIndex);
+    });
+    connect(m_subaddress, &Subaddress::poolLow, this, [this](quint32 missing){
+        this->addSubaddresses(missing, "");
+    });
 }
 
 // #################### Status ####################
@@ -140,14 +161,11 @@ quint64 Wallet::balance() const {
 }
 
 quint64 Wallet::balance(quint32 accountIndex) const {
-    return m_wallet2->balance(accountIndex, false);
+    return m_balanceLedger->balance(accountIndex);
 }
 
 quint64 Wallet::balanceAll() const {
-    uint64_t result = 0;
-    for (uint32_t i = 0; i < numSubaddressAccounts(); ++i)
-        result += balance(i);
-    return result;
+    return m_balanceLedger->balanceAll();
 }
 
 quint64 Wallet::unlockedBalance() const {
@@ -155,14 +173,11 @@ quint64 Wallet::unlockedBalance() const {
 }
 
 quint64 Wallet::unlockedBalance(quint32 accountIndex) const {
-    return m_wallet2->unlocked_balance(accountIndex, false);
+    return m_balanceLedger->unlockedBalance(accountIndex);
 }
 
 quint64 Wallet::unlockedBalanceAll() const {
-    uint64_t result = 0;
-    for (uint32_t i = 0; i < numSubaddressAccounts(); ++i)
-        result += unlockedBalance(i);
-    return result;
+    return m_balanceLedger->unlockedBalanceAll();
 }
 
 quint64 Wallet::viewOnlyBalance(quint32 accountIndex) const {
@@ -174,20 +189,27 @@ quint64 Wallet::viewOnlyBalance(quint32 accountIndex) const {
 }
 
 void Wallet::updateBalance() {
-    quint64 balance = this->balance();
-    quint64 spendable = this->unlockedBalance();
+    m_balanceLedger->update();
 
-    emit balanceUpdated(balance, spendable);
+    emit balanceUpdated(this->balance(), this->unlockedBalance());
+}
+
+void Wallet::syncBalance() {
+    if (m_balanceLedger->update()) {
+        emit balanceUpdated(this->balance(), this->unlockedBalance());
+    }
 }
 
 // #################### Subaddresses and Accounts ####################
 
 QString Wallet::address(quint32 accountIndex, quint32 addressIndex) const {
+    QReadLocker locker(&m_subaddressLock);
     return QString::fromStdString(m_wallet2->get_subaddress_as_str({accountIndex, addressIndex}));
 }
 
 QString Wallet::getAddressSafe(quint32 accountIndex, quint32 addressIndex, bool &ok, QString &reason) const {
     ok = false;
+    QReadLocker locker(&m_subaddressLock);
 
     // If we copy an address to clipboard or create a QR code, there must not be a spark of doubt that
     // the address belongs to our wallet.
@@ -276,6 +298,7 @@ QString Wallet::getAddressSafe(quint32 accountIndex, quint32 addressIndex, bool
 }
 
 SubaddressIndex Wallet::subaddressIndex(const QString &address) const {
+    QReadLocker locker(&m_subaddressLock);
     std::pair<uint32_t, uint32_t> i;
     if (!m_walletImpl->subaddressIndex(address.toStdString(), i)) {
         return SubaddressIndex(-1, -1);
@@ -283,6 +306,10 @@ SubaddressIndex Wallet::subaddressIndex(const QString &address) const {
     return SubaddressIndex(i.first, i.second);
 }
 
+AddressResolver* Wallet::addressResolver() const {
+    return m_addressResolver;
+}
+
 quint32 Wallet::currentSubaddressAccount() const {
     return m_currentSubaddressAccount;
 }
@@ -295,9 +322,10 @@ void Wallet::switchSubaddressAccount(quint32 accountIndex) {
         {
             qWarning() << "failed to set " << ATTRIBUTE_SUBADDRESS_ACCOUNT << " cache attribute";
         }
-        m_subaddress->refresh();
-        m_history->refresh();
-        m_coins->refresh();
+        // Rows of all accounts are built on every wallet refresh, switching only swaps them in
+        m_subaddress->switchAccount(m_currentSubaddressAccount);
+        m_history->selectAccount(m_currentSubaddressAccount);
+        m_coins->selectAccount(m_currentSubaddressAccount);
         this->coinsModel()->setCurrentSubaddressAccount(m_currentSubaddressAccount);
         this->updateBalance();
         this->setSelectedInputs({});
@@ -305,19 +333,101 @@ void Wallet::switchSubaddressAccount(quint32 accountIndex) {
     }
 }
 void Wallet::addSubaddressAccount(const QString& label) {
-    m_wallet2->add_subaddress_account(label.toStdString());
+    {
+        QWriteLocker locker(&m_subaddressLock);
+        m_wallet2->add_subaddress_account(label.toStdString());
+    }
     switchSubaddressAccount(numSubaddressAccounts() - 1);
 }
 
+bool Wallet::addSubaddresses(quint32 count, const QString &labelTemplate) {
+    if (count == 0 || m_generatingSubaddresses.exchange(true)) {
+        return false;
+    }
+
+    qInfo() << "Generating" << count << "subaddresses";
+    const quint32 accountIndex = m_currentSubaddressAccount;
+    const quint32 first = this->numSubaddresses(accountIndex);
+
+    m_scheduler.run([this, accountIndex, first, count, labelTemplate] {
+        METRICS_SCOPE("Wallet::addSubaddresses");
+
+        // Hardware devices derive each spend key in a round trip, short chunks let the refresh thread and views in
+        const bool parallel = m_wallet2->get_device_type() == hw::device::SOFTWARE;
+        const quint32 chunkSize = parallel ? subaddressChunkSize : deviceSubaddressChunkSize;
+
+        QList<SubaddressRow> rows;
+        rows.reserve(count);
+        QString error;
+        quint32 done = 0;
+        while (done < count && error.isEmpty()) {
+            const quint32 chunkFirst = first + done;
+            const quint32 chunkCount = std::min(chunkSize, count - done);
+
+            // The refresh thread looks up received outputs in the subaddress tables, views read them on the GUI thread
+            QMutexLocker asyncLocker(&m_asyncMutex);
+            QList<SubaddressRow> chunk;
+            try {
+                {
+                    QWriteLocker locker(&m_subaddressLock);
+                    // One expansion derives all spend keys of the chunk in a single device call, instead of one add_subaddress per row
+                    m_wallet2->expand_subaddresses({accountIndex, chunkFirst + chunkCount - 1});
+                    for (quint32 i = 0; i < chunkCount; i++) {
+                        QString label = Subaddress::expandLabel(labelTemplate, accountIndex, chunkFirst + i, done + i);
+                        if (!label.isEmpty()) {
+                            m_wallet2->set_subaddress_label({accountIndex, chunkFirst + i}, label.toStdString());
+                        }
+                    }
+                }
+
+                QReadLocker locker(&m_subaddressLock);
+                if (!m_subaddress->generateRows(accountIndex, chunkFirst, chunkCount, parallel, chunk)) {
+                    error = "Subaddress mapping is inconsistent";
+                }
+            }
+            catch (const std::exception &e) {
+                error = QString::fromStdString(e.what());
+            }
+
+            if (error.isEmpty()) {
+                rows.append(chunk);
+                done += chunkCount;
+            }
+        }
+
+        if (!error.isEmpty()) {
+            qWarning() << "Failed to generate subaddresses:" << error;
+        }
+
+        // One model insert for the whole batch
+        QMetaObject::invokeMethod(this, [this, accountIndex, first, done, rows, error] {
+            m_subaddress->appendRows(accountIndex, first, rows);
+            m_generatingSubaddresses = false;
+            emit subaddressesGenerated(accountIndex, first, done, error);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+bool Wallet::isGeneratingSubaddresses() const {
+    return m_generatingSubaddresses;
+}
+
+QReadWriteLock* Wallet::subaddressLock() const {
+    return &m_subaddressLock;
+}
+
 quint32 Wallet::numSubaddressAccounts() const {
     return m_wallet2->get_num_subaddress_accounts();
 }
 
 quint32 Wallet::numSubaddresses(quint32 accountIndex) const {
+    QReadLocker locker(&m_subaddressLock);
     return m_wallet2->get_num_subaddresses(accountIndex);
 }
 
 QString Wallet::getSubaddressLabel(quint32 accountIndex, quint32 addressIndex) const {
+    QReadLocker locker(&m_subaddressLock);
     return QString::fromStdString(m_walletImpl->getSubaddressLabel(accountIndex, addressIndex));
 }
 
@@ -483,6 +593,14 @@ void Wallet::startRefreshThread()
                             m_newWallet = false;
                         }
 
+                        // Scanning from the estimate before the height is refined could skip the blocks in between
+                        if (m_restoreDate > 0 && !this->refineRestoreHeight(daemonHeight)) {
+                            last = std::chrono::steady_clock::now();
+                            continue;
+                        }
+
+                        TRACE_SCOPE("Wallet::refresh");
+                        m_scanStarted = true;
                         m_walletImpl->refresh();
                     }
                     last = std::chrono::steady_clock::now();
@@ -498,6 +616,92 @@ void Wallet::startRefreshThread()
     }
 }
 
+bool Wallet::refineRestoreHeight(quint64 daemonHeight) {
+    // Beware! This code does not run in the GUI thread.
+    // The restore height from the wizard is estimated from a checkpoint table. Now that we are connected,
+    // binary search the block headers around the estimate to find the first block mined on the creation date.
+    // The search is bounded by the table, so a node reporting bogus timestamps can't move it far.
+    // The date is kept in m_restoreDate, the cache attributes are only touched on the GUI thread.
+    const qint64 date = m_restoreDate;
+    if (date <= 0) {
+        return true;
+    }
+
+    // Done with this date, unless another one was set meanwhile
+    auto finish = [this, date]{
+        m_refineAttempts = 0;
+        qint64 expected = date;
+        if (m_restoreDate.compare_exchange_strong(expected, 0)) {
+            QMetaObject::invokeMethod(this, [this]{
+                if (m_restoreDate == 0) {
+                    setCacheAttribute(ATTRIBUTE_RESTORE_DATE, "");
+                }
+            }, Qt::QueuedConnection);
+        }
+        return true;
+    };
+
+    // Blocks below the current height may have been skipped already, the height must not move anymore. This also
+    // covers a wallet that was scanned in an earlier session.
+    if (m_scanStarted || m_wallet2->get_blockchain_current_height() > getWalletCreationHeight()) {
+        qWarning() << "Wallet is already scanning, keeping restore height:" << getWalletCreationHeight();
+        return finish();
+    }
+
+    const RestoreHeightLookup *lookup = RestoreHeightLookup::forNetwork(nettype());
+    int estimate = lookup->estimateHeight(date);
+    int low = std::max(1, estimate - 2 * RestoreHeightLookup::blocksPerDay);
+    int high = std::min(static_cast<int>(daemonHeight) - 1, estimate + 2 * RestoreHeightLookup::blocksPerDay);
+
+    bool rpcFailed = false;
+    auto timestampAt = [this, &rpcFailed](int height, time_t &timestamp) {
+        cryptonote::COMMAND_RPC_GET_BLOCK_HEADER_BY_HEIGHT::request req = AUTO_VAL_INIT(req);
+        cryptonote::COMMAND_RPC_GET_BLOCK_HEADER_BY_HEIGHT::response res = AUTO_VAL_INIT(res);
+        req.height = height;
+
+        try {
+            bool r = m_wallet2->invoke_http_json_rpc("/json_rpc", "get_block_header_by_height", req, res);
+            if (!r || res.status != CORE_RPC_STATUS_OK) {
+                rpcFailed = true;
+                return false;
+            }
+        }
+        catch (const std::exception &e) {
+            rpcFailed = true;
+            return false;
+        }
+
+        timestamp = static_cast<time_t>(res.block_header.timestamp);
+        return true;
+    };
+
+    int height = RestoreHeightLookup::searchHeight(date, low, high, timestampAt);
+    if (height < 0 && rpcFailed) {
+        if (++m_refineAttempts < maxRefineAttempts) {
+            // Tried again on the next refresh, scanning waits until then
+            qWarning() << "Unable to fetch block headers to refine the restore height, attempt" << m_refineAttempts;
+            return false;
+        }
+        qWarning() << "Giving up refining the restore height, keeping estimate:" << getWalletCreationHeight();
+        return finish();
+    }
+
+    if (height < 0) {
+        qWarning() << "Unable to find restore height on node, keeping estimate:" << getWalletCreationHeight();
+    } else {
+        quint64 restoreHeight = std::max(1, height - m_restoreHeightMargin);
+        qInfo() << "Refined restore height from" << getWalletCreationHeight() << "to" << restoreHeight;
+        setWalletCreationHeight(restoreHeight);
+    }
+
+    return finish();
+}
+
+void Wallet::setRestoreDate(qint64 date) {
+    setCacheAttribute(ATTRIBUTE_RESTORE_DATE, QString::number(date));
+    m_restoreDate = date;
+}
+
 void Wallet::onHeightsRefreshed(bool success, quint64 daemonHeight, quint64 targetHeight) {
     m_daemonBlockChainHeight = daemonHeight;
     m_daemonBlockChainTargetHeight = targetHeight;
@@ -537,8 +741,8 @@ quint64 Wallet::daemonBlockChainTargetHeight() const {
 
 void Wallet::syncStatusUpdated(quint64 height, quint64 target) {
     if (height >= (target - 1)) {
-        // TODO: is this needed?
-        this->updateBalance();
+        // Outputs unlock as blocks come in
+        this->syncBalance();
     }
 
     emit syncStatus(height, target, false);
@@ -557,18 +761,24 @@ void Wallet::onNewBlock(uint64_t walletHeight) {
     this->syncStatusUpdated(walletHeight, daemonHeight);
 
     if (this->isSynchronized()) {
-        m_history->refresh();
-        m_coins->refresh();
-        this->subaddress()->updateUsed(this->currentSubaddressAccount());
+        // Deferred until the history, coins or receive tab is shown
+        m_history->requestRefresh();
+        m_coins->requestRefresh();
+        if (conf()->get(Config::subaddressPoolSize).toInt() > 0) {
+            // The unused address pool is kept topped up even when nothing shows it, e.g. in headless mode
+            m_subaddress->updateUsed(m_currentSubaddressAccount);
+        } else {
+            m_subaddress->requestUpdateUsed();
+        }
     }
 }
 
 void Wallet::onUpdated() {
-    this->updateBalance();
+    this->syncBalance();
     if (this->isSynchronized()) {
-        m_history->refresh();
-        m_coins->refresh();
-        this->subaddress()->updateUsed(this->currentSubaddressAccount());
+        m_history->requestRefresh();
+        m_coins->requestRefresh();
+        m_subaddress->requestUpdateUsed();
     }
 }
 
@@ -582,6 +792,7 @@ void Wallet::onRefreshed(bool success, const QString &message) {
 
     if (!this->refreshedOnce) {
         this->refreshedOnce = true;
+        Tracer::instant("Wallet::walletRefreshed");
         emit walletRefreshed();
         // store wallet immediately upon finishing synchronization
         this->storeSafer();
@@ -589,6 +800,7 @@ void Wallet::onRefreshed(bool success, const QString &message) {
 }
 
 void Wallet::refreshModels() {
+    TRACE_SCOPE("Wallet::refreshModels");
     m_history->refresh();
     m_coins->refresh();
     m_subaddress->refresh();
@@ -667,12 +879,14 @@ bool Wallet::exportKeyImagesForOutputsFromStr(const std::string &outputs, std::s
 
 bool Wallet::importKeyImages(const QString& path) {
     bool r = m_walletImpl->importKeyImages(path.toStdString());
+    m_balanceLedger->invalidate();
     this->coins()->refresh();
     return r;
 }
 
 bool Wallet::importKeyImagesFromStr(const std::string &keyImages) {
     bool r = m_walletImpl->importKeyImagesFromStr(keyImages);
+    m_balanceLedger->invalidate();
     this->coins()->refresh();
     return r;
 }
@@ -686,11 +900,15 @@ bool Wallet::exportOutputsToStr(std::string& outputs, bool all) {
 }
 
 bool Wallet::importOutputs(const QString& path) {
-    return m_walletImpl->importOutputs(path.toStdString());
+    bool r = m_walletImpl->importOutputs(path.toStdString());
+    m_balanceLedger->invalidate();
+    return r;
 }
 
 bool Wallet::importOutputsFromStr(const std::string &outputs) {
-    return m_walletImpl->importOutputsFromStr(outputs);
+    bool r = m_walletImpl->importOutputsFromStr(outputs);
+    m_balanceLedger->invalidate();
+    return r;
 }
 
 bool Wallet::importTransaction(const QString& txid) {
@@ -701,6 +919,7 @@ bool Wallet::importTransaction(const QString& txid) {
 // #################### Wallet cache ####################
 
 void Wallet::store() {
+    METRICS_SCOPE("Wallet::store");
     m_walletImpl->store();
 }
 
@@ -895,9 +1114,13 @@ void Wallet::createTransaction(const QString &address, quint64 amount, const QSt
     m_scheduler.run([this, all, address, amount, feeLevel, subtractFeeFromAmount] {
         std::set<uint32_t> subaddr_indices;
 
-        Monero::PendingTransaction *ptImpl = m_walletImpl->createTransaction(address.toStdString(), "", all ? std::optional<uint64_t>() : std::optional<uint64_t>(amount), constants::mixin,
-                                                                             static_cast<Monero::PendingTransaction::Priority>(feeLevel),
-                                                                             currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        Monero::PendingTransaction *ptImpl;
+        {
+            METRICS_SCOPE("Wallet::createTransaction");
+            ptImpl = m_walletImpl->createTransaction(address.toStdString(), "", all ? std::optional<uint64_t>() : std::optional<uint64_t>(amount), constants::mixin,
+                                                     static_cast<Monero::PendingTransaction::Priority>(feeLevel),
+                                                     currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        }
 
         QVector<QString> addresses{address};
         this->onTransactionCreated(ptImpl, addresses);
@@ -920,9 +1143,13 @@ void Wallet::createTransactionMultiDest(const QVector<QString> &addresses, const
         }
 
         std::set<uint32_t> subaddr_indices;
-        Monero::PendingTransaction *ptImpl = m_walletImpl->createTransactionMultDest(dests, "", amount, constants::mixin,
-                                                                                     static_cast<Monero::PendingTransaction::Priority>(feeLevel),
-                                                                                     currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        Monero::PendingTransaction *ptImpl;
+        {
+            METRICS_SCOPE("Wallet::createTransactionMultiDest");
+            ptImpl = m_walletImpl->createTransactionMultDest(dests, "", amount, constants::mixin,
+                                                             static_cast<Monero::PendingTransaction::Priority>(feeLevel),
+                                                             currentSubaddressAccount(), subaddr_indices, m_selectedInputs, subtractFeeFromAmount);
+        }
 
         this->onTransactionCreated(ptImpl, addresses);
     });
@@ -951,6 +1178,151 @@ void Wallet::sweepOutputs(const QVector<QString> &keyImages, QString address, bo
     });
 }
 
+bool Wallet::planConsolidation(ConsolidationPlanner::Params params, int feeLevel) {
+    m_coins->refreshIfStale();
+    QList<CoinsInfo> coins = m_coins->getRows();
+
+    const auto future = m_scheduler.run([this, coins, params, feeLevel]() mutable {
+        // Beware! This code does not run in the GUI thread.
+        METRICS_SCOPE("Wallet::planConsolidation");
+
+        ConsolidationPlan plan;
+        QString error;
+
+        QVector<quint64> baseFees;
+        if (!this->getBaseFees(baseFees) || baseFees.isEmpty()) {
+            error = "Unable to get the base fee from the node";
+        }
+        else {
+            try {
+                // Priorities are 1-based, automatic (0) resolves to what wallet2 would pick for a regular transaction
+                quint32 priority = m_wallet2->adjust_priority(static_cast<quint32>(feeLevel));
+                params.feePerByte = baseFees[std::clamp<int>(priority, 1, static_cast<int>(baseFees.size())) - 1];
+                params.quantizationMask = m_wallet2->get_fee_quantization_mask();
+            }
+            catch (const std::exception &e) {
+                qWarning() << "Failed to get fee parameters:" << QString::fromStdString(e.what());
+                params.feePerByte = baseFees.first();
+            }
+            plan = ConsolidationPlanner::plan(coins, params);
+        }
+
+        QMetaObject::invokeMethod(this, [this, plan, error] {
+            emit consolidationPlanned(plan, error);
+        }, Qt::QueuedConnection);
+    });
+
+    return future.first;
+}
+
+bool Wallet::consolidateOutputs(const QList<ConsolidationBatch> &batches, int feeLevel, quint64 feeBudget) {
+    if (batches.isEmpty() || viewOnly() || m_consolidating.exchange(true)) {
+        return false;
+    }
+    m_consolidationCancelled = false;
+
+    // Each batch goes back to the subaddress it was received on, so no subaddresses get linked
+    QVector<QString> addresses;
+    for (const auto &batch : batches) {
+        addresses.append(this->address(batch.accountIndex, batch.subaddressIndex));
+    }
+
+    qInfo() << "Consolidating outputs in" << batches.size() << "transactions";
+    const auto future = m_scheduler.run([this, batches, addresses, feeLevel, feeBudget] {
+        // Beware! This code does not run in the GUI thread.
+        METRICS_SCOPE("Wallet::consolidateOutputs");
+
+        const int total = batches.size();
+        int completed = 0;
+        quint64 feePaid = 0;
+        QString error;
+
+        for (int i = 0; i < total; i++) {
+            if (m_consolidationCancelled) {
+                error = "Cancelled";
+                break;
+            }
+
+            const auto &batch = batches[i];
+            std::vector<std::string> kis;
+            for (const auto &keyImage : batch.keyImages) {
+                kis.push_back(keyImage.toStdString());
+            }
+
+            Monero::PendingTransaction *ptImpl = m_walletImpl->createTransactionSelected(kis,
+                                                                                         addresses[i].toStdString(),
+                                                                                         1,
+                                                                                         static_cast<Monero::PendingTransaction::Priority>(feeLevel));
+            if (ptImpl->status() != Monero::PendingTransaction::Status_Ok) {
+                error = QString::fromStdString(ptImpl->errorString());
+                m_walletImpl->disposeTransaction(ptImpl);
+                break;
+            }
+
+            // The plan was made at an earlier base fee, don't blindly pay whatever it is now
+            const quint64 fee = ptImpl->fee();
+            if (fee > 2 * batch.fee) {
+                error = QString("Fee of transaction %1 is more than twice the estimate, the network fee may have increased").arg(i + 1);
+                m_walletImpl->disposeTransaction(ptImpl);
+                break;
+            }
+            if (feeBudget > 0 && feePaid + fee > feeBudget) {
+                error = "Fee budget exhausted";
+                m_walletImpl->disposeTransaction(ptImpl);
+                break;
+            }
+
+            QStringList txid;
+            QMap<QString, QString> txHexMap;
+            for (quint64 j = 0; j < ptImpl->txCount(); j++) {
+                QString id = QString::fromStdString(ptImpl->txid()[j]);
+                txid.append(id);
+                txHexMap[id] = QString::fromStdString(ptImpl->signedTxToHex(j));
+            }
+
+            bool success = ptImpl->commit();
+            if (!success) {
+                error = QString::fromStdString(ptImpl->errorString());
+            }
+            m_walletImpl->disposeTransaction(ptImpl);
+            if (!success) {
+                break;
+            }
+
+            completed += 1;
+            feePaid += fee;
+
+            QMetaObject::invokeMethod(this, [this, completed, total, feePaid, txid, txHexMap] {
+                this->onTransactionCommitted(true, nullptr, txid, txHexMap);
+                emit consolidationProgress(completed, total, feePaid, txid);
+            }, Qt::QueuedConnection);
+        }
+
+        if (!error.isEmpty()) {
+            qWarning() << "Consolidation stopped after" << completed << "of" << total << "transactions:" << error;
+        }
+
+        QMetaObject::invokeMethod(this, [this, completed, total, feePaid, error] {
+            m_consolidating = false;
+            emit consolidationFinished(completed, total, feePaid, error);
+        }, Qt::QueuedConnection);
+    });
+
+    if (!future.first) {
+        m_consolidating = false;
+        return false;
+    }
+    return true;
+}
+
+void Wallet::cancelConsolidation() {
+    m_consolidationCancelled = true;
+}
+
+bool Wallet::isConsolidating() const {
+    return m_consolidating;
+}
+
 // Phase 2: Transaction construction completed
 
 void Wallet::onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address) {
@@ -998,7 +1370,7 @@ void Wallet::onTransactionCommitted(bool success, PendingTransaction *tx, const
     this->coins()->refresh();
     this->subaddress()->refresh();
 
-    this->updateBalance();
+    this->syncBalance();
 
     if (!success) {
         return;
@@ -1372,6 +1744,7 @@ bool Wallet::rescanSpent() {
     QMutexLocker locker(&m_asyncMutex);
 
     bool r = m_walletImpl->rescanSpent();
+    m_balanceLedger->invalidate();
     m_coins->refresh();
     return r;
 }
@@ -1380,6 +1753,10 @@ void Wallet::setNewWallet() {
     m_newWallet = true;
 }
 
+FeeHistory* Wallet::feeHistory() const {
+    return m_feeHistory;
+}
+
 bool Wallet::getBaseFees(QVector<quint64> &baseFees) {
     std::vector<uint64_t> base_fees;
 
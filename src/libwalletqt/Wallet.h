@@ -6,6 +6,7 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QReadWriteLock>
 
 #include "utils/scheduler.h"
 #include "PendingTransaction.h"
@@ -13,10 +14,14 @@
 #include "utils/networktype.h"
 #include "PassphraseHelper.h"
 #include "rows/TxBacklogEntry.h"
+#include "ConsolidationPlanner.h"
 
 #include <set>
 
 class WalletListenerImpl;
+class AddressResolver;
+class BalanceLedger;
+class FeeHistory;
 
 namespace Monero {
     struct Wallet; // forward declaration
@@ -144,6 +149,8 @@ public:
     QString walletName() const;
     
     // ##### Balance #####
+    // Balances come from an incrementally maintained ledger, see BalanceLedger
+
     //! returns balance
     quint64 balance() const;
     quint64 balance(quint32 accountIndex) const;
@@ -156,6 +163,7 @@ public:
     
     quint64 viewOnlyBalance(quint32 accountIndex) const;
 
+    //! brings the balance up to date and always emits balanceUpdated
     void updateBalance();
 
     // ##### Subaddresses and Accounts #####
@@ -164,10 +172,17 @@ public:
 
     //! returns the subaddress index of the address
     SubaddressIndex subaddressIndex(const QString &address) const;
+    //! memoized subaddress index and contact of addresses, for views that annotate many of them
+    AddressResolver* addressResolver() const;
 
     quint32 currentSubaddressAccount() const;
     void switchSubaddressAccount(quint32 accountIndex);
     void addSubaddressAccount(const QString& label);
+    //! generates count subaddresses in the current account on a worker, see Subaddress::expandLabel for labels
+    bool addSubaddresses(quint32 count, const QString &labelTemplate);
+    bool isGeneratingSubaddresses() const;
+    //! held for writing while generated subaddresses are added, take it for reading to look up subaddresses in wallet2
+    QReadWriteLock* subaddressLock() const;
     quint32 numSubaddressAccounts() const;
     quint32 numSubaddresses(quint32 accountIndex) const;
     QString getSubaddressLabel(quint32 accountIndex, quint32 addressIndex) const;
@@ -326,6 +341,13 @@ public:
     void createTransactionMultiDest(const QVector<QString> &addresses, const QVector<quint64> &amounts, const QString &description, int feeLevel = 0, bool subtractFeeFromAmount = false);
     void sweepOutputs(const QVector<QString> &keyImages, QString address, bool churn, int outputs, int feeLevel = 0);
 
+    //! plans sweeps of the current account's outputs at the base fee of feeLevel, emits consolidationPlanned
+    bool planConsolidation(ConsolidationPlanner::Params params, int feeLevel = 0);
+    //! creates and relays the batches one after another, without confirmation, stops at the first failure
+    bool consolidateOutputs(const QList<ConsolidationBatch> &batches, int feeLevel = 0, quint64 feeBudget = 0);
+    void cancelConsolidation();
+    bool isConsolidating() const;
+
     void commitTransaction(PendingTransaction *tx, const QString &description="");
     void onTransactionCommitted(bool success, PendingTransaction *tx, const QStringList& txid, const QMap<QString, QString> &txHexMap);
 
@@ -412,6 +434,9 @@ public:
     //! Indicates that the wallet is new
     void setNewWallet();
 
+    //! Pin the restore height to the first block at or after date once connected to a node
+    void setRestoreDate(qint64 date);
+
     //! create a view only wallet
     bool createViewOnly(const QString &path, const QString &password) const;
 
@@ -421,6 +446,8 @@ public:
     void onHeightsRefreshed(bool success, quint64 daemonHeight, quint64 targetHeight);
 
     void getTxPoolStatsAsync();
+    //! pool history and confirmation time estimates per fee tier
+    FeeHistory* feeHistory() const;
     bool getBaseFees(QVector<quint64> &baseFees);
     bool estimateBacklog(const QVector<quint64> &baseFees, QVector<quint64> &backlog);
     bool getBlockWeightLimit(quint64 &blockWeightLimit);
@@ -454,6 +481,10 @@ signals:
 
     void connectionStatusChanged(int status) const;
     void currentSubaddressAccountChanged() const;
+    void subaddressesGenerated(quint32 accountIndex, quint32 first, quint32 count, const QString &error);
+    void consolidationPlanned(const ConsolidationPlan &plan, const QString &error);
+    void consolidationProgress(int completed, int total, quint64 feePaid, const QStringList &txid);
+    void consolidationFinished(int completed, int total, quint64 feePaid, const QString &error);
 
 
     void syncStatus(quint64 height, quint64 target, bool daemonSync = false);
@@ -476,11 +507,16 @@ private:
     // ###### Status ######
     void setConnectionStatus(ConnectionStatus value);
 
+    //! emits balanceUpdated only if a balance changed
+    void syncBalance();
+
     // ##### Synchronization (Refresh) #####
     void startRefreshThread();
     void onNewBlock(uint64_t height);
     void onUpdated();
     void onRefreshed(bool success, const QString &message);
+    //! returns false while the height is still to be refined and scanning has to wait
+    bool refineRestoreHeight(quint64 daemonHeight);
 
     // ##### Transactions #####
     void onTransactionCreated(Monero::PendingTransaction *mtx, const QVector<QString> &address);
@@ -491,6 +527,7 @@ private:
 
     Monero::Wallet *m_walletImpl;
     tools::wallet2 *m_wallet2;
+    QScopedPointer<BalanceLedger> m_balanceLedger;
 
     TransactionHistory *m_history;
     TransactionHistoryModel *m_historyModel;
@@ -525,9 +562,23 @@ private:
 
     bool m_useSSL;
     bool m_newWallet = false;
+    std::atomic<qint64> m_restoreDate{0};  // creation date whose restore height is still to be refined
+    int m_refineAttempts = 0;              // refresh thread only
+    bool m_scanStarted = false;            // refresh thread only
+    static constexpr int maxRefineAttempts = 5;
+    std::atomic<bool> m_generatingSubaddresses{false};
+
+    mutable QReadWriteLock m_subaddressLock{QReadWriteLock::Recursive};
+    static constexpr quint32 subaddressChunkSize = 1000;
+    static constexpr quint32 deviceSubaddressChunkSize = 50;  // a device round trip per subaddress
+    std::atomic<bool> m_consolidating{false};
+    std::atomic<bool> m_consolidationCancelled{false};
+    int m_restoreHeightMargin = 0;
     bool m_forceKeyImageSync = false;
 
     QTimer *m_storeTimer = nullptr;
+    FeeHistory *m_feeHistory = nullptr;
+    AddressResolver *m_addressResolver = nullptr;
     std::set<std::string> m_selectedInputs;
 };
 
@@ -4,6 +4,7 @@
 #include "WalletListenerImpl.h"
 #include "Wallet.h"
 #include "WalletManager.h"
+#include "utils/Logger.h"
 
 WalletListenerImpl::WalletListenerImpl(Wallet * w)
     : m_wallet(w)
@@ -20,7 +21,7 @@ void WalletListenerImpl::moneySpent(const std::string &txId, uint64_t amount)
 {
     // Outgoing tx included in a block
     QString qTxId = QString::fromStdString(txId);
-    qDebug() << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
+    qCDebug(lcWallet) << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
 
     emit m_wallet->moneySpent(qTxId, amount);
 }
@@ -29,7 +30,7 @@ void WalletListenerImpl::moneyReceived(const std::string &txId, uint64_t amount,
 {
     // Incoming tx included in a block.
     QString qTxId = QString::fromStdString(txId);
-    qDebug() << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
+    qCDebug(lcWallet) << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
 
     emit m_wallet->moneyReceived(qTxId, amount, coinbase);
 }
@@ -38,7 +39,7 @@ void WalletListenerImpl::unconfirmedMoneyReceived(const std::string &txId, uint6
 {
     // Incoming tx in pool
     QString qTxId = QString::fromStdString(txId);
-    qDebug() << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
+    qCDebug(lcWallet) << Q_FUNC_INFO << qTxId << " " << WalletManager::displayAmount(amount);
 
     emit m_wallet->unconfirmedMoneyReceived(qTxId, amount);
 }
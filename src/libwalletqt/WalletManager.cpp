@@ -4,7 +4,9 @@
 #include "libwalletqt/WalletManager.h"
 #include "Wallet.h"
 
+#include "utils/AmountFormatter.h"
 #include "utils/ScopeGuard.h"
+#include "utils/Tracer.h"
 #include <wallet/api/wallet2_api.h>
 
 class WalletPassphraseListenerImpl : public Monero::WalletListener, public PassphraseReceiver
@@ -105,8 +107,14 @@ Wallet *WalletManager::openWallet(const QString &path, const QString &password,
 
 void WalletManager::openWalletAsync(const QString &path, const QString &password, NetworkType::Type nettype, quint64 kdfRounds, const QString &ringDatabasePath)
 {
+    Tracer::instant("WalletManager::openWalletAsync");
     m_scheduler.run([this, path, password, nettype, kdfRounds, ringDatabasePath] {
-        emit walletOpened(openWallet(path, password, nettype, kdfRounds, ringDatabasePath));
+        Wallet *wallet;
+        {
+            TRACE_SCOPE("WalletManager::openWallet");
+            wallet = openWallet(path, password, nettype, kdfRounds, ringDatabasePath);
+        }
+        emit walletOpened(wallet);
     });
 }
 
@@ -202,19 +210,7 @@ quint64 WalletManager::maximumAllowedAmount() const
 
 QString WalletManager::displayAmount(quint64 amount, bool trailing_zeroes, int decimals)
 {
-    auto amountStr = QString::fromStdString(Monero::Wallet::displayAmount(amount));
-
-    if (decimals < 12) {
-        int i = amountStr.indexOf(".");
-        amountStr.remove(i+decimals+1, 12);
-    }
-
-    if (!trailing_zeroes) {
-        amountStr.remove(QRegularExpression("0+$"));
-        amountStr.remove(QRegularExpression("\\.$"));
-    }
-
-    return amountStr;
+    return AmountFormatter::toString(amount, decimals, trailing_zeroes);
 }
 
 quint64 WalletManager::amountFromString(const QString &amount)
@@ -268,14 +264,6 @@ QString WalletManager::resolveOpenAlias(const QString &address, bool &dnssecVali
     return QString::fromStdString(res);
 }
 
-void WalletManager::resolveOpenAliasAsync(const QString &alias) {
-    m_scheduler.run([this, alias] {
-        bool dnssecValid;
-        QString address = this->resolveOpenAlias(alias, dnssecValid);
-        emit openAliasResolved(alias, address, dnssecValid);
-    });
-}
-
 void WalletManager::setLogLevel(int logLevel)
 {
     Monero::WalletManagerFactory::setLogLevel(logLevel);
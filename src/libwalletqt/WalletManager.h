@@ -107,7 +107,6 @@ public:
     void setLogCategories(const QString &categories);
 
     QString resolveOpenAlias(const QString &address, bool &dnssecValid) const;
-    void resolveOpenAliasAsync(const QString &address);
 
     // clear/rename wallet cache
     static bool clearWalletCache(const QString &fileName);
@@ -122,7 +121,6 @@ signals:
     void deviceButtonRequest(quint64 buttonCode);
     void deviceButtonPressed();
     void deviceError(const QString &message, quint64 errorCode);
-    void openAliasResolved(const QString &alias, const QString &address, bool dnssecValid);
 
 private:
     friend class WalletPassphraseListenerImpl;
@@ -5,7 +5,10 @@
 
 #include "Application.h"
 #include "constants.h"
+#include "daemon/Headless.h"
 #include "utils/EventFilter.h"
+#include "utils/Logger.h"
+#include "utils/Tracer.h"
 #include "WindowManager.h"
 #include "config.h"
 #include <wallet/api/wallet2_api.h>
@@ -60,6 +63,8 @@ void signal_handler(int signum) {
 
 int main(int argc, char *argv[])
 {
+    const qint64 startupBegin = Tracer::now();
+
     Q_INIT_RESOURCE(assets);
 
 #if defined(Q_OS_LINUX) && defined(STACK_TRACE)
@@ -83,7 +88,18 @@ if (AttachConsole(ATTACH_PARENT_PROCESS)) {
     QApplication::setHighDpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy::Round);
 #endif
 
-    Application app(argc, argv);
+    // Headless mode never shows a window, so it must not need a display server or take the single-instance lock
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        if (QByteArray(argv[i]).startsWith("--headless")) {
+            headless = true;
+        }
+    }
+    if (headless && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv, !headless);
 
     QApplication::setApplicationName("FeatherWallet");
     QApplication::setApplicationVersion(FEATHER_VERSION);
@@ -105,6 +121,18 @@ if (AttachConsole(ATTACH_PARENT_PROCESS)) {
     QCommandLineOption testnetOption("testnet", "Testnet is for development purposes only.");
     parser.addOption(testnetOption);
 
+    QCommandLineOption traceOption("trace", "Record a startup trace and write it to <file> on exit (Chrome trace event format).", "file");
+    parser.addOption(traceOption);
+
+    QCommandLineOption headlessOption("headless", "Open <wallet> without a GUI and serve it over JSON-RPC on a local socket.", "wallet");
+    parser.addOption(headlessOption);
+
+    QCommandLineOption rpcSocketOption("rpc-socket", "Local socket to listen on in headless mode (default: <config dir>/rpc.sock).", "path");
+    parser.addOption(rpcSocketOption);
+
+    QCommandLineOption passwordFileOption("password-file", "Read the wallet password for headless mode from <file> (default: $FEATHER_WALLET_PASSWORD).", "file");
+    parser.addOption(passwordFileOption);
+
     parser.process(app);
 
     if (parser.isSet(versionOption) || parser.isSet(helpOption)) {
@@ -116,6 +144,13 @@ if (AttachConsole(ATTACH_PARENT_PROCESS)) {
         return EXIT_SUCCESS;
     }
 
+    if (parser.isSet(traceOption)) {
+        Tracer::enable(parser.value(traceOption));
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, []{
+            Tracer::dump();
+        });
+    }
+
     bool stagenet = parser.isSet(stagenetOption);
     bool testnet = parser.isSet(testnetOption);
     bool quiet = parser.isSet(quietModeOption);
@@ -202,7 +237,12 @@ if (AttachConsole(ATTACH_PARENT_PROCESS)) {
     QApplication::setFont(fontDef);
 #endif
 
-    qInstallMessageHandler(Utils::applicationLogHandler);
+    Logger::setFilterRules(conf()->get(Config::logFilterRules).toString());
+    if (conf()->get(Config::logToFile).toBool()) {
+        Logger::setLogFile(QString("%1/feather.log").arg(configDir));
+    }
+    Logger::start();
+    qInstallMessageHandler(Logger::messageHandler);
     qRegisterMetaType<QVector<QString>>();
     qRegisterMetaType<TxProofResult>("TxProofResult");
     qRegisterMetaType<QPair<bool, bool>>();
@@ -215,10 +255,35 @@ if (AttachConsole(ATTACH_PARENT_PROCESS)) {
         pool->setMaxThreadCount(8);
     }
 
-    auto wm = windowManager();
-    wm->setEventFilter(&filter);
+    if (parser.isSet(headlessOption)) {
+        QString password = qEnvironmentVariable("FEATHER_WALLET_PASSWORD");
+        if (parser.isSet(passwordFileOption)) {
+            QFile passwordFile(parser.value(passwordFileOption));
+            if (!passwordFile.open(QIODevice::ReadOnly)) {
+                qCritical() << "Unable to read password file:" << passwordFile.errorString();
+                return EXIT_FAILURE;
+            }
+            password = QString::fromUtf8(passwordFile.readAll()).section('\n', 0, 0);
+            if (password.endsWith('\r')) {
+                password.chop(1);
+            }
+        }
+
+        QString socketName = parser.isSet(rpcSocketOption) ? parser.value(rpcSocketOption) : QString("%1/rpc.sock").arg(configDir);
+
+        auto *daemon = new Headless(parser.value(headlessOption), password, socketName, &app);
+        if (!daemon->start()) {
+            return EXIT_FAILURE;
+        }
+    } else {
+        auto wm = windowManager();
+        wm->setEventFilter(&filter);
+    }
+
+    Tracer::complete("main", startupBegin, Tracer::now());
 
     int exitCode = Application::exec();
     qDebug() << "Application::exec() returned";
+    Logger::stop();
     return exitCode;
 }
@@ -7,6 +7,7 @@
 #include "constants.h"
 #include "utils/ColorScheme.h"
 #include "utils/Icons.h"
+#include "utils/Metrics.h"
 #include "utils/Utils.h"
 #include "libwalletqt/WalletManager.h"
 
@@ -17,7 +18,11 @@ CoinsModel::CoinsModel(QObject *parent, Coins *coins)
         , m_coins(coins)
 {
     connect(m_coins, &Coins::refreshStarted, this, &CoinsModel::beginResetModel);
-    connect(m_coins, &Coins::refreshFinished, this, &CoinsModel::endResetModel);
+    connect(m_coins, &Coins::refreshFinished, this, [this]{
+        METRICS_SCOPE("CoinsModel::reset");
+        m_amountCache.fill(QString(), static_cast<qsizetype>(m_coins->count()));
+        endResetModel();
+    });
 }
 
 int CoinsModel::rowCount(const QModelIndex &parent) const
@@ -48,7 +53,7 @@ QVariant CoinsModel::data(const QModelIndex &index, int role) const
     bool selected = row.keyImageKnown && m_selected.contains(row.keyImage);
 
     if(role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::UserRole) {
-        return parseTransactionInfo(row, index.column(), role);
+        return parseTransactionInfo(row, index.row(), index.column(), role);
     }
     else if (role == Qt::BackgroundRole) {
         if (row.spent) {
@@ -183,7 +188,7 @@ bool CoinsModel::setData(const QModelIndex &index, const QVariant &value, int ro
     return false;
 }
 
-QVariant CoinsModel::parseTransactionInfo(const CoinsInfo &cInfo, int column, int role) const
+QVariant CoinsModel::parseTransactionInfo(const CoinsInfo &cInfo, int row, int column, int role) const
 {
     switch (column)
     {
@@ -213,7 +218,14 @@ QVariant CoinsModel::parseTransactionInfo(const CoinsInfo &cInfo, int column, in
             if (role == Qt::UserRole) {
                 return cInfo.amount;
             }
-            return cInfo.displayAmount();
+            if (row >= m_amountCache.size()) {
+                return cInfo.displayAmount();
+            }
+            QString &amount = m_amountCache[row];
+            if (amount.isEmpty()) {
+                amount = cInfo.displayAmount();
+            }
+            return amount;
         }
         case Frozen:
             return cInfo.frozen;
@@ -47,11 +47,14 @@ signals:
     void descriptionChanged();
 
 private:
-    QVariant parseTransactionInfo(const CoinsInfo &cInfo, int column, int role) const;
+    QVariant parseTransactionInfo(const CoinsInfo &cInfo, int row, int column, int role) const;
 
     Coins *m_coins;
     quint32 m_currentSubaddressAccount;
     QSet<QString> m_selected;
+
+    // Formatted amounts per row, rebuilt lazily after a refresh
+    mutable QVector<QString> m_amountCache;
 };
 
 #endif //FEATHER_COINSMODEL_H
@@ -3,6 +3,7 @@
 
 #include "HistoryView.h"
 
+#include "TransactionHistory.h"
 #include "TransactionHistoryProxyModel.h"
 #include "utils/Utils.h"
 #include "utils/config.h"
@@ -61,6 +62,9 @@ void HistoryView::setHistoryModel(TransactionHistoryProxyModel *model) {
     auto action = m_headerMenu->addAction("Show full txid", this, &HistoryView::showFullTxid);
     action->setCheckable(true);
     action->setChecked(conf()->get(Config::historyShowFullTxid).toBool());
+    auto allAccountsAction = m_headerMenu->addAction(tr("Show all accounts"), this, &HistoryView::showAllAccounts);
+    allAccountsAction->setCheckable(true);
+    allAccountsAction->setChecked(this->sourceModel() && this->sourceModel()->transactionHistory() && this->sourceModel()->transactionHistory()->showAllAccounts());
     m_headerMenu->addSeparator();
     m_headerMenu->addAction(tr("Fit to window"), this, &HistoryView::fitColumnsToWindow);
     m_headerMenu->addAction(tr("Fit to contents"), this, &HistoryView::fitColumnsToContents);
@@ -164,6 +168,14 @@ void HistoryView::showFullTxid(bool enabled) {
     }
 }
 
+void HistoryView::showAllAccounts(bool enabled) {
+    TransactionHistoryModel *model = this->sourceModel();
+    if (!model || !model->transactionHistory()) {
+        return;
+    }
+    model->transactionHistory()->setShowAllAccounts(enabled);
+}
+
 void HistoryView::fitColumnsToWindow()
 {
     header()->setSectionResizeMode(QHeaderView::ResizeToContents);
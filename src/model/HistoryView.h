@@ -31,6 +31,7 @@ private slots:
     void showHeaderMenu(const QPoint& position);
     void toggleColumnVisibility(QAction* action);
     void showFullTxid(bool enabled);
+    void showAllAccounts(bool enabled);
     void fitColumnsToWindow();
     void fitColumnsToContents();
     void resetViewToDefaults();
@@ -23,6 +23,8 @@ void SubaddressAccountModel::startReset(){
 }
 
 void SubaddressAccountModel::endReset(){
+    m_balanceCache.fill(QString(), m_subaddressAccount->count());
+    m_unlockedBalanceCache.fill(QString(), m_subaddressAccount->count());
     endResetModel();
 }
 
@@ -86,12 +88,24 @@ QVariant SubaddressAccountModel::parseSubaddressAccountRow(const AccountRow &row
             if (role == Qt::UserRole) {
                 return row.balance;
             }
-            return WalletManager::displayAmount(row.balance);
+            if (index.row() >= m_balanceCache.size()) {
+                return WalletManager::displayAmount(row.balance);
+            }
+            if (m_balanceCache[index.row()].isEmpty()) {
+                m_balanceCache[index.row()] = WalletManager::displayAmount(row.balance);
+            }
+            return m_balanceCache[index.row()];
         case UnlockedBalance:
             if (role == Qt::UserRole) {
                 return row.unlockedBalance;
             }
-            return WalletManager::displayAmount(row.unlockedBalance);
+            if (index.row() >= m_unlockedBalanceCache.size()) {
+                return WalletManager::displayAmount(row.unlockedBalance);
+            }
+            if (m_unlockedBalanceCache[index.row()].isEmpty()) {
+                m_unlockedBalanceCache[index.row()] = WalletManager::displayAmount(row.unlockedBalance);
+            }
+            return m_unlockedBalanceCache[index.row()];
         default:
             return QVariant();
     }
@@ -46,6 +46,10 @@ private:
     QVariant parseSubaddressAccountRow(const AccountRow &row, const QModelIndex &index, int role) const;
 
     SubaddressAccount *m_subaddressAccount;
+
+    // Formatted balances per row, rebuilt lazily after a refresh
+    mutable QVector<QString> m_balanceCache;
+    mutable QVector<QString> m_unlockedBalanceCache;
 };
 
 class SubaddressAccountProxyModel : public QSortFilterProxyModel
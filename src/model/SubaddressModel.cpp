@@ -11,6 +11,7 @@
 #include "utils/config.h"
 #include "utils/ColorScheme.h"
 #include "utils/Icons.h"
+#include "utils/Metrics.h"
 #include "utils/Utils.h"
 
 SubaddressModel::SubaddressModel(QObject *parent, Subaddress *subaddress)
@@ -18,9 +19,28 @@ SubaddressModel::SubaddressModel(QObject *parent, Subaddress *subaddress)
     , m_subaddress(subaddress)
 {
     connect(m_subaddress, &Subaddress::refreshStarted, this, &SubaddressModel::beginResetModel);
-    connect(m_subaddress, &Subaddress::refreshFinished, this, &SubaddressModel::endResetModel);
+    connect(m_subaddress, &Subaddress::refreshFinished, this, [this]{
+        METRICS_SCOPE("SubaddressModel::reset");
+        m_addressCache.fill(QString(), m_subaddress->count());
+        endResetModel();
+    });
+    connect(conf(), &Config::changed, this, [this](Config::ConfigKey key){
+        if (key != Config::showFullAddresses) {
+            return;
+        }
+
+        m_addressCache.fill(QString(), m_subaddress->count());
+        if (this->rowCount() > 0) {
+            emit dataChanged(this->index(0, Address), this->index(this->rowCount() - 1, Address), {Qt::DisplayRole});
+        }
+    });
     connect(m_subaddress, &Subaddress::beginAddRow, this, &SubaddressModel::beginRowAdded);
     connect(m_subaddress, &Subaddress::endAddRow, this, &SubaddressModel::endInsertRows);
+    connect(m_subaddress, &Subaddress::beginAddRows, this, [this](qsizetype first, qsizetype last){
+        m_addressCache.resize(last + 1);
+        this->beginInsertRows(QModelIndex(), static_cast<int>(first), static_cast<int>(last));
+    });
+    connect(m_subaddress, &Subaddress::endAddRows, this, &SubaddressModel::endInsertRows);
     connect(m_subaddress, &Subaddress::rowUpdated, this, &SubaddressModel::rowUpdated);
 }
 
@@ -95,7 +115,6 @@ QVariant SubaddressModel::data(const QModelIndex &index, int role) const
 
 QVariant SubaddressModel::parseSubaddressRow(const SubaddressRow &subaddress, const QModelIndex &index, int role) const
 {
-    bool showFull = conf()->get(Config::showFullAddresses).toBool();
     switch (index.column()) {
         case Index:
         {
@@ -110,9 +129,15 @@ QVariant SubaddressModel::parseSubaddressRow(const SubaddressRow &subaddress, co
         }
         case Address:
         {
-            QString address = subaddress.address;
-            if (!showFull && role != Qt::UserRole) {
-                address = Utils::displayAddress(address);
+            if (conf()->snapshot().showFullAddresses || role == Qt::UserRole) {
+                return subaddress.address;
+            }
+            if (index.row() >= m_addressCache.size()) {
+                return Utils::displayAddress(subaddress.address);
+            }
+            QString &address = m_addressCache[index.row()];
+            if (address.isEmpty()) {
+                address = Utils::displayAddress(subaddress.address);
             }
             return address;
         }
@@ -195,10 +220,16 @@ const SubaddressRow& SubaddressModel::entryFromIndex(const QModelIndex &index) c
 
 void SubaddressModel::rowUpdated(qsizetype index)
 {
+    if (index < m_addressCache.size()) {
+        m_addressCache[index].clear();
+    }
     emit dataChanged(this->index(index, 0), this->index(index, SubaddressModel::COUNT - 1), {Qt::DisplayRole, Qt::EditRole});
 }
 
 void SubaddressModel::beginRowAdded(qsizetype index)
 {
+    if (index <= m_addressCache.size()) {
+        m_addressCache.insert(index, QString());
+    }
     this->beginInsertRows(this->index(index, 0), index, index);
 }
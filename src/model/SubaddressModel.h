@@ -44,6 +44,9 @@ private:
     QVariant parseSubaddressRow(const SubaddressRow &subaddress, const QModelIndex &index, int role) const;
 
     quint32 m_currentSubaddressAccount;
+
+    // Shortened addresses per row, rebuilt lazily after a refresh or when the setting changes
+    mutable QVector<QString> m_addressCache;
 };
 
 #endif // SUBADDRESSMODEL_H
@@ -18,9 +18,10 @@ SubaddressProxyModel::SubaddressProxyModel(QObject *parent, Subaddress *subaddre
 
 bool SubaddressProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-    bool showUsed = conf()->get(Config::showUsedAddresses).toBool();
-    bool showHidden = conf()->get(Config::showHiddenAddresses).toBool();
-    bool showChange = conf()->get(Config::showChangeAddresses).toBool();
+    const ConfigSnapshot &settings = conf()->snapshot();
+    bool showUsed = settings.showUsedAddresses;
+    bool showHidden = settings.showHiddenAddresses;
+    bool showChange = settings.showChangeAddresses;
 
     if (sourceRow < 0 || sourceRow >= m_subaddress->count()) {
         return false;
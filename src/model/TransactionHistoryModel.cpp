@@ -3,32 +3,59 @@
 
 #include "TransactionHistoryModel.h"
 #include "TransactionHistory.h"
-#include "constants.h"
+#include "utils/AmountFormatter.h"
 #include "utils/config.h"
 #include "utils/Icons.h"
 #include "utils/AppData.h"
+#include "utils/Metrics.h"
 #include "utils/Utils.h"
 #include "libwalletqt/rows/TransactionRow.h"
 
 TransactionHistoryModel::TransactionHistoryModel(QObject *parent)
     : QAbstractTableModel(parent),
-    m_transactionHistory(nullptr)
+    m_transactionHistory(nullptr),
+    m_dateFormat(conf()->snapshot().dateTimeFormat + " ")
 {
+    connect(conf(), &Config::changed, this, [this](Config::ConfigKey key){
+        if (key != Config::amountPrecision && key != Config::dateFormat && key != Config::timeFormat) {
+            return;
+        }
+
+        m_dateFormat = conf()->snapshot().dateTimeFormat + " ";
+        this->clearDisplayCache();
+        if (this->rowCount() > 0) {
+            emit dataChanged(this->index(0, Column::Date), this->index(this->rowCount() - 1, Column::Amount), {Qt::DisplayRole});
+        }
+    });
+}
+
+void TransactionHistoryModel::clearDisplayCache() {
+    int rows = this->rowCount();
+    m_dateCache.fill(QString(), rows);
+    m_amountCache.fill(QString(), rows);
 }
 
 void TransactionHistoryModel::setTransactionHistory(TransactionHistory *th) {
     beginResetModel();
     m_transactionHistory = th;
+    this->clearDisplayCache();
     endResetModel();
 
     connect(m_transactionHistory, &TransactionHistory::refreshStarted,
             this, &TransactionHistoryModel::beginResetModel);
-    connect(m_transactionHistory, &TransactionHistory::refreshFinished,
-            this, &TransactionHistoryModel::endResetModel);
+    connect(m_transactionHistory, &TransactionHistory::refreshFinished, this, [this]{
+        METRICS_SCOPE("TransactionHistoryModel::reset");
+        this->clearDisplayCache();
+        endResetModel();
+    });
 
     emit transactionHistoryChanged();
 }
 
+TransactionHistory * TransactionHistoryModel::transactionHistory() const {
+    return m_transactionHistory;
+}
+
 const TransactionRow& TransactionHistoryModel::entryFromIndex(const QModelIndex &index) const {
     Q_ASSERT(index.isValid() && index.row() < m_transactionHistory->count());
     return m_transactionHistory->transaction(index.row());
@@ -58,7 +85,7 @@ QVariant TransactionHistoryModel::data(const QModelIndex &index, int role) const
     const TransactionRow& tInfo = rows[index.row()];
 
     if(role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::UserRole) {
-        return parseTransactionInfo(tInfo, index.column(), role);
+        return parseTransactionInfo(tInfo, index.row(), index.column(), role);
     }
     else if (role == Qt::TextAlignmentRole) {
         switch (index.column()) {
@@ -124,8 +151,10 @@ QVariant TransactionHistoryModel::data(const QModelIndex &index, int role) const
     return {};
 }
 
-QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tInfo, int column, int role) const
+QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tInfo, int row, int column, int role) const
 {
+    const ConfigSnapshot &settings = conf()->snapshot();
+
     switch (column)
     {
         case Column::Date:
@@ -136,8 +165,14 @@ QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tIn
                 }
                 return tInfo.timestamp.toMSecsSinceEpoch();
             }
-            return tInfo.timestamp.toString(QString("%1 %2 ").arg(conf()->get(Config::dateFormat).toString(),
-                                                                    conf()->get(Config::timeFormat).toString()));
+            if (row >= m_dateCache.size()) {
+                return tInfo.timestamp.toString(m_dateFormat);
+            }
+            QString &date = m_dateCache[row];
+            if (date.isEmpty()) {
+                date = tInfo.timestamp.toString(m_dateFormat);
+            }
+            return date;
         }
         case Column::Description:
             return tInfo.description;
@@ -146,12 +181,17 @@ QVariant TransactionHistoryModel::parseTransactionInfo(const TransactionRow &tIn
             if (role == Qt::UserRole) {
                 return tInfo.balanceDelta;
             }
-            QString amount = QString::number(tInfo.balanceDelta / constants::cdiv, 'f', conf()->get(Config::amountPrecision).toInt());
-            amount = (tInfo.balanceDelta < 0) ? amount : "+" + amount;
+            if (row >= m_amountCache.size()) {
+                return AmountFormatter::toString(tInfo.balanceDelta, settings.amountPrecision, true, AmountFormatter::PlusMinus);
+            }
+            QString &amount = m_amountCache[row];
+            if (amount.isEmpty()) {
+                amount = AmountFormatter::toString(tInfo.balanceDelta, settings.amountPrecision, true, AmountFormatter::PlusMinus);
+            }
             return amount;
         }
         case Column::TxID: {
-            if (conf()->get(Config::historyShowFullTxid).toBool()) {
+            if (settings.historyShowFullTxid) {
                 return tInfo.hash;
             }
             return Utils::displayAddress(tInfo.hash, 1);
@@ -30,6 +30,7 @@ public:
 
     explicit TransactionHistoryModel(QObject * parent = nullptr);
     void setTransactionHistory(TransactionHistory * th);
+    TransactionHistory * transactionHistory() const;
     const TransactionRow& entryFromIndex(const QModelIndex& index) const;
 
     int rowCount(const QModelIndex & parent = QModelIndex()) const override;
@@ -45,9 +46,15 @@ signals:
     void transactionDescriptionChanged();
 
 private:
-    QVariant parseTransactionInfo(const TransactionRow &tInfo, int column, int role) const;
+    QVariant parseTransactionInfo(const TransactionRow &tInfo, int row, int column, int role) const;
+    void clearDisplayCache();
 
     TransactionHistory * m_transactionHistory;
+    QString m_dateFormat;  // of the date column, rebuilt when the setting changes
+
+    // Formatted strings per row, rebuilt lazily after a refresh or a display setting change
+    mutable QVector<QString> m_dateCache;
+    mutable QVector<QString> m_amountCache;
 };
 
 #endif // TRANSACTIONHISTORYMODEL_H
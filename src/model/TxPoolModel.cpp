@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "TxPoolModel.h"
+
+#include <QBrush>
+
+#include <algorithm>
+#include <cmath>
+
+#include "libwalletqt/WalletManager.h"
+#include "utils/ColorScheme.h"
+#include "utils/TxPoolDiff.h"
+#include "utils/Utils.h"
+
+int FeeHistogram::bucketFor(quint64 feePerByte) {
+    if (feePerByte <= 1) {
+        return 0;
+    }
+    int bucket = static_cast<int>(std::floor(std::log2(static_cast<double>(feePerByte)) * bucketsPerDoubling));
+    return std::clamp(bucket, 0, bucketCount - 1);
+}
+
+quint64 FeeHistogram::lowerBound(int bucket) {
+    return static_cast<quint64>(std::ceil(std::exp2(static_cast<double>(bucket) / bucketsPerDoubling)));
+}
+
+void FeeHistogram::add(quint64 feePerByte, quint64 weight) {
+    auto &bucket = buckets[bucketFor(feePerByte)];
+    bucket.transactions += 1;
+    bucket.weight += weight;
+}
+
+void FeeHistogram::remove(quint64 feePerByte, quint64 weight) {
+    auto &bucket = buckets[bucketFor(feePerByte)];
+    bucket.transactions -= 1;
+    bucket.weight -= weight;
+}
+
+void FeeHistogram::clear() {
+    buckets.fill(Bucket{});
+}
+
+namespace {
+    QString formatAge(qint64 seconds) {
+        seconds = std::max<qint64>(seconds, 0);
+        if (seconds < 60) {
+            return QString("%1 s").arg(seconds);
+        }
+        if (seconds < 3600) {
+            return QString("%1 min").arg(seconds / 60);
+        }
+        return QString("%1 h %2 min").arg(QString::number(seconds / 3600), QString::number((seconds % 3600) / 60));
+    }
+}
+
+TxPoolModel::TxPoolModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int TxPoolModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(m_rows.size());
+}
+
+int TxPoolModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return Column::COUNT;
+}
+
+QVariant TxPoolModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return {};
+    }
+
+    const Row &row = m_rows[index.row()];
+
+    if (role == Qt::UserRole) {
+        switch (index.column()) {
+            case Weight:
+                return row.weight;
+            case Fee:
+                return row.fee;
+            case FeePerByte:
+                return row.feePerByte;
+            case TimeInPool:
+                return m_pollTime - row.received;
+            default:
+                return {};
+        }
+    }
+    else if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case Weight:
+                return QString("%1 B").arg(row.weight);
+            case Fee:
+                if (row.feeText.isEmpty()) {
+                    row.feeText = QString("%1 XMR").arg(WalletManager::displayAmount(row.fee));
+                }
+                return row.feeText;
+            case FeePerByte:
+                return QString::number(row.feePerByte);
+            case TimeInPool:
+                return formatAge(m_pollTime - row.received);
+            default:
+                return {};
+        }
+    }
+    else if (role == Qt::TextAlignmentRole) {
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    else if (role == Qt::FontRole) {
+        if (index.column() == Fee) {
+            return Utils::getMonospaceFont();
+        }
+    }
+    else if (role == Qt::BackgroundRole) {
+        if (index.column() == FeePerByte && m_baseFees.size() == 4) {
+            if (row.feePerByte == m_baseFees[3]) {
+                return QBrush(ColorScheme::RED.asColor(true));
+            }
+            if (row.feePerByte == m_baseFees[2]) {
+                return QBrush(ColorScheme::YELLOW.asColor(true));
+            }
+            if (row.feePerByte == m_baseFees[1]) {
+                return QBrush(ColorScheme::GREEN.asColor(true));
+            }
+            if (row.feePerByte == m_baseFees[0]) {
+                return QBrush(ColorScheme::BLUE.asColor(true));
+            }
+        }
+    }
+
+    return {};
+}
+
+QVariant TxPoolModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal) {
+        return {};
+    }
+    if (role == Qt::TextAlignmentRole) {
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return {};
+    }
+    switch (section) {
+        case Weight:
+            return QString("Weight");
+        case Fee:
+            return QString("Fee");
+        case FeePerByte:
+            return QString("Fee / B");
+        case TimeInPool:
+            return QString("In pool");
+        default:
+            return {};
+    }
+}
+
+void TxPoolModel::applySnapshot(const QVector<TxBacklogEntry> &entries, qint64 pollTime) {
+    PoolDiff diff = diffPool(m_rows, entries, pollTime);
+    const QVector<bool> &keep = diff.kept;
+    const int removed = diff.removed;
+
+    QVector<Row> added;
+    added.reserve(diff.added.size());
+    for (const auto &tx : diff.added) {
+        Row row;
+        row.fee = tx.fee;
+        row.weight = tx.weight;
+        row.feePerByte = tx.feePerByte();
+        row.received = tx.received;
+        added.append(row);
+    }
+
+    m_pollTime = pollTime;
+
+    if (removed > 0 && removed > m_rows.size() / 2) {
+        // Mostly replaced, a reset is cheaper for attached views than many removals
+        beginResetModel();
+        QVector<Row> rows;
+        rows.reserve(m_rows.size() - removed + added.size());
+        for (int i = 0; i < m_rows.size(); i++) {
+            if (keep[i]) {
+                rows.append(std::move(m_rows[i]));
+            } else {
+                this->account(m_rows[i], false);
+            }
+        }
+        for (auto &row : added) {
+            this->account(row, true);
+            rows.append(std::move(row));
+        }
+        m_rows = std::move(rows);
+        endResetModel();
+    }
+    else {
+        // Remove contiguous ranges back to front, so earlier row numbers stay valid
+        int end = static_cast<int>(m_rows.size()) - 1;
+        while (end >= 0) {
+            if (keep[end]) {
+                end--;
+                continue;
+            }
+            int first = end;
+            while (first > 0 && !keep[first - 1]) {
+                first--;
+            }
+            beginRemoveRows(QModelIndex(), first, end);
+            for (int i = first; i <= end; i++) {
+                this->account(m_rows[i], false);
+            }
+            m_rows.remove(first, end - first + 1);
+            endRemoveRows();
+            end = first - 1;
+        }
+
+        if (!added.isEmpty()) {
+            const int first = static_cast<int>(m_rows.size());
+            beginInsertRows(QModelIndex(), first, first + static_cast<int>(added.size()) - 1);
+            for (auto &row : added) {
+                this->account(row, true);
+                m_rows.append(std::move(row));
+            }
+            endInsertRows();
+        }
+
+        if (!m_rows.isEmpty()) {
+            // Time in pool advanced for every remaining transaction
+            emit dataChanged(this->index(0, TimeInPool), this->index(static_cast<int>(m_rows.size()) - 1, TimeInPool));
+        }
+    }
+
+    emit poolUpdated(static_cast<int>(added.size()), removed);
+}
+
+void TxPoolModel::setBaseFees(const QVector<quint64> &baseFees) {
+    if (baseFees == m_baseFees) {
+        return;
+    }
+    m_baseFees = baseFees;
+
+    // Rare, tiers only move with the median block weight
+    m_tierWeights.fill(0, m_baseFees.size());
+    for (const auto &row : m_rows) {
+        for (int i = 0; i < m_baseFees.size(); i++) {
+            if (row.feePerByte >= m_baseFees[i]) {
+                m_tierWeights[i] += row.weight;
+            }
+        }
+    }
+
+    if (!m_rows.isEmpty()) {
+        emit dataChanged(this->index(0, FeePerByte), this->index(static_cast<int>(m_rows.size()) - 1, FeePerByte), {Qt::BackgroundRole});
+    }
+}
+
+void TxPoolModel::clear() {
+    beginResetModel();
+    m_rows.clear();
+    m_tierWeights.fill(0, m_baseFees.size());
+    m_histogram.clear();
+    m_totalWeight = 0;
+    m_totalFees = 0;
+    endResetModel();
+}
+
+quint64 TxPoolModel::tierWeight(int tier) const {
+    if (tier < 0 || tier >= m_tierWeights.size()) {
+        return 0;
+    }
+    return m_tierWeights[tier];
+}
+
+void TxPoolModel::account(const Row &row, bool add) {
+    if (add) {
+        m_totalWeight += row.weight;
+        m_totalFees += row.fee;
+        m_histogram.add(row.feePerByte, row.weight);
+    } else {
+        m_totalWeight -= row.weight;
+        m_totalFees -= row.fee;
+        m_histogram.remove(row.feePerByte, row.weight);
+    }
+
+    for (int i = 0; i < m_baseFees.size(); i++) {
+        if (row.feePerByte >= m_baseFees[i]) {
+            m_tierWeights[i] = add ? m_tierWeights[i] + row.weight : m_tierWeights[i] - row.weight;
+        }
+    }
+}
+
+TxPoolProxyModel::TxPoolProxyModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setSortRole(Qt::UserRole);
+}
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TXPOOLMODEL_H
+#define FEATHER_TXPOOLMODEL_H
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <QVector>
+
+#include <array>
+
+#include "libwalletqt/rows/TxBacklogEntry.h"
+
+// Transaction weight per fee-per-byte range, buckets are spaced logarithmically
+struct FeeHistogram
+{
+    static constexpr int bucketsPerDoubling = 4;
+    static constexpr int bucketCount = 32 * bucketsPerDoubling;
+
+    struct Bucket {
+        quint64 transactions = 0;
+        quint64 weight = 0;
+    };
+
+    std::array<Bucket, bucketCount> buckets{};
+
+    static int bucketFor(quint64 feePerByte);
+    //! smallest fee per byte that falls into the bucket
+    static quint64 lowerBound(int bucket);
+
+    void add(quint64 feePerByte, quint64 weight);
+    void remove(quint64 feePerByte, quint64 weight);
+    void clear();
+};
+
+// The transaction pool, updated with the difference between consecutive polls instead of being rebuilt.
+//
+// The daemon's backlog doesn't include transaction hashes, see diffPool() for how transactions are matched. Totals,
+// fee tier weights and the fee histogram are adjusted for every added and removed transaction only.
+class TxPoolModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        Weight = 0,
+        Fee,
+        FeePerByte,
+        TimeInPool,
+        COUNT
+    };
+
+    explicit TxPoolModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+    //! replaces the pool contents, pollTime is when the backlog was fetched (seconds since epoch)
+    void applySnapshot(const QVector<TxBacklogEntry> &entries, qint64 pollTime);
+    void setBaseFees(const QVector<quint64> &baseFees);
+    void clear();
+
+    quint64 totalWeight() const { return m_totalWeight; }
+    quint64 totalFees() const { return m_totalFees; }
+    const QVector<quint64>& baseFees() const { return m_baseFees; }
+    //! weight of transactions paying at least the fee per byte of the tier
+    quint64 tierWeight(int tier) const;
+    const FeeHistogram& histogram() const { return m_histogram; }
+
+signals:
+    //! emitted once per snapshot with the number of added and removed transactions
+    void poolUpdated(int added, int removed);
+
+private:
+    struct Row {
+        quint64 weight = 0;
+        quint64 fee = 0;
+        quint64 feePerByte = 0;
+        qint64 received = 0;
+        mutable QString feeText;  // formatted on first display
+    };
+
+    void account(const Row &row, bool add);
+
+    QVector<Row> m_rows;
+    QVector<quint64> m_baseFees;
+    QVector<quint64> m_tierWeights;
+    FeeHistogram m_histogram;
+
+    quint64 m_totalWeight = 0;
+    quint64 m_totalFees = 0;
+    qint64 m_pollTime = 0;
+};
+
+class TxPoolProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit TxPoolProxyModel(QObject *parent = nullptr);
+};
+
+#endif //FEATHER_TXPOOLMODEL_H
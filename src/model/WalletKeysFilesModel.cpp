@@ -6,6 +6,11 @@
 #include "utils/Utils.h"
 #include <QDir>
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent/QtConcurrent>
 #include "config.h"
 
 using namespace std::chrono;
@@ -19,6 +24,65 @@ WalletKeysFile::WalletKeysFile(const QFileInfo &info, int networkType, QString a
 {
 }
 
+WalletKeysFile::WalletKeysFile(QString fileName, qint64 modified, QString path, int networkType, QString address)
+    : m_fileName(std::move(fileName))
+    , m_modified(modified)
+    , m_path(std::move(path))
+    , m_networkType(networkType)
+    , m_address(std::move(address))
+{
+}
+
+WalletKeysFile WalletKeysFile::fromFileInfo(const QFileInfo &info) {
+    const QString basePath = QString("%1/%2").arg(info.path(), info.baseName());
+    QString addr = QString("");
+    quint8 networkType = NetworkType::MAINNET;
+
+    if (Utils::fileExists(basePath + ".address.txt")) {
+        QFile file(basePath + ".address.txt");
+        file.open(QFile::ReadOnly | QFile::Text);
+        const QString _address = QString::fromUtf8(file.readAll());
+
+        if (!_address.isEmpty()) {
+            addr = _address;
+            if (addr.startsWith("5") || addr.startsWith("7"))
+                networkType = NetworkType::STAGENET;
+            else if (addr.startsWith("9") || addr.startsWith("B"))
+                networkType = NetworkType::TESTNET;
+        }
+        file.close();
+    }
+
+    return {info, networkType, std::move(addr)};
+}
+
+bool WalletKeysFile::fromJson(const QJsonObject &obj, WalletKeysFile &walletKeysFile) {
+    if (!obj.contains("path") || !obj.contains("modified") || !obj.contains("networkType")) {
+        return false;
+    }
+
+    QString path = obj.value("path").toString();
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    walletKeysFile = WalletKeysFile(QFileInfo(path).fileName(),
+                                    obj.value("modified").toInteger(),
+                                    path,
+                                    obj.value("networkType").toInt(),
+                                    obj.value("address").toString());
+    return true;
+}
+
+QJsonObject WalletKeysFile::toJson() const {
+    QJsonObject obj;
+    obj["path"] = m_path;
+    obj["modified"] = m_modified;
+    obj["networkType"] = m_networkType;
+    obj["address"] = m_address;
+    return obj;
+}
+
 qint64 WalletKeysFile::getModified(const QFileInfo &info) {
     qint64 m = info.lastModified().toSecsSinceEpoch();
 
@@ -34,8 +98,20 @@ qint64 WalletKeysFile::getModified(const QFileInfo &info) {
 
 WalletKeysFilesModel::WalletKeysFilesModel(QObject *parent)
     : QAbstractTableModel(parent)
+    , m_fsWatcher(new QFileSystemWatcher(this))
+    , m_scanWatcher(new QFutureWatcher<ScanResult>(this))
 {
     this->updateDirectories();
+
+    // Coalesce bursts of filesystem events (e.g. a wallet being saved) into a single rescan
+    m_rescanTimer.setSingleShot(true);
+    m_rescanTimer.setInterval(1000);
+    connect(&m_rescanTimer, &QTimer::timeout, this, &WalletKeysFilesModel::rescan);
+
+    connect(m_fsWatcher, &QFileSystemWatcher::directoryChanged, [this](const QString &path) {
+        m_rescanTimer.start();
+    });
+    connect(m_scanWatcher, &QFutureWatcher<ScanResult>::finished, this, &WalletKeysFilesModel::onScanFinished);
 }
 
 void WalletKeysFilesModel::clear() {
@@ -45,9 +121,15 @@ void WalletKeysFilesModel::clear() {
 }
 
 void WalletKeysFilesModel::refresh() {
-    this->clear();
-    this->findWallets();
-    endResetModel();
+    this->updateDirectories();
+
+    if (m_walletKeyFiles.isEmpty() && !this->loadIndex()) {
+        // No index yet, the first scan has to be synchronous so callers see the wallets immediately
+        this->findWallets();
+        return;
+    }
+
+    this->rescan();
 }
 
 void WalletKeysFilesModel::updateDirectories() {
@@ -69,54 +151,216 @@ void WalletKeysFilesModel::updateDirectories() {
     m_walletDirectories.removeDuplicates();
 }
 
-void WalletKeysFilesModel::findWallets() {
-    qDebug() << "wallet .keys search initiated";
-    auto now = high_resolution_clock::now();
+void WalletKeysFilesModel::updateWatchedDirectories(const QStringList &directories) {
+    QStringList watched = m_fsWatcher->directories();
+
+    QStringList toRemove;
+    for (const auto &dir : watched) {
+        if (!directories.contains(dir)) {
+            toRemove << dir;
+        }
+    }
+    if (!toRemove.isEmpty()) {
+        m_fsWatcher->removePaths(toRemove);
+    }
+
+    QStringList toAdd;
+    for (const auto &dir : directories) {
+        if (!watched.contains(dir)) {
+            toAdd << dir;
+        }
+    }
+    if (!toAdd.isEmpty()) {
+        m_fsWatcher->addPaths(toAdd);
+    }
+}
+
+WalletKeysFilesModel::ScanResult WalletKeysFilesModel::scan(const QStringList &walletDirectories, const QHash<QString, WalletKeysFile> &known) {
+    ScanResult result;
 
     QRegularExpression rx(QRegularExpression::wildcardToRegularExpression("*.keys"));
     QStringList walletPaths;
 
-    for(auto i = 0; i != m_walletDirectories.length(); i++) {
+    for(auto i = 0; i != walletDirectories.length(); i++) {
         // Scan default wallet dir (~/Monero/)
-        walletPaths << Utils::fileFind(rx, m_walletDirectories[i], 0, i == 0 ? 2 : 0, 200);
+        walletPaths << Utils::fileFind(rx, walletDirectories[i], 0, i == 0 ? 2 : 0, 200);
+
+        if (Utils::dirExists(walletDirectories[i])) {
+            result.directories << walletDirectories[i];
+        }
     }
 
     walletPaths.removeDuplicates();
     for(const auto &walletPath: walletPaths) {
-        QFile walletPathFile(walletPath);
-        if(walletPathFile.size() <= 0)
+        QFileInfo fileInfo(walletPath);
+        if(fileInfo.size() <= 0)
             continue;
 
-        QFileInfo fileInfo(walletPath);
-        const QString absPath = fileInfo.absoluteFilePath();
-        const QString path = fileInfo.path();
-        const QString baseName = fileInfo.baseName();
-        const QString basePath = QString("%1/%2").arg(path).arg(baseName);
-        QString addr = QString("");
-        quint8 networkType = NetworkType::MAINNET;
-
-        if (Utils::fileExists(basePath + ".address.txt")) {
-            QFile file(basePath + ".address.txt");
-            file.open(QFile::ReadOnly | QFile::Text);
-            const QString _address = QString::fromUtf8(file.readAll());
-
-            if (!_address.isEmpty()) {
-                addr = _address;
-                if (addr.startsWith("5") || addr.startsWith("7"))
-                    networkType = NetworkType::STAGENET;
-                else if (addr.startsWith("9") || addr.startsWith("B"))
-                    networkType = NetworkType::TESTNET;
-            }
-            file.close();
+        // Wallets in subdirectories of the default wallet dir are picked up by the depth 2 search
+        const QString dirPath = fileInfo.absolutePath();
+        if (!result.directories.contains(dirPath)) {
+            result.directories << dirPath;
+        }
+
+        // Only re-read .address.txt for wallets we haven't seen or that were modified since the last scan
+        const QString path = QDir::toNativeSeparators(fileInfo.absoluteFilePath());
+        auto it = known.constFind(path);
+        if (it != known.constEnd() && it->modified() == WalletKeysFile::getModified(fileInfo)) {
+            result.walletKeysFiles << it.value();
+            continue;
         }
 
-        this->addWalletKeysFile(WalletKeysFile(fileInfo, networkType, std::move(addr)));
+        result.walletKeysFiles << WalletKeysFile::fromFileInfo(fileInfo);
     }
 
+    return result;
+}
+
+void WalletKeysFilesModel::findWallets() {
+    qDebug() << "wallet .keys search initiated";
+    auto now = high_resolution_clock::now();
+
+    ScanResult result = scan(m_walletDirectories, {});
+    this->mergeScanResult(result.walletKeysFiles);
+    this->updateWatchedDirectories(result.directories);
+    this->saveIndex();
+
     auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - now).count();
     qDebug() << QString("wallet .keys search completed in %1 ms").arg(duration);
 }
 
+void WalletKeysFilesModel::rescan() {
+    if (m_scanWatcher->isRunning()) {
+        m_rescanPending = true;
+        return;
+    }
+
+    QHash<QString, WalletKeysFile> known;
+    for (const auto &walletKeysFile : m_walletKeyFiles) {
+        known.insert(walletKeysFile.path(), walletKeysFile);
+    }
+
+    QStringList walletDirectories = m_walletDirectories;
+    m_scanWatcher->setFuture(QtConcurrent::run([walletDirectories, known]{
+        return scan(walletDirectories, known);
+    }));
+}
+
+void WalletKeysFilesModel::onScanFinished() {
+    ScanResult result = m_scanWatcher->result();
+    this->mergeScanResult(result.walletKeysFiles);
+    this->updateWatchedDirectories(result.directories);
+    this->saveIndex();
+
+    emit scanFinished();
+
+    if (m_rescanPending) {
+        m_rescanPending = false;
+        this->rescan();
+    }
+}
+
+void WalletKeysFilesModel::mergeScanResult(const QList<WalletKeysFile> &walletKeysFiles) {
+    QHash<QString, qsizetype> found;
+    for (qsizetype i = 0; i < walletKeysFiles.length(); i++) {
+        found.insert(walletKeysFiles[i].path(), i);
+    }
+
+    // Remove wallets that no longer exist
+    for (qsizetype row = m_walletKeyFiles.length() - 1; row >= 0; row--) {
+        if (!found.contains(m_walletKeyFiles[row].path())) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_walletKeyFiles.removeAt(row);
+            endRemoveRows();
+        }
+    }
+
+    // Update wallets that changed in place, so the view keeps its selection
+    QSet<QString> existing;
+    for (qsizetype row = 0; row < m_walletKeyFiles.length(); row++) {
+        const QString &path = m_walletKeyFiles[row].path();
+        existing.insert(path);
+
+        const WalletKeysFile &updated = walletKeysFiles[found.value(path)];
+        if (updated.modified() != m_walletKeyFiles[row].modified() || updated.address() != m_walletKeyFiles[row].address()) {
+            m_walletKeyFiles[row] = updated;
+            emit dataChanged(this->index(row, 0), this->index(row, Column::COUNT - 1));
+        }
+    }
+
+    QList<WalletKeysFile> added;
+    for (const auto &walletKeysFile : walletKeysFiles) {
+        if (!existing.contains(walletKeysFile.path())) {
+            added << walletKeysFile;
+        }
+    }
+
+    if (added.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), rowCount(), rowCount() + added.length() - 1);
+    m_walletKeyFiles.append(added);
+    endInsertRows();
+}
+
+QString WalletKeysFilesModel::indexPath() {
+    return Config::defaultConfigDir().filePath("walletIndex.json");
+}
+
+bool WalletKeysFilesModel::loadIndex() {
+    if (!conf()->get(Config::writeRecentlyOpenedWallets).toBool()) {
+        return false;
+    }
+
+    QFile file(indexPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isArray()) {
+        qWarning() << "Unable to parse wallet index";
+        return false;
+    }
+
+    QList<WalletKeysFile> walletKeysFiles;
+    for (const auto &value : doc.array()) {
+        WalletKeysFile walletKeysFile("", 0, "", NetworkType::MAINNET, "");
+        if (WalletKeysFile::fromJson(value.toObject(), walletKeysFile)) {
+            walletKeysFiles << walletKeysFile;
+        }
+    }
+
+    if (walletKeysFiles.isEmpty()) {
+        return false;
+    }
+
+    this->mergeScanResult(walletKeysFiles);
+    return true;
+}
+
+void WalletKeysFilesModel::saveIndex() const {
+    // The index reveals wallet locations, respect the user's choice to not store these on disk
+    if (!conf()->get(Config::writeRecentlyOpenedWallets).toBool()) {
+        QFile::remove(indexPath());
+        return;
+    }
+
+    QJsonArray arr;
+    for (const auto &walletKeysFile : m_walletKeyFiles) {
+        arr.append(walletKeysFile.toJson());
+    }
+
+    QSaveFile file(indexPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Unable to write wallet index";
+        return;
+    }
+    file.write(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
 void WalletKeysFilesModel::addWalletKeysFile(const WalletKeysFile &walletKeysFile) {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_walletKeyFiles.append(walletKeysFile);
@@ -8,6 +8,10 @@
 #include <QFileInfo>
 #include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QJsonObject>
+#include <QTimer>
 
 #include "utils/networktype.h"
 
@@ -15,6 +19,11 @@ class WalletKeysFile
 {
 public:
     WalletKeysFile(const QFileInfo &info, int networkType, QString address);
+    WalletKeysFile(QString fileName, qint64 modified, QString path, int networkType, QString address);
+
+    static WalletKeysFile fromFileInfo(const QFileInfo &info);
+    static bool fromJson(const QJsonObject &obj, WalletKeysFile &walletKeysFile);
+    QJsonObject toJson() const;
 
     QString fileName() const {return m_fileName;};
     qint64 modified() const {return m_modified;};
@@ -22,9 +31,10 @@ public:
     int networkType() const {return m_networkType;};
     QString address() const {return m_address;};
 
-private:
     static qint64 getModified(const QFileInfo &info);
 
+private:
+
     QString m_fileName;
     qint64 m_modified;
     QString m_path;
@@ -51,6 +61,7 @@ public:
     Q_INVOKABLE void clear();
 
     void findWallets();
+    void rescan();
     void addWalletKeysFile(const WalletKeysFile &walletKeysFile);
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -58,12 +69,35 @@ public:
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
+signals:
+    void scanFinished();
+
+private slots:
+    void onScanFinished();
+
 private:
+    struct ScanResult {
+        QList<WalletKeysFile> walletKeysFiles;
+        QStringList directories;
+    };
+
+    static ScanResult scan(const QStringList &walletDirectories, const QHash<QString, WalletKeysFile> &known);
+    static QString indexPath();
+
     void updateDirectories();
+    void updateWatchedDirectories(const QStringList &directories);
+    void mergeScanResult(const QList<WalletKeysFile> &walletKeysFiles);
+    bool loadIndex();
+    void saveIndex() const;
 
     QStringList m_walletDirectories;
 
     QList<WalletKeysFile> m_walletKeyFiles;
+
+    QFileSystemWatcher *m_fsWatcher;
+    QFutureWatcher<ScanResult> *m_scanWatcher;
+    QTimer m_rescanTimer;
+    bool m_rescanPending = false;
 };
 
 class WalletKeysFilesProxyModel : public QSortFilterProxyModel
@@ -30,7 +30,7 @@ URDialog::URDialog(QWidget *parent)
         std::string data = qdata.toStdString();
         file.close();
         
-        ui->widgetUR->setData("any", data);
+        ui->widgetUR->setData("any", std::move(data));
     });
     
     connect(ui->btn_loadClipboard, &QPushButton::clicked, [this]{
@@ -42,7 +42,7 @@ URDialog::URDialog(QWidget *parent)
         
         std::string data = qdata.toStdString();
         
-        ui->widgetUR->setData("any", data);
+        ui->widgetUR->setData("any", std::move(data));
     });
     
     connect(ui->tabWidget, &QTabWidget::currentChanged, [this](int index){
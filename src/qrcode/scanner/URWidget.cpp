@@ -17,44 +17,50 @@ URWidget::URWidget(QWidget *parent)
     connect(ui->btn_options, &QPushButton::clicked, this, &URWidget::setOptions);
 }
 
-void URWidget::setData(const QString &type, const std::string &data) {
+void URWidget::setData(const QString &type, std::string data) {
     m_type = type;
-    m_data = data;
+    m_data = std::move(data);
     
     m_timer.stop();
     allParts.clear();
+    currentIndex = 0;
     
     if (m_data.empty()) {
         return;
     }
     
-    std::string type_std = m_type.toStdString();
-
-    ur::ByteVector a = ur::string_to_bytes(m_data);
-    ur::ByteVector cbor;
-    ur::CborLite::encodeBytes(cbor, a);
-    ur::UR h = ur::UR(type_std, cbor);
-
     int bytesPerFragment = conf()->get(Config::URfragmentLength).toInt();
 
     delete m_urencoder;
-    m_urencoder = new ur::UREncoder(h, bytesPerFragment);
-
-    for (int i=0; i < m_urencoder->seq_len(); i++) {
-        allParts.append(m_urencoder->next_part());
+    {
+        // CBOR-encode straight from m_data, the temporaries are freed once the encoder holds its own copy
+        ur::ByteVector cbor;
+        cbor.reserve(m_data.size() + 9);
+        ur::CborLite::encodeBytes(cbor, m_data);
+        m_urencoder = new ur::UREncoder(ur::UR(m_type.toStdString(), cbor), bytesPerFragment);
     }
 
     m_timer.setInterval(conf()->get(Config::URmsPerFragment).toInt());
     m_timer.start();
+    this->nextQR();
 }
 
 void URWidget::nextQR() {
+    if (!m_urencoder) {
+        return;
+    }
+
     currentIndex = currentIndex % m_urencoder->seq_len();
 
     std::string data;
     if (conf()->get(Config::URfountainCode).toBool()) {
         data = m_urencoder->next_part();
     } else {
+        // The first seq_len parts are the plain fragments in order, generate them as they are shown instead of
+        // all up front, which took seconds for large exports.
+        if (currentIndex >= allParts.size()) {
+            allParts.append(m_urencoder->next_part());
+        }
         data = allParts[currentIndex];
     }
     
@@ -69,7 +75,8 @@ void URWidget::nextQR() {
 void URWidget::setOptions() {
     URSettingsDialog dialog{this};
     dialog.exec();
-    this->setData(m_type, m_data);
+    std::string data = std::move(m_data);
+    this->setData(m_type, std::move(data));
 }
 
 URWidget::~URWidget() {
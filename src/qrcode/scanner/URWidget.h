@@ -22,7 +22,8 @@ public:
     explicit URWidget(QWidget *parent = nullptr);
     ~URWidget();
     
-    void setData(const QString &type, const std::string &data);
+    //! takes ownership of data, pass an rvalue to avoid a copy of large payloads
+    void setData(const QString &type, std::string data);
 
 private slots:
     void nextQR();
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "AmountFormatter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace AmountFormatter
+{
+    int format(char *buf, quint64 amount, int decimals, bool trailingZeroes, char sign) {
+        decimals = std::clamp(decimals, 0, maxDecimals);
+
+        int len = 0;
+        if (sign) {
+            buf[len++] = sign;
+        }
+
+        char digits[20];
+        int n = 0;
+        quint64 whole = amount / piconero;
+        do {
+            digits[n++] = static_cast<char>('0' + whole % 10);
+            whole /= 10;
+        } while (whole);
+        while (n) {
+            buf[len++] = digits[--n];
+        }
+
+        if (decimals == 0) {
+            return len;
+        }
+
+        char fraction[maxDecimals];
+        quint64 rest = amount % piconero;
+        for (int i = maxDecimals - 1; i >= 0; i--) {
+            fraction[i] = static_cast<char>('0' + rest % 10);
+            rest /= 10;
+        }
+
+        int end = decimals;
+        if (!trailingZeroes) {
+            while (end > 0 && fraction[end - 1] == '0') {
+                end--;
+            }
+            if (end == 0) {
+                return len;
+            }
+        }
+
+        buf[len++] = '.';
+        std::memcpy(buf + len, fraction, end);
+        return len + end;
+    }
+
+    QString toString(quint64 amount, int decimals, bool trailingZeroes) {
+        char buf[bufferSize];
+        int len = format(buf, amount, decimals, trailingZeroes);
+        return QString::fromLatin1(buf, len);
+    }
+
+    QString toString(qint64 amount, int decimals, bool trailingZeroes, Sign sign) {
+        // negate in unsigned arithmetic, -INT64_MIN does not fit in qint64
+        bool negative = amount < 0;
+        quint64 magnitude = negative ? 0 - static_cast<quint64>(amount) : static_cast<quint64>(amount);
+
+        char signChar = 0;
+        if (negative && sign != NoSign) {
+            signChar = '-';
+        } else if (!negative && sign == PlusMinus) {
+            signChar = '+';
+        }
+
+        char buf[bufferSize];
+        int len = format(buf, magnitude, decimals, trailingZeroes, signChar);
+        return QString::fromLatin1(buf, len);
+    }
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_AMOUNTFORMATTER_H
+#define FEATHER_AMOUNTFORMATTER_H
+
+#include <QString>
+
+// Integer fixed-point formatting of piconero amounts.
+//
+// Digits beyond the requested precision are truncated, never rounded, so a displayed amount is never more than
+// what the wallet holds. No floating point is involved, large amounts are exact.
+namespace AmountFormatter
+{
+    constexpr quint64 piconero = 1000000000000ull;
+    constexpr int maxDecimals = 12;
+
+    //! sign + 20 integer digits + '.' + 12 decimals
+    constexpr int bufferSize = 40;
+
+    enum Sign {
+        NoSign = 0,
+        Minus,     // '-' for negative amounts
+        PlusMinus  // '+' or '-'
+    };
+
+    //! writes amount into buf (at least bufferSize chars, not null terminated), returns the number of chars written
+    int format(char *buf, quint64 amount, int decimals = maxDecimals, bool trailingZeroes = true, char sign = 0);
+
+    QString toString(quint64 amount, int decimals = maxDecimals, bool trailingZeroes = true);
+    QString toString(qint64 amount, int decimals, bool trailingZeroes, Sign sign);
+}
+
+#endif //FEATHER_AMOUNTFORMATTER_H
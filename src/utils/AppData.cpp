@@ -11,8 +11,6 @@
 AppData::AppData(QObject *parent)
     : QObject(parent)
 {
-    this->initRestoreHeights();
-
     connect(websocketNotifier(), &WebsocketNotifier::CryptoRatesReceived, &this->prices, &Prices::cryptoPricesReceived);
     connect(websocketNotifier(), &WebsocketNotifier::FiatRatesReceived, &this->prices, &Prices::fiatPricesReceived);
     connect(websocketNotifier(), &WebsocketNotifier::BlockHeightsReceived, this, &AppData::onBlockHeightsReceived);
@@ -25,12 +23,6 @@ void AppData::onBlockHeightsReceived(int mainnet, int stagenet) {
     this->heights[NetworkType::STAGENET] = stagenet;
 }
 
-void AppData::initRestoreHeights() {
-    restoreHeights[NetworkType::TESTNET] = new RestoreHeightLookup(NetworkType::TESTNET);
-    restoreHeights[NetworkType::STAGENET] = RestoreHeightLookup::fromFile(":/assets/restore_heights_monero_stagenet.txt", NetworkType::STAGENET);
-    restoreHeights[NetworkType::MAINNET] = RestoreHeightLookup::fromFile(":/assets/restore_heights_monero_mainnet.txt", NetworkType::MAINNET);
-}
-
 AppData* AppData::instance()
 {
     if (!m_instance) {
@@ -7,8 +7,8 @@
 #include <QObject>
 #include <QPointer>
 
+#include "networktype.h"
 #include "prices.h"
-#include "RestoreHeightLookup.h"
 
 class AppData : public QObject {
 Q_OBJECT
@@ -19,14 +19,11 @@ public:
 
     Prices prices;
     QMap<NetworkType::Type, int> heights;
-    QMap<NetworkType::Type, RestoreHeightLookup*> restoreHeights;
 
 private slots:
     void onBlockHeightsReceived(int mainnet, int stagenet);
 
 private:
-    void initRestoreHeights();
-
     static QPointer<AppData> m_instance;
 };
 
@@ -0,0 +1,653 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "BlockCacheProxy.h"
+
+#include <QAuthenticator>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QNetworkProxy>
+#include <QNetworkReply>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSslConfiguration>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+
+#include "constants.h"
+#include "utils/config.h"
+#include "utils/Utils.h"
+
+#include "rpc/core_rpc_server_commands_defs.h"
+#include "storages/portable_storage_template_helper.h"
+
+namespace {
+    // Blocks this far below the daemon height are treated as final and may be cached
+    constexpr quint64 finalityDepth = 30;
+
+    constexpr int maxRequestSize = 16 * 1024 * 1024;
+    constexpr int transferTimeout = 3 * 60 * 1000;
+
+    bool isGetBlocks(const QByteArray &path) {
+        return path == "/getblocks.bin" || path == "/get_blocks.bin";
+    }
+
+    bool isGetHashes(const QByteArray &path) {
+        return path == "/gethashes.bin" || path == "/get_hashes.bin";
+    }
+
+    template<typename T>
+    bool fromBinary(const QByteArray &data, T &out) {
+        try {
+            return epee::serialization::load_t_from_binary(out, epee::span<const uint8_t>(reinterpret_cast<const uint8_t*>(data.constData()), data.size()));
+        }
+        catch (const std::exception &) {
+            return false;
+        }
+    }
+
+    template<typename T>
+    QByteArray toBinary(T &in) {
+        epee::byte_slice buffer = epee::serialization::store_t_to_binary(in);
+        return {reinterpret_cast<const char*>(buffer.data()), static_cast<qsizetype>(buffer.size())};
+    }
+
+    QByteArray randomHex(int bytes) {
+        QByteArray data(bytes, Qt::Uninitialized);
+        QRandomGenerator::system()->fillRange(reinterpret_cast<quint32*>(data.data()), bytes / sizeof(quint32));
+        return data.toHex();
+    }
+
+    QByteArray md5Hex(const QByteArray &data) {
+        return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+    }
+
+    constexpr char realm[] = "feather-block-cache";
+}
+
+QPointer<BlockCacheProxy> BlockCacheProxy::m_instance(nullptr);
+
+BlockCacheProxy::BlockCacheProxy(QObject *parent)
+    : QObject(parent)
+{
+    QString netType = Utils::QtEnumToString(constants::networkType).toLower();
+    m_cacheDir = QDir(Config::defaultConfigDir().filePath(QString("blocks/%1").arg(netType)));
+    m_cacheLimit = conf()->get(Config::blockCacheSize).toLongLong() * 1024 * 1024;
+    m_password = QString::fromLatin1(randomHex(16));
+}
+
+BlockCacheProxy::~BlockCacheProxy() {
+    while (!m_upstreams.isEmpty()) {
+        this->close(m_upstreams.first());
+    }
+}
+
+BlockCacheProxy::Route BlockCacheProxy::route(const QString &daemonAddress, bool useSSL, const QString &socksProxy,
+                                              const QString &daemonUsername, const QString &daemonPassword) {
+    quint16 port = 0;
+    auto listen = [this, &port, daemonAddress, useSSL, socksProxy, daemonUsername, daemonPassword]{
+        Upstream *upstream = this->listen(daemonAddress, useSSL, socksProxy, daemonUsername, daemonPassword);
+        if (upstream) {
+            upstream->routes++;
+            port = upstream->server->serverPort();
+        }
+    };
+
+    if (QThread::currentThread() == this->thread()) {
+        listen();
+    } else {
+        QMetaObject::invokeMethod(this, listen, Qt::BlockingQueuedConnection);
+    }
+
+    if (port == 0) {
+        return {};
+    }
+    return {QString("127.0.0.1:%1").arg(port), m_username, m_password};
+}
+
+BlockCacheProxy::CacheHits BlockCacheProxy::cacheHits(const QString &address) const {
+    QMutexLocker locker(&m_hitsMutex);
+    return m_hits.value(address);
+}
+
+void BlockCacheProxy::release(const QString &address) {
+    QMetaObject::invokeMethod(this, [this, address]{
+        for (auto *upstream : m_upstreams) {
+            if (routeAddress(upstream) != address) {
+                continue;
+            }
+            if (--upstream->routes <= 0) {
+                qInfo() << "Block cache: closing route to" << upstream->address;
+                this->close(upstream);
+            }
+            return;
+        }
+    });
+}
+
+BlockCacheProxy::Upstream* BlockCacheProxy::listen(const QString &daemonAddress, bool useSSL, const QString &socksProxy,
+                                                   const QString &daemonUsername, const QString &daemonPassword) {
+    if (!m_cacheLoaded) {
+        this->loadCache();
+    }
+
+    for (auto *upstream : m_upstreams) {
+        if (upstream->address == daemonAddress && upstream->socksProxy == socksProxy && upstream->sslRequested == useSSL
+                && upstream->username == daemonUsername && upstream->password == daemonPassword) {
+            return upstream;
+        }
+    }
+
+    auto *upstream = new Upstream;
+    upstream->address = daemonAddress;
+    upstream->socksProxy = socksProxy;
+    upstream->username = daemonUsername;
+    upstream->password = daemonPassword;
+    upstream->sslRequested = useSSL;
+    upstream->ssl = useSSL;
+    upstream->sslChecked = !useSSL;
+    upstream->nonce = randomHex(16);
+    upstream->server = new QTcpServer(this);
+    upstream->network = new QNetworkAccessManager(this);
+
+    // The node's login, wallets authenticate with the proxy's
+    connect(upstream->network, &QNetworkAccessManager::authenticationRequired, this, [upstream](QNetworkReply *, QAuthenticator *authenticator){
+        if (!upstream->username.isEmpty()) {
+            authenticator->setUser(upstream->username);
+            authenticator->setPassword(upstream->password);
+        }
+    });
+
+    if (!socksProxy.isEmpty()) {
+        QStringList hostPort = socksProxy.split(":");
+        if (hostPort.length() == 2) {
+            upstream->network->setProxy(QNetworkProxy(QNetworkProxy::Socks5Proxy, hostPort[0], hostPort[1].toUShort()));
+        }
+    }
+
+    if (!upstream->server->listen(QHostAddress::LocalHost, 0)) {
+        qWarning() << "Block cache: unable to listen on loopback:" << upstream->server->errorString();
+        upstream->server->deleteLater();
+        upstream->network->deleteLater();
+        delete upstream;
+        return nullptr;
+    }
+
+    connect(upstream->server, &QTcpServer::newConnection, this, [this, upstream]{
+        upstream->clients.removeAll(nullptr);
+        while (QTcpSocket *socket = upstream->server->nextPendingConnection()) {
+            upstream->clients.append(socket);
+            connect(socket, &QTcpSocket::readyRead, this, [this, upstream, socket]{
+                if (m_upstreams.contains(upstream)) {
+                    this->onReadyRead(upstream, socket);
+                }
+            });
+            connect(socket, &QTcpSocket::disconnected, this, [this, socket]{
+                m_buffers.remove(socket);
+                socket->deleteLater();
+            });
+        }
+    });
+
+    m_upstreams.append(upstream);
+    qInfo() << "Block cache: routing" << daemonAddress << "through port" << upstream->server->serverPort();
+    return upstream;
+}
+
+void BlockCacheProxy::close(Upstream *upstream) {
+    // Callbacks of requests still in flight check for this and drop their response
+    m_upstreams.removeOne(upstream);
+    {
+        QMutexLocker locker(&m_hitsMutex);
+        m_hits.remove(routeAddress(upstream));
+    }
+
+    upstream->server->close();
+    upstream->server->deleteLater();
+
+    for (const auto &client : upstream->clients) {
+        if (client) {
+            m_buffers.remove(client);
+            client->abort();
+            client->deleteLater();
+        }
+    }
+
+    delete upstream->network;
+    delete upstream;
+}
+
+bool BlockCacheProxy::isAuthorized(const Upstream *upstream, const Request &request) const {
+    if (!request.authorization.startsWith("Digest ")) {
+        return false;
+    }
+
+    QHash<QByteArray, QByteArray> params;
+    static const QRegularExpression rx(R"((\w+)=(?:"([^"]*)"|([^,\s]*)))");
+    auto it = rx.globalMatch(QString::fromLatin1(request.authorization.mid(7)));
+    while (it.hasNext()) {
+        auto match = it.next();
+        params[match.captured(1).toLower().toLatin1()] = (match.capturedLength(2) > 0 ? match.captured(2) : match.captured(3)).toLatin1();
+    }
+
+    if (params.value("username") != m_username.toLatin1() || params.value("realm") != realm || params.value("nonce") != upstream->nonce) {
+        return false;
+    }
+
+    QByteArray ha1 = md5Hex(m_username.toLatin1() + ":" + realm + ":" + m_password.toLatin1());
+    if (params.value("algorithm").toLower() == "md5-sess") {
+        ha1 = md5Hex(ha1 + ":" + upstream->nonce + ":" + params.value("cnonce"));
+    }
+    const QByteArray ha2 = md5Hex(request.method + ":" + params.value("uri"));
+
+    QByteArray expected;
+    if (params.contains("qop")) {
+        expected = md5Hex(ha1 + ":" + upstream->nonce + ":" + params.value("nc") + ":" + params.value("cnonce") + ":" + params.value("qop") + ":" + ha2);
+    } else {
+        expected = md5Hex(ha1 + ":" + upstream->nonce + ":" + ha2);
+    }
+    return params.value("response").toLower() == expected;
+}
+
+void BlockCacheProxy::onReadyRead(Upstream *upstream, QTcpSocket *socket) {
+    QByteArray &buffer = m_buffers[socket];
+    buffer += socket->readAll();
+
+    // wallet2 keeps connections alive and sends one request at a time, but don't rely on it
+    while (true) {
+        int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            if (buffer.size() > maxRequestSize) {
+                socket->abort();
+            }
+            return;
+        }
+
+        QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+        if (requestLine.length() < 2) {
+            socket->abort();
+            return;
+        }
+
+        Request request;
+        request.method = requestLine[0];
+        request.path = requestLine[1];
+
+        qint64 contentLength = 0;
+        for (const auto &line : lines) {
+            int sep = line.indexOf(':');
+            if (sep < 0) {
+                continue;
+            }
+            QByteArray name = line.left(sep).trimmed().toLower();
+            QByteArray value = line.mid(sep + 1).trimmed();
+            if (name == "content-length") {
+                contentLength = value.toLongLong();
+            } else if (name == "content-type") {
+                request.contentType = value;
+            } else if (name == "authorization") {
+                request.authorization = value;
+            }
+        }
+
+        if (contentLength < 0 || contentLength > maxRequestSize) {
+            socket->abort();
+            return;
+        }
+
+        qint64 requestSize = headerEnd + 4 + contentLength;
+        if (buffer.size() < requestSize) {
+            return;
+        }
+
+        request.body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, requestSize);
+
+        this->handleRequest(upstream, socket, request);
+    }
+}
+
+void BlockCacheProxy::handleRequest(Upstream *upstream, QTcpSocket *socket, const Request &request) {
+    if (!this->isAuthorized(upstream, request)) {
+        Response response;
+        response.status = 401;
+        response.reason = "Unauthorized";
+        response.wwwAuthenticate = QString(R"(Digest realm="%1", nonce="%2", qop="auth", algorithm=MD5)")
+                .arg(QString::fromLatin1(realm), QString::fromLatin1(upstream->nonce)).toLatin1();
+        reply(socket, response);
+        return;
+    }
+
+    QByteArray key = cacheKey(upstream, request);
+    if (key.isEmpty()) {
+        QPointer<QTcpSocket> client = socket;
+        QByteArray path = request.path;
+        this->forward(upstream, request, [upstream, client, path](const Response &response){
+            if (response.status == 200 && isGetBlocks(path)) {
+                inspectResponse(upstream, path, response.body);
+            }
+            if (client) {
+                reply(client, response);
+            }
+        });
+        return;
+    }
+
+    QByteArray cached = this->cacheGet(key);
+    if (!cached.isEmpty()) {
+        Response response;
+        response.status = 200;
+        response.reason = "OK";
+        response.contentType = "application/octet-stream";
+        quint64 blocks = 0;
+        response.body = withCurrentHeight(upstream, request.path, cached, blocks);
+        this->countHit(upstream, response.body.size(), blocks);
+        reply(socket, response);
+        return;
+    }
+
+    // Another wallet is already fetching these blocks, wait for its response
+    if (upstream->inflight.contains(key)) {
+        upstream->inflight[key].append(socket);
+        return;
+    }
+    upstream->inflight[key] = {socket};
+
+    QByteArray path = request.path;
+    this->forward(upstream, request, [this, upstream, key, path](const Response &response){
+        quint64 blocks = 0;
+        if (response.status == 200 && inspectResponse(upstream, path, response.body, &blocks)) {
+            this->cachePut(key, response.body);
+        }
+
+        // Only the first of them was fetched from the node
+        const auto clients = upstream->inflight.take(key);
+        for (qsizetype i = 0; i < clients.size(); i++) {
+            if (!clients[i]) {
+                continue;
+            }
+            if (i > 0 && response.status == 200) {
+                this->countHit(upstream, response.body.size(), blocks);
+            }
+            reply(clients[i], response);
+        }
+    });
+}
+
+void BlockCacheProxy::forward(Upstream *upstream, const Request &request, const std::function<void(const Response &)> &callback) {
+    QUrl url(QString("%1://%2%3").arg(upstream->ssl ? "https" : "http", upstream->address, QString::fromUtf8(request.path)));
+
+    QNetworkRequest networkRequest(url);
+    networkRequest.setTransferTimeout(transferTimeout);
+    networkRequest.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
+    if (!request.contentType.isEmpty()) {
+        networkRequest.setRawHeader("Content-Type", request.contentType);
+    }
+    if (upstream->ssl) {
+        // wallet2 does not verify daemon certificates either
+        QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+        sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
+        networkRequest.setSslConfiguration(sslConfig);
+    }
+
+    QNetworkReply *reply = upstream->network->sendCustomRequest(networkRequest, request.method, request.body);
+    connect(reply, &QNetworkReply::finished, this, [this, upstream, request, callback, reply]{
+        if (!m_upstreams.contains(upstream)) {
+            // Closed, the reply goes away with the upstream's network manager
+            return;
+        }
+        reply->deleteLater();
+
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        // Like wallet2's autodetect, only a node that doesn't speak TLS gets plaintext. Timeouts and refused
+        // connections say nothing about TLS, they are passed on and the next request tries TLS again.
+        if (reply->error() == QNetworkReply::SslHandshakeFailedError && upstream->ssl && !upstream->sslChecked) {
+            qWarning() << "Block cache: TLS handshake with" << upstream->address << "failed, falling back to plaintext";
+            upstream->ssl = false;
+            upstream->sslChecked = true;
+            this->forward(upstream, request, callback);
+            return;
+        }
+        if (status != 0) {
+            upstream->sslChecked = true;
+        }
+
+        Response response;
+        if (status != 0) {
+            response.status = status;
+            response.reason = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray();
+            response.contentType = reply->rawHeader("Content-Type");
+            response.body = reply->readAll();
+        }
+
+        callback(response);
+    });
+}
+
+void BlockCacheProxy::reply(QTcpSocket *socket, const Response &response) {
+    QByteArray header = QString("HTTP/1.1 %1 %2\r\n").arg(response.status).arg(QString::fromUtf8(response.reason)).toUtf8();
+    if (!response.contentType.isEmpty()) {
+        header += "Content-Type: " + response.contentType + "\r\n";
+    }
+    if (!response.wwwAuthenticate.isEmpty()) {
+        header += "WWW-Authenticate: " + response.wwwAuthenticate + "\r\n";
+    }
+    header += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    header += "Connection: keep-alive\r\n\r\n";
+
+    socket->write(header);
+    socket->write(response.body);
+}
+
+QByteArray BlockCacheProxy::cacheKey(const Upstream *upstream, const Request &request) {
+    // The daemon answers from the first block it has in common with the wallet's chain history, which is the
+    // wallet's top block in the normal case. Two wallets at the same height get the same answer, even if the
+    // rest of their history differs because they were restored from different heights.
+    // Other nodes may follow another chain, so answers are only shared between wallets using the same node.
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(upstream->address.toUtf8());
+
+    if (isGetBlocks(request.path)) {
+        cryptonote::COMMAND_RPC_GET_BLOCKS_FAST::request req;
+        if (!fromBinary(request.body, req) || req.block_ids.empty()) {
+            return {};
+        }
+        // Pool updates are never cacheable
+        if (req.requested_info != cryptonote::COMMAND_RPC_GET_BLOCKS_FAST::BLOCKS_ONLY) {
+            return {};
+        }
+
+        hash.addData("getblocks");
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(&req.block_ids.front()), sizeof(crypto::hash)));
+        hash.addData(QByteArray::number(static_cast<quint64>(req.start_height)));
+        hash.addData(req.prune ? "p" : "-");
+        hash.addData(req.no_miner_tx ? "n" : "-");
+        return hash.result().toHex();
+    }
+
+    if (isGetHashes(request.path)) {
+        cryptonote::COMMAND_RPC_GET_HASHES_FAST::request req;
+        if (!fromBinary(request.body, req) || req.block_ids.empty()) {
+            return {};
+        }
+
+        hash.addData("gethashes");
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(&req.block_ids.front()), sizeof(crypto::hash)));
+        hash.addData(QByteArray::number(static_cast<quint64>(req.start_height)));
+        return hash.result().toHex();
+    }
+
+    return {};
+}
+
+bool BlockCacheProxy::inspectResponse(Upstream *upstream, const QByteArray &path, const QByteArray &body, quint64 *blocks) {
+    quint64 startHeight = 0;
+    quint64 count = 0;
+    quint64 currentHeight = 0;
+
+    if (isGetBlocks(path)) {
+        cryptonote::COMMAND_RPC_GET_BLOCKS_FAST::response res;
+        if (!fromBinary(body, res) || res.status != CORE_RPC_STATUS_OK) {
+            return false;
+        }
+        startHeight = res.start_height;
+        count = res.blocks.size();
+        currentHeight = res.current_height;
+    }
+    else if (isGetHashes(path)) {
+        cryptonote::COMMAND_RPC_GET_HASHES_FAST::response res;
+        if (!fromBinary(body, res) || res.status != CORE_RPC_STATUS_OK) {
+            return false;
+        }
+        startHeight = res.start_height;
+        count = res.m_block_ids.size();
+        currentHeight = res.current_height;
+    }
+
+    upstream->tipHeight = std::max(upstream->tipHeight, currentHeight);
+    if (blocks) {
+        *blocks = count;
+    }
+    return count > 0 && startHeight + count + finalityDepth <= currentHeight;
+}
+
+QByteArray BlockCacheProxy::withCurrentHeight(const Upstream *upstream, const QByteArray &path, const QByteArray &body, quint64 &blocks) {
+    // A cached response carries the daemon height from when it was fetched, report the latest height the node told us
+    const quint64 tipHeight = upstream->tipHeight;
+    if (isGetBlocks(path)) {
+        cryptonote::COMMAND_RPC_GET_BLOCKS_FAST::response res;
+        if (fromBinary(body, res)) {
+            blocks = res.blocks.size();
+            if (res.current_height < tipHeight) {
+                res.current_height = tipHeight;
+                return toBinary(res);
+            }
+        }
+    }
+    else if (isGetHashes(path)) {
+        cryptonote::COMMAND_RPC_GET_HASHES_FAST::response res;
+        if (fromBinary(body, res)) {
+            blocks = res.m_block_ids.size();
+            if (res.current_height < tipHeight) {
+                res.current_height = tipHeight;
+                return toBinary(res);
+            }
+        }
+    }
+    return body;
+}
+
+void BlockCacheProxy::countHit(const Upstream *upstream, qsizetype bytes, quint64 blocks) {
+    QMutexLocker locker(&m_hitsMutex);
+    CacheHits &hits = m_hits[routeAddress(upstream)];
+    hits.bytes += static_cast<quint64>(bytes);
+    hits.blocks += blocks;
+}
+
+QString BlockCacheProxy::routeAddress(const Upstream *upstream) {
+    return QString("127.0.0.1:%1").arg(upstream->server->serverPort());
+}
+
+void BlockCacheProxy::loadCache() {
+    m_cacheLoaded = true;
+
+    if (!m_cacheDir.mkpath(".")) {
+        qWarning() << "Block cache: unable to create" << m_cacheDir.path();
+        return;
+    }
+
+    for (const auto &fileInfo : m_cacheDir.entryInfoList({"*.bin"}, QDir::Files)) {
+        QByteArray key = fileInfo.completeBaseName().toUtf8();
+        m_cacheEntries[key] = {fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch()};
+        m_cacheSize += fileInfo.size();
+    }
+
+    this->evict();
+}
+
+QByteArray BlockCacheProxy::cacheGet(const QByteArray &key) {
+    auto it = m_cacheEntries.find(key);
+    if (it == m_cacheEntries.end()) {
+        return {};
+    }
+
+    QFile file(m_cacheDir.filePath(QString("%1.bin").arg(QString::fromUtf8(key))));
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_cacheSize -= it->size;
+        m_cacheEntries.erase(it);
+        return {};
+    }
+
+    it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+    return file.readAll();
+}
+
+void BlockCacheProxy::cachePut(const QByteArray &key, const QByteArray &data) {
+    if (m_cacheLimit <= 0 || data.size() > m_cacheLimit) {
+        return;
+    }
+
+    QSaveFile file(m_cacheDir.filePath(QString("%1.bin").arg(QString::fromUtf8(key))));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "Block cache: unable to write" << file.fileName();
+        return;
+    }
+
+    if (m_cacheEntries.contains(key)) {
+        m_cacheSize -= m_cacheEntries[key].size;
+    }
+    m_cacheEntries[key] = {data.size(), QDateTime::currentMSecsSinceEpoch()};
+    m_cacheSize += data.size();
+
+    this->evict();
+}
+
+void BlockCacheProxy::evict() {
+    if (m_cacheSize <= m_cacheLimit) {
+        return;
+    }
+
+    // Least recently used first
+    QList<QByteArray> keys = m_cacheEntries.keys();
+    std::sort(keys.begin(), keys.end(), [this](const QByteArray &a, const QByteArray &b){
+        return m_cacheEntries[a].lastUsed < m_cacheEntries[b].lastUsed;
+    });
+
+    for (const auto &key : keys) {
+        if (m_cacheSize <= m_cacheLimit) {
+            break;
+        }
+        QFile::remove(m_cacheDir.filePath(QString("%1.bin").arg(QString::fromUtf8(key))));
+        m_cacheSize -= m_cacheEntries.take(key).size;
+    }
+}
+
+bool BlockCacheProxy::isRunning() {
+    return m_instance && m_instance->thread()->isRunning();
+}
+
+BlockCacheProxy* BlockCacheProxy::instance()
+{
+    if (!m_instance) {
+        auto *thread = new QThread(QCoreApplication::instance());
+        thread->setObjectName("BlockCacheProxy");
+
+        m_instance = new BlockCacheProxy();
+        m_instance->moveToThread(thread);
+
+        connect(thread, &QThread::finished, m_instance, &QObject::deleteLater);
+        connect(qApp, &QCoreApplication::aboutToQuit, thread, [thread]{
+            thread->quit();
+            thread->wait();
+        });
+
+        thread->start();
+    }
+
+    return m_instance;
+}
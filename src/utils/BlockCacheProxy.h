@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_BLOCKCACHEPROXY_H
+#define FEATHER_BLOCKCACHEPROXY_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+
+#include <functional>
+
+class QNetworkAccessManager;
+class QTcpServer;
+class QTcpSocket;
+
+// Loopback RPC proxy shared by all open wallets.
+//
+// Every daemon a wallet connects to gets a listener on 127.0.0.1 that forwards requests unchanged, except for
+// getblocks.bin and gethashes.bin. Those are served from a bounded on-disk cache once the blocks they return are
+// buried deep enough to be final, and identical requests that are in flight share a single upstream fetch.
+//
+// Cached responses belong to the node they were fetched from and are only served to wallets using that node, so
+// nodes on different chains or forks never mix. Daemon heights are tracked per node as well.
+//
+// Listeners require digest authentication with credentials that only this process knows, so other local processes
+// can't use them to reach the node. The node's own login is handled by the proxy.
+//
+// The proxy runs on its own thread, so wallet refresh threads are never blocked on the GUI event loop.
+class BlockCacheProxy : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~BlockCacheProxy() override;
+
+    static BlockCacheProxy* instance();
+    static bool isRunning();
+
+    struct Route {
+        QString address;  // empty if the proxy is unavailable
+        QString username;
+        QString password;
+    };
+
+    //! returns a loopback address that forwards to daemonAddress and the login the wallet has to use for it.
+    //! Every route has to be given back with release().
+    Route route(const QString &daemonAddress, bool useSSL, const QString &socksProxy,
+                const QString &daemonUsername, const QString &daemonPassword);
+    //! the listener of the route closes once no wallet uses it anymore
+    void release(const QString &address);
+
+    struct CacheHits {
+        quint64 bytes = 0;
+        quint64 blocks = 0;
+    };
+
+    //! what the route served without fetching it from the node, since it was opened. Thread-safe.
+    CacheHits cacheHits(const QString &address) const;
+
+private:
+    explicit BlockCacheProxy(QObject *parent = nullptr);
+
+    struct Upstream {
+        QString address;
+        QString socksProxy;
+        QString username;
+        QString password;
+        bool sslRequested = false;
+        bool ssl = false;          // try TLS first, plaintext only after a failed handshake, like wallet2's autodetect
+        bool sslChecked = false;   // a request got an HTTP response, the choice is final
+        int routes = 0;
+        quint64 tipHeight = 0;
+        QByteArray nonce;
+        QTcpServer *server = nullptr;
+        QNetworkAccessManager *network = nullptr;
+        QList<QPointer<QTcpSocket>> clients;
+        QHash<QByteArray, QList<QPointer<QTcpSocket>>> inflight;
+    };
+
+    struct Request {
+        QByteArray method;
+        QByteArray path;
+        QByteArray contentType;
+        QByteArray authorization;
+        QByteArray body;
+    };
+
+    struct Response {
+        int status = 502;
+        QByteArray reason = "Bad Gateway";
+        QByteArray contentType;
+        QByteArray wwwAuthenticate;
+        QByteArray body;
+    };
+
+    struct CacheEntry {
+        qint64 size;
+        qint64 lastUsed;
+    };
+
+    Upstream* listen(const QString &daemonAddress, bool useSSL, const QString &socksProxy,
+                     const QString &daemonUsername, const QString &daemonPassword);
+    void close(Upstream *upstream);
+    bool isAuthorized(const Upstream *upstream, const Request &request) const;
+    void onReadyRead(Upstream *upstream, QTcpSocket *socket);
+    void handleRequest(Upstream *upstream, QTcpSocket *socket, const Request &request);
+    void forward(Upstream *upstream, const Request &request, const std::function<void(const Response &)> &callback);
+    static void reply(QTcpSocket *socket, const Response &response);
+    void countHit(const Upstream *upstream, qsizetype bytes, quint64 blocks);
+    static QString routeAddress(const Upstream *upstream);
+
+    static QByteArray cacheKey(const Upstream *upstream, const Request &request);
+    //! records the daemon height of the upstream and returns true if the response only contains final blocks
+    static bool inspectResponse(Upstream *upstream, const QByteArray &path, const QByteArray &body, quint64 *blocks = nullptr);
+    static QByteArray withCurrentHeight(const Upstream *upstream, const QByteArray &path, const QByteArray &body, quint64 &blocks);
+
+    void loadCache();
+    QByteArray cacheGet(const QByteArray &key);
+    void cachePut(const QByteArray &key, const QByteArray &data);
+    void evict();
+
+    static QPointer<BlockCacheProxy> m_instance;
+
+    QList<Upstream*> m_upstreams;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+
+    // Per route address, read by SyncTelemetry so the node isn't credited for these
+    mutable QMutex m_hitsMutex;
+    QHash<QString, CacheHits> m_hits;
+
+    // Login wallets use for the listeners
+    QString m_username = "feather";
+    QString m_password;
+
+    QDir m_cacheDir;
+    bool m_cacheLoaded = false;
+    QHash<QByteArray, CacheEntry> m_cacheEntries;
+    qint64 m_cacheSize = 0;
+    qint64 m_cacheLimit = 0;
+};
+
+inline BlockCacheProxy* blockCacheProxy()
+{
+    return BlockCacheProxy::instance();
+}
+
+#endif //FEATHER_BLOCKCACHEPROXY_H
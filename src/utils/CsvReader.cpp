@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "CsvReader.h"
+
+CsvReader::CsvReader(QIODevice *device)
+    : m_stream(device)
+{
+}
+
+bool CsvReader::readRecord(QStringList &fields) {
+    fields.clear();
+    if (!m_errorString.isEmpty()) {
+        return false;
+    }
+
+    QString field;
+    bool inQuotes = false;
+    QString line;
+
+    while (m_stream.readLineInto(&line)) {
+        m_line++;
+
+        if (!inQuotes) {
+            if (line.trimmed().isEmpty()) {
+                continue;
+            }
+            m_recordLine = m_line;
+        } else {
+            // The quoted field continues on this line
+            field.append('\n');
+        }
+
+        for (qsizetype i = 0; i < line.length(); ++i) {
+            const QChar c = line[i];
+
+            if (c == '"') {
+                if (inQuotes && i + 1 < line.length() && line[i + 1] == '"') {
+                    field.append('"');
+                    ++i;
+                } else {
+                    inQuotes = !inQuotes;
+                }
+            } else if (c == ',' && !inQuotes) {
+                fields.append(field.trimmed());
+                field.clear();
+            } else {
+                field.append(c);
+            }
+        }
+
+        if (!inQuotes) {
+            fields.append(field.trimmed());
+            return true;
+        }
+    }
+
+    if (inQuotes) {
+        m_errorString = QString("Unterminated quoted field starting on line %1").arg(m_recordLine);
+        fields.clear();
+    }
+    return false;
+}
+
+qint64 CsvReader::lineNumber() const {
+    return m_recordLine;
+}
+
+bool CsvReader::hasError() const {
+    return !m_errorString.isEmpty();
+}
+
+QString CsvReader::errorString() const {
+    return m_errorString;
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_CSVREADER_H
+#define FEATHER_CSVREADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+class QIODevice;
+
+// Reads a CSV file one record at a time, so files of any size are read in constant memory.
+//
+// Fields may be quoted, a quoted field can contain commas, line breaks and "" for a quote. Whitespace around
+// fields is dropped, blank lines are skipped.
+class CsvReader
+{
+public:
+    explicit CsvReader(QIODevice *device);
+
+    //! reads the next record into fields, returns false at the end of the input or on error
+    bool readRecord(QStringList &fields);
+
+    //! line the last record started on, 1-based
+    qint64 lineNumber() const;
+
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    QTextStream m_stream;
+    qint64 m_line = 0;
+    qint64 m_recordLine = 0;
+    QString m_errorString;
+};
+
+#endif //FEATHER_CSVREADER_H
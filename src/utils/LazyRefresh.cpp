@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "LazyRefresh.h"
+
+#include <QEvent>
+#include <QWidget>
+
+#include "utils/Metrics.h"
+
+LazyRefresh::LazyRefresh(std::function<void()> refresh, QObject *parent)
+    : QObject(parent)
+    , m_refresh(std::move(refresh))
+{
+}
+
+void LazyRefresh::attachView(QWidget *view) {
+    view->installEventFilter(this);
+    if (view->isVisible()) {
+        m_visibleViews.insert(view);
+    }
+
+    connect(view, &QObject::destroyed, this, [this](QObject *obj){
+        m_visibleViews.remove(obj);
+    });
+}
+
+void LazyRefresh::request() {
+    if (m_visibleViews.isEmpty()) {
+        static Metrics::Gauge *deferred = Metrics::gauge("models.deferredRefreshes");
+        deferred->increment();
+        m_stale = true;
+        return;
+    }
+
+    m_stale = false;
+    m_refresh();
+}
+
+void LazyRefresh::flush() {
+    if (!m_stale) {
+        return;
+    }
+
+    m_stale = false;
+    m_refresh();
+}
+
+void LazyRefresh::markFresh() {
+    m_stale = false;
+}
+
+bool LazyRefresh::isStale() const {
+    return m_stale;
+}
+
+bool LazyRefresh::eventFilter(QObject *obj, QEvent *event) {
+    if (event->type() == QEvent::Show) {
+        m_visibleViews.insert(obj);
+        this->flush();
+    }
+    else if (event->type() == QEvent::Hide) {
+        m_visibleViews.remove(obj);
+    }
+
+    return QObject::eventFilter(obj, event);
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_LAZYREFRESH_H
+#define FEATHER_LAZYREFRESH_H
+
+#include <QObject>
+#include <QSet>
+
+#include <functional>
+
+class QWidget;
+
+// Defers refreshes of a model while none of the views attached to it are visible.
+//
+// A view counts as visible between its show and hide events, so views on hidden tabs, disabled tabs and minimized
+// windows don't cause any work. A deferred refresh runs once, when the first view is shown again.
+class LazyRefresh : public QObject
+{
+    Q_OBJECT
+
+public:
+    LazyRefresh(std::function<void()> refresh, QObject *parent = nullptr);
+
+    void attachView(QWidget *view);
+
+    //! refreshes now if a view is visible, otherwise marks the model stale
+    void request();
+    //! runs a deferred refresh, for readers that don't go through a view
+    void flush();
+    //! called by the model after it refreshed for another reason
+    void markFresh();
+
+    bool isStale() const;
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+    std::function<void()> m_refresh;
+    QSet<QObject*> m_visibleViews;
+    bool m_stale = false;
+};
+
+#endif //FEATHER_LAZYREFRESH_H
@@ -0,0 +1,494 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "Logger.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+Q_LOGGING_CATEGORY(lcWallet, "feather.wallet", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcHistory, "feather.history", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcNetwork, "feather.network", QtInfoMsg)
+
+namespace Logger
+{
+namespace {
+    struct Entry {
+        quint64 seq = 0;
+        qint64 msecs = 0;
+        QtMsgType type = QtDebugMsg;
+        const char *category = nullptr;  // category names and function names are string literals
+        const char *function = nullptr;
+        int line = 0;
+        QString msg;
+    };
+
+    // Written only by the thread that owns it, read only by whoever holds Writer::drainMutex
+    class Ring
+    {
+    public:
+        static constexpr size_t capacity = 1024;
+
+        bool push(Entry &&entry) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= capacity) {
+                return false;
+            }
+            m_slots[head & (capacity - 1)] = std::move(entry);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename F>
+        void drain(F &&f) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                f(std::move(m_slots[tail & (capacity - 1)]));
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        bool empty() const {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+        }
+
+        std::atomic<bool> orphaned{false};
+
+    private:
+        std::array<Entry, capacity> m_slots;
+        alignas(64) std::atomic<size_t> m_head{0};
+        alignas(64) std::atomic<size_t> m_tail{0};
+    };
+
+    struct Bucket {
+        double tokens = 0;
+        qint64 lastMs = 0;
+        quint64 suppressed = 0;
+    };
+
+    struct Writer {
+        std::mutex registryMutex;
+        std::vector<std::shared_ptr<Ring>> rings;
+
+        // Single consumer of the rings, also guards everything below it
+        std::mutex drainMutex;
+        std::vector<Entry> batch;
+        qint64 cachedSecond = -1;
+        QByteArray cachedDate;
+        QHash<quint64, Bucket> buckets;
+        int perSecond = 20;
+        int burst = 200;
+
+        QString filePath;
+        qint64 maxFileSize = 0;
+        int maxFiles = 0;
+        std::unique_ptr<QFile> file;
+        qint64 fileSize = 0;
+
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        bool wakeRequested = false;
+
+        std::thread thread;
+        std::atomic<bool> running{false};
+        std::atomic<quint64> seq{0};
+        std::atomic<quint64> dropped{0};
+    };
+
+    // Intentionally leaked, messages may still arrive during static destruction
+    Writer &writer() {
+        static auto *w = new Writer;
+        return *w;
+    }
+
+    thread_local bool t_inDrain = false;
+
+    struct LocalRing {
+        std::shared_ptr<Ring> ring;
+        ~LocalRing() {
+            if (ring) {
+                ring->orphaned.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    Ring *localRing() {
+        thread_local LocalRing local;
+        if (!local.ring) {
+            local.ring = std::make_shared<Ring>();
+            Writer &w = writer();
+            std::lock_guard<std::mutex> lock(w.registryMutex);
+            w.rings.push_back(local.ring);
+        }
+        return local.ring.get();
+    }
+
+    char typeTag(QtMsgType type) {
+        switch (type) {
+            case QtDebugMsg: return 'D';
+            case QtInfoMsg: return 'I';
+            case QtWarningMsg: return 'W';
+            case QtCriticalMsg: return 'C';
+            case QtFatalMsg: return 'F';
+        }
+        return '?';
+    }
+
+    // Debug, critical and fatal go to stderr, info and warnings to stdout
+    bool toStderr(QtMsgType type) {
+        return type == QtDebugMsg || type == QtCriticalMsg || type == QtFatalMsg;
+    }
+
+    void appendLine(Writer &w, QByteArray &out, const Entry &e) {
+        qint64 second = e.msecs / 1000;
+        if (second != w.cachedSecond) {
+            w.cachedSecond = second;
+            w.cachedDate = QDateTime::fromMSecsSinceEpoch(e.msecs).toString("yyyy-MM-dd hh:mm:ss").toLatin1();
+        }
+
+        out += '[';
+        out += w.cachedDate;
+        out += ' ';
+        out += typeTag(e.type);
+        out += "] ";
+        if (e.type != QtInfoMsg) {
+            if (e.function) {
+                out += e.function;
+            }
+            out += "(:";
+            out += QByteArray::number(e.line);
+            out += ") ";
+        }
+        out += e.msg.toUtf8();
+        out += '\n';
+    }
+
+    quint64 siteKey(const Entry &e) {
+        // Without QT_MESSAGELOGCONTEXT there is no call site, fall back to the start of the message
+        if (e.function) {
+            return (static_cast<quint64>(reinterpret_cast<quintptr>(e.function)) << 16) ^ static_cast<quint64>(e.line);
+        }
+        return qHash(QStringView(e.msg).left(24), qHash(QByteArrayView(e.category)));
+    }
+
+    //! returns false if the message should be dropped, appends a summary line once a suppressed site is let through
+    bool allow(Writer &w, const Entry &e, QByteArray &out) {
+        if (e.type != QtDebugMsg && e.type != QtInfoMsg) {
+            return true;
+        }
+
+        quint64 key = siteKey(e);
+        auto it = w.buckets.find(key);
+        if (it == w.buckets.end()) {
+            it = w.buckets.insert(key, Bucket{static_cast<double>(w.burst), e.msecs, 0});
+        }
+
+        Bucket &b = *it;
+        b.tokens = std::min<double>(w.burst, b.tokens + (e.msecs - b.lastMs) * w.perSecond / 1000.0);
+        b.lastMs = e.msecs;
+        if (b.tokens < 1) {
+            b.suppressed += 1;
+            return false;
+        }
+        b.tokens -= 1;
+
+        if (b.suppressed > 0) {
+            Entry summary{0, e.msecs, QtInfoMsg, e.category, nullptr, 0,
+                          QString("(%1 similar messages suppressed)").arg(b.suppressed)};
+            appendLine(w, out, summary);
+            b.suppressed = 0;
+        }
+        return true;
+    }
+
+    void pruneBuckets(Writer &w, qint64 now) {
+        if (w.buckets.size() < 4096) {
+            return;
+        }
+        for (auto it = w.buckets.begin(); it != w.buckets.end();) {
+            if (it->suppressed == 0 && now - it->lastMs > 60 * 1000) {
+                it = w.buckets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void openFile(Writer &w) {
+        QDir().mkpath(QFileInfo(w.filePath).absolutePath());
+        w.file = std::make_unique<QFile>(w.filePath);
+        if (!w.file->open(QIODevice::WriteOnly | QIODevice::Append)) {
+            fprintf(stderr, "Unable to open log file %s\n", qPrintable(w.filePath));
+            w.file.reset();
+            w.filePath.clear();
+            return;
+        }
+        w.fileSize = w.file->size();
+    }
+
+    void rotateFile(Writer &w) {
+        w.file.reset();
+        QFile::remove(QString("%1.%2").arg(w.filePath).arg(w.maxFiles));
+        for (int i = w.maxFiles - 1; i >= 1; i--) {
+            QFile::rename(QString("%1.%2").arg(w.filePath).arg(i), QString("%1.%2").arg(w.filePath).arg(i + 1));
+        }
+        QFile::rename(w.filePath, QString("%1.1").arg(w.filePath));
+        openFile(w);
+    }
+
+    void writeFile(Writer &w, const QByteArray &data) {
+        if (w.filePath.isEmpty() || data.isEmpty()) {
+            return;
+        }
+        if (!w.file) {
+            openFile(w);
+        }
+        if (w.file && w.maxFileSize > 0 && w.fileSize + data.size() > w.maxFileSize) {
+            rotateFile(w);
+        }
+        if (!w.file) {
+            return;
+        }
+        w.file->write(data);
+        w.file->flush();
+        w.fileSize += data.size();
+    }
+
+    void writeOut(Writer &w, const QByteArray &out, const QByteArray &err, const QByteArray &all) {
+        if (!out.isEmpty()) {
+            fwrite(out.constData(), 1, out.size(), stdout);
+            fflush(stdout);
+        }
+        if (!err.isEmpty()) {
+            fwrite(err.constData(), 1, err.size(), stderr);
+            fflush(stderr);
+        }
+        writeFile(w, all);
+    }
+
+    // Caller holds drainMutex
+    void drainAll(Writer &w) {
+        t_inDrain = true;
+
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(w.registryMutex);
+            rings = w.rings;
+        }
+
+        w.batch.clear();
+        for (const auto &ring : rings) {
+            ring->drain([&w](Entry &&e) {
+                w.batch.push_back(std::move(e));
+            });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(w.registryMutex);
+            w.rings.erase(std::remove_if(w.rings.begin(), w.rings.end(), [](const std::shared_ptr<Ring> &ring) {
+                return ring->orphaned.load(std::memory_order_acquire) && ring->empty();
+            }), w.rings.end());
+        }
+
+        quint64 dropped = w.dropped.exchange(0, std::memory_order_relaxed);
+        if (w.batch.empty() && dropped == 0) {
+            t_inDrain = false;
+            return;
+        }
+
+        std::sort(w.batch.begin(), w.batch.end(), [](const Entry &a, const Entry &b) {
+            return a.seq < b.seq;
+        });
+
+        QByteArray out, err, all;
+        bool toFile = !w.filePath.isEmpty();
+        for (const Entry &e : w.batch) {
+            QByteArray &target = toStderr(e.type) ? err : out;
+            qsizetype start = target.size();
+            if (!allow(w, e, target)) {
+                continue;
+            }
+            appendLine(w, target, e);
+            if (toFile) {
+                all.append(target.constData() + start, target.size() - start);
+            }
+        }
+
+        if (dropped > 0) {
+            Entry notice{0, QDateTime::currentMSecsSinceEpoch(), QtWarningMsg, nullptr, nullptr, 0,
+                         QString("Logger: %1 messages dropped, log buffer full").arg(dropped)};
+            qsizetype start = out.size();
+            appendLine(w, out, notice);
+            if (toFile) {
+                all.append(out.constData() + start, out.size() - start);
+            }
+        }
+
+        writeOut(w, out, err, all);
+
+        if (!w.batch.empty()) {
+            pruneBuckets(w, w.batch.back().msecs);
+        }
+        w.batch.clear();
+        t_inDrain = false;
+    }
+
+    void writeDirect(Writer &w, QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+        Entry e{0, QDateTime::currentMSecsSinceEpoch(), type, context.category, context.function, context.line, msg};
+        QByteArray line;
+        appendLine(w, line, e);
+        if (toStderr(type)) {
+            writeOut(w, {}, line, line);
+        } else {
+            writeOut(w, line, {}, line);
+        }
+    }
+
+    void wakeWriter(Writer &w) {
+        {
+            std::lock_guard<std::mutex> lock(w.wakeMutex);
+            w.wakeRequested = true;
+        }
+        w.wake.notify_one();
+    }
+
+    void run() {
+        Writer &w = writer();
+        while (w.running.load(std::memory_order_acquire)) {
+            {
+                std::unique_lock<std::mutex> lock(w.wakeMutex);
+                w.wake.wait_for(lock, std::chrono::milliseconds(100), [&w] {
+                    return w.wakeRequested || !w.running.load(std::memory_order_acquire);
+                });
+                w.wakeRequested = false;
+            }
+
+            std::lock_guard<std::mutex> lock(w.drainMutex);
+            drainAll(w);
+        }
+    }
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    Writer &w = writer();
+
+    // The writer itself logged something, e.g. a QFile warning: don't queue it behind the lock we're holding
+    if (t_inDrain) {
+        QByteArray line = QByteArray("[") + typeTag(type) + "] " + msg.toUtf8() + '\n';
+        fwrite(line.constData(), 1, line.size(), stderr);
+        return;
+    }
+
+    if (!w.running.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(w.drainMutex);
+        drainAll(w);
+        writeDirect(w, type, context, msg);
+        return;
+    }
+
+    Entry e{w.seq.fetch_add(1, std::memory_order_relaxed), QDateTime::currentMSecsSinceEpoch(), type,
+            context.category, context.function, context.line, msg};
+    if (!localRing()->push(std::move(e))) {
+        if (type == QtDebugMsg || type == QtInfoMsg) {
+            w.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Warnings and above are never dropped: write out what is queued, then this message, in order
+        std::lock_guard<std::mutex> lock(w.drainMutex);
+        drainAll(w);
+        writeDirect(w, type, context, msg);
+        return;
+    }
+
+    switch (type) {
+        case QtFatalMsg:
+            // Qt aborts as soon as we return
+            flush();
+            break;
+        case QtWarningMsg:
+        case QtCriticalMsg:
+            wakeWriter(w);
+            break;
+        default:
+            break;
+    }
+}
+
+void start() {
+    Writer &w = writer();
+    if (w.running.exchange(true)) {
+        return;
+    }
+
+    static bool registered = false;
+    if (!registered) {
+        registered = true;
+        std::atexit([]{ stop(); });
+    }
+
+    w.thread = std::thread(run);
+}
+
+void stop() {
+    Writer &w = writer();
+    if (!w.running.exchange(false)) {
+        return;
+    }
+
+    wakeWriter(w);
+    if (w.thread.joinable()) {
+        w.thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(w.drainMutex);
+    drainAll(w);
+}
+
+void flush() {
+    Writer &w = writer();
+    std::lock_guard<std::mutex> lock(w.drainMutex);
+    drainAll(w);
+}
+
+void setFilterRules(const QString &rules) {
+    QString filterRules = rules;
+    filterRules.replace(';', '\n');
+    QLoggingCategory::setFilterRules(filterRules);
+}
+
+void setLogFile(const QString &path, qint64 maxSize, int maxFiles) {
+    Writer &w = writer();
+    std::lock_guard<std::mutex> lock(w.drainMutex);
+    drainAll(w);
+
+    w.file.reset();
+    w.filePath = path;
+    w.maxFileSize = maxSize;
+    w.maxFiles = std::max(1, maxFiles);
+}
+
+void setRateLimit(int perSecond, int burst) {
+    Writer &w = writer();
+    std::lock_guard<std::mutex> lock(w.drainMutex);
+    w.perSecond = std::max(1, perSecond);
+    w.burst = std::max(1, burst);
+    w.buckets.clear();
+}
+
+}
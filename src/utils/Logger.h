@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_LOGGER_H
+#define FEATHER_LOGGER_H
+
+#include <QLoggingCategory>
+#include <QString>
+
+// Categories for chatty code paths. They default to Info, enable debug output with e.g.
+// QT_LOGGING_RULES="feather.history.debug=true" or the logFilterRules config key.
+Q_DECLARE_LOGGING_CATEGORY(lcWallet)
+Q_DECLARE_LOGGING_CATEGORY(lcHistory)
+Q_DECLARE_LOGGING_CATEGORY(lcNetwork)
+
+// Asynchronous Qt message handler.
+//
+// Logging threads only move the message into a lock-free ring buffer of their own, a background writer merges the
+// rings in order, formats the lines (timestamps are cached per second) and writes them to the console and, optionally,
+// to a rotating log file. Debug and info messages from a single call site are rate limited and dropped when the
+// ring is full, the writer reports how many were lost. Warnings and above are never dropped: when the ring is full
+// the logging thread writes out the queued messages and its own synchronously. Fatal messages are always written
+// before the handler returns.
+//
+// Before start() and after stop() messages are written synchronously.
+namespace Logger
+{
+    void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+
+    void start();
+    //! writes out everything still queued and stops the writer thread
+    void stop();
+    //! blocks until all messages logged so far are written
+    void flush();
+
+    //! QLoggingCategory filter rules, separated by ';' or newlines
+    void setFilterRules(const QString &rules);
+
+    //! enables the log file when path is not empty, it is rotated to path.1 .. path.<maxFiles> at maxSize bytes
+    void setLogFile(const QString &path, qint64 maxSize = 10 * 1024 * 1024, int maxFiles = 3);
+
+    //! sustained messages per second and burst size allowed per call site for debug and info messages
+    void setRateLimit(int perSecond, int burst);
+}
+
+#endif //FEATHER_LOGGER_H
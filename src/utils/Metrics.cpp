@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "Metrics.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QMutex>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace Metrics
+{
+    namespace {
+        QMutex registryMutex;
+        std::map<QString, std::unique_ptr<Histogram>> histogramRegistry;
+        std::map<QString, std::unique_ptr<Gauge>> gaugeRegistry;
+    }
+
+    Histogram::Histogram(QString name)
+        : m_name(std::move(name))
+    {
+    }
+
+    int Histogram::bucketIndex(qint64 us) {
+        if (us < subBuckets) {
+            return us < 0 ? 0 : static_cast<int>(us);
+        }
+
+        int exponent = 63 - __builtin_clzll(static_cast<quint64>(us)); // floor(log2(us)), >= 2
+        int sub = static_cast<int>((us >> (exponent - 2)) & (subBuckets - 1));
+        int index = subBuckets + (exponent - 2) * subBuckets + sub;
+        return std::min(index, bucketCount - 1);
+    }
+
+    qint64 Histogram::bucketUpperBound(int index) {
+        if (index < subBuckets) {
+            return index;
+        }
+
+        int exponent = (index - subBuckets) / subBuckets + 2;
+        int sub = (index - subBuckets) % subBuckets;
+        qint64 lower = static_cast<qint64>(subBuckets + sub) << (exponent - 2);
+        return lower + (qint64(1) << (exponent - 2)) - 1;
+    }
+
+    void Histogram::record(qint64 us) {
+        m_buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+
+        qint64 max = m_max.load(std::memory_order_relaxed);
+        while (us > max && !m_max.compare_exchange_weak(max, us, std::memory_order_relaxed)) {}
+    }
+
+    qint64 Histogram::percentile(double p, quint64 count) const {
+        auto rank = static_cast<quint64>(std::ceil(p * static_cast<double>(count)));
+        quint64 seen = 0;
+        for (int i = 0; i < bucketCount; i++) {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(i), m_max.load(std::memory_order_relaxed));
+            }
+        }
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    Histogram::Summary Histogram::summary() const {
+        Summary s;
+        s.name = m_name;
+        s.count = m_count.load(std::memory_order_relaxed);
+        s.max = m_max.load(std::memory_order_relaxed);
+        if (s.count > 0) {
+            s.p50 = this->percentile(0.50, s.count);
+            s.p99 = this->percentile(0.99, s.count);
+        }
+        return s;
+    }
+
+    Histogram* histogram(const QString &name) {
+        QMutexLocker locker(&registryMutex);
+        auto &entry = histogramRegistry[name];
+        if (!entry) {
+            entry = std::make_unique<Histogram>(name);
+        }
+        return entry.get();
+    }
+
+    Gauge* gauge(const QString &name) {
+        QMutexLocker locker(&registryMutex);
+        auto &entry = gaugeRegistry[name];
+        if (!entry) {
+            entry = std::make_unique<Gauge>(name);
+        }
+        return entry.get();
+    }
+
+    QList<Histogram::Summary> histograms() {
+        QMutexLocker locker(&registryMutex);
+        QList<Histogram::Summary> summaries;
+        for (const auto &entry : histogramRegistry) {
+            summaries.append(entry.second->summary());
+        }
+        return summaries;
+    }
+
+    QList<QPair<QString, qint64>> gauges() {
+        QMutexLocker locker(&registryMutex);
+        QList<QPair<QString, qint64>> values;
+        for (const auto &entry : gaugeRegistry) {
+            values.append({entry.first, entry.second->value()});
+        }
+        return values;
+    }
+
+    qint64 residentMemory() {
+#if defined(Q_OS_LINUX)
+        QFile statm("/proc/self/statm");
+        if (!statm.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.length() < 2) {
+            return -1;
+        }
+        return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+        return -1;
+#endif
+    }
+
+    QJsonObject toJson() {
+        QJsonArray histogramsArr;
+        for (const auto &s : histograms()) {
+            QJsonObject obj;
+            obj["name"] = s.name;
+            obj["count"] = static_cast<qint64>(s.count);
+            obj["p50_us"] = s.p50;
+            obj["p99_us"] = s.p99;
+            obj["max_us"] = s.max;
+            histogramsArr.append(obj);
+        }
+
+        QJsonObject gaugesObj;
+        for (const auto &g : gauges()) {
+            gaugesObj[g.first] = g.second;
+        }
+
+        QJsonObject obj;
+        obj["timestamp"] = QDateTime::currentSecsSinceEpoch();
+        obj["histograms"] = histogramsArr;
+        obj["gauges"] = gaugesObj;
+        return obj;
+    }
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_METRICS_H
+#define FEATHER_METRICS_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+// Lightweight performance counters for hot paths.
+//
+// Recording is a handful of relaxed atomic increments, so instrumentation is left on in release builds.
+// Histograms and gauges are created on first use and live until the application exits.
+namespace Metrics
+{
+    // Log-linear histogram of durations in microseconds, 4 buckets per power of two (<= 25% error).
+    class Histogram
+    {
+    public:
+        explicit Histogram(QString name);
+
+        struct Summary {
+            QString name;
+            quint64 count = 0;
+            qint64 p50 = 0;
+            qint64 p99 = 0;
+            qint64 max = 0;
+        };
+
+        void record(qint64 us);
+        Summary summary() const;
+
+    private:
+        static constexpr int subBuckets = 4;
+        static constexpr int bucketCount = subBuckets + 40 * subBuckets;
+
+        static int bucketIndex(qint64 us);
+        static qint64 bucketUpperBound(int index);
+        qint64 percentile(double p, quint64 count) const;
+
+        QString m_name;
+        std::array<std::atomic<quint64>, bucketCount> m_buckets{};
+        std::atomic<quint64> m_count{0};
+        std::atomic<qint64> m_max{0};
+    };
+
+    class Gauge
+    {
+    public:
+        explicit Gauge(QString name) : m_name(std::move(name)) {}
+
+        void set(qint64 value) {
+            m_value.store(value, std::memory_order_relaxed);
+        }
+        //! for gauges that count events
+        void increment(qint64 delta = 1) {
+            m_value.fetch_add(delta, std::memory_order_relaxed);
+        }
+        qint64 value() const {
+            return m_value.load(std::memory_order_relaxed);
+        }
+        QString name() const {
+            return m_name;
+        }
+
+    private:
+        QString m_name;
+        std::atomic<qint64> m_value{0};
+    };
+
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Histogram *histogram)
+            : m_histogram(histogram)
+            , m_start(std::chrono::steady_clock::now()) {}
+
+        ~ScopedTimer() {
+            m_histogram->record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Histogram *m_histogram;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    //! returns the histogram registered under name, creating it on first use
+    Histogram* histogram(const QString &name);
+
+    //! returns the gauge registered under name, creating it on first use
+    Gauge* gauge(const QString &name);
+
+    QList<Histogram::Summary> histograms();
+    QList<QPair<QString, qint64>> gauges();
+
+    //! resident set size of the process in bytes, -1 if unsupported on this platform
+    qint64 residentMemory();
+
+    QJsonObject toJson();
+}
+
+#define METRICS_CONCAT_INNER(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_INNER(a, b)
+#define METRICS_SCOPE(name) \
+    static Metrics::Histogram *METRICS_CONCAT(metricsHistogram, __LINE__) = Metrics::histogram(name); \
+    Metrics::ScopedTimer METRICS_CONCAT(metricsTimer, __LINE__)(METRICS_CONCAT(metricsHistogram, __LINE__))
+
+#endif //FEATHER_METRICS_H
@@ -8,7 +8,10 @@
 #include <QUrl>
 
 #include "utils/config.h"
+#include "utils/Startup.h"
+#include "utils/TorManager.h"
 #include "utils/Utils.h"
+#include "utils/WebsocketNotifier.h"
 
 QNetworkAccessManager *g_networkManagerSocks5 = nullptr;
 QNetworkAccessManager *g_networkManagerClearnet = nullptr;
@@ -47,4 +50,39 @@ QNetworkAccessManager* getNetwork(const QString &address)
     }
 
     return getNetworkSocks5();
+}
+
+QNetworkProxy applyProxySettings()
+{
+    // Will kill the process if necessary
+    torManager()->init();
+    torManager()->start();
+
+    QNetworkProxy proxy{QNetworkProxy::NoProxy};
+    if (conf()->get(Config::proxy).toInt() != Config::Proxy::None) {
+        QString host = conf()->get(Config::socks5Host).toString();
+        quint16 port = conf()->get(Config::socks5Port).toString().toUShort();
+
+        if (conf()->get(Config::proxy).toInt() == Config::Proxy::Tor && (!torManager()->isLocalTor() || torManager()->isAlreadyRunning())) {
+            host = torManager()->featherTorHost;
+            port = torManager()->featherTorPort;
+        }
+
+        proxy = QNetworkProxy{QNetworkProxy::Socks5Proxy, host, port};
+        getNetworkSocks5()->setProxy(proxy);
+    }
+
+    qWarning() << "Proxy: " << proxy.hostName() << " " << proxy.port();
+
+    // Switch websocket to new proxy and update URL
+    websocketNotifier()->websocketClient->stop();
+    websocketNotifier()->websocketClient->webSocket->setProxy(proxy);
+    websocketNotifier()->websocketClient->nextWebsocketUrl();
+
+    // Prices and update notices can wait until the first window painted
+    startup()->whenInteractive("WebsocketClient::restart", []{
+        websocketNotifier()->websocketClient->restart();
+    });
+
+    return proxy;
 }
\ No newline at end of file
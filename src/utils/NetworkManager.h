@@ -5,10 +5,14 @@
 #define FEATHER_NETWORKMANAGER_H
 
 #include <QNetworkAccessManager>
+#include <QNetworkProxy>
 
 QNetworkAccessManager* getNetworkSocks5();
 QNetworkAccessManager* getNetworkClearnet();
 
 QNetworkAccessManager* getNetwork(const QString &address = "");
 
+// (Re)starts Tor if needed and points the SOCKS5 network manager and the websocket at the configured proxy
+QNetworkProxy applyProxySettings();
+
 #endif //FEATHER_NETWORKMANAGER_H
@@ -17,7 +17,7 @@ void Networking::setUserAgent(const QString &userAgent) {
     this->m_userAgent = userAgent;
 }
 
-QNetworkReply* Networking::get(QObject *parent, const QString &url) {
+QNetworkReply* Networking::get(QObject *parent, const QString &url, qint64 offset) {
     if (conf()->get(Config::offlineMode).toBool()) {
         return nullptr;
     }
@@ -27,6 +27,9 @@ QNetworkReply* Networking::get(QObject *parent, const QString &url) {
     QNetworkRequest request;
     request.setUrl(QUrl(url));
     request.setRawHeader("User-Agent", m_userAgent.toUtf8());
+    if (offset > 0) {
+        request.setRawHeader("Range", QString("bytes=%1-").arg(offset).toUtf8());
+    }
 
     QNetworkReply *reply = this->m_networkAccessManager->get(request);;
     reply->setParent(parent);
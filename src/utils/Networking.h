@@ -16,7 +16,8 @@ Q_OBJECT
 public:
     explicit Networking(QObject *parent = nullptr);
 
-    QNetworkReply* get(QObject *parent, const QString &url);
+    //! with offset > 0, asks the server for the remainder of the resource starting at that byte
+    QNetworkReply* get(QObject *parent, const QString &url, qint64 offset = 0);
     QNetworkReply* getJson(QObject *parent, const QString &url);
     QNetworkReply* postJson(QObject *parent, const QString &url, const QJsonObject &data);
     void setUserAgent(const QString &userAgent);
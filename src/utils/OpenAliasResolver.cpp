@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "OpenAliasResolver.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "libwalletqt/WalletManager.h"
+#include "utils/config.h"
+
+OpenAliasResolver::OpenAliasResolver(QObject *parent)
+    : QObject(parent)
+    , m_scheduler(this)
+{
+    this->loadDiskCache();
+
+    connect(conf(), &Config::changed, this, [this](Config::ConfigKey key){
+        if (key == Config::cacheOpenAliases && !conf()->get(Config::cacheOpenAliases).toBool()) {
+            conf()->set(Config::openAliasCache, "{}");
+        }
+    });
+}
+
+OpenAliasResolver::~OpenAliasResolver() {
+    m_scheduler.shutdownWaitForFinished();
+}
+
+QPointer<OpenAliasResolver> OpenAliasResolver::m_instance(nullptr);
+
+bool OpenAliasResolver::isAlias(const QString &text, NetworkType::Type nettype) {
+    QString alias = text.trimmed();
+    if (!alias.contains('.') || alias.contains(' ')) {
+        return false;
+    }
+    return !WalletManager::addressValid(alias, nettype);
+}
+
+QString OpenAliasResolver::normalize(const QString &alias) {
+    return alias.trimmed().toLower().replace('@', '.');
+}
+
+void OpenAliasResolver::resolve(const QStringList &aliases) {
+    for (const auto &text : aliases) {
+        QString alias = normalize(text);
+        if (alias.isEmpty()) {
+            continue;
+        }
+
+        OpenAliasResult result;
+        if (this->lookup(alias, result)) {
+            // Queued like a lookup, so callers see the same order of events either way
+            QMetaObject::invokeMethod(this, [this, result]{
+                emit resolved(result);
+            }, Qt::QueuedConnection);
+            continue;
+        }
+
+        if (m_inFlight.contains(alias)) {
+            continue;
+        }
+        m_inFlight.insert(alias);
+
+        bool scheduled = m_scheduler.run([this, alias]{
+            OpenAliasResult result;
+            result.alias = alias;
+            result.address = WalletManager::instance()->resolveOpenAlias(alias, result.dnssecValid);
+
+            QMetaObject::invokeMethod(this, [this, result]{
+                this->onResolved(result);
+            }, Qt::QueuedConnection);
+        }).first;
+
+        if (!scheduled) {
+            // Shutting down
+            m_inFlight.remove(alias);
+        }
+    }
+}
+
+void OpenAliasResolver::resolve(const QString &alias) {
+    this->resolve(QStringList{alias});
+}
+
+bool OpenAliasResolver::lookup(const QString &alias, OpenAliasResult &result) const {
+    auto it = m_cache.constFind(normalize(alias));
+    if (it == m_cache.cend() || it->expires <= QDateTime::currentSecsSinceEpoch()) {
+        return false;
+    }
+    result = it.value();
+    return true;
+}
+
+bool OpenAliasResolver::isResolving(const QString &alias) const {
+    return m_inFlight.contains(normalize(alias));
+}
+
+void OpenAliasResolver::clearCache() {
+    m_cache.clear();
+    this->saveDiskCache();
+}
+
+void OpenAliasResolver::onResolved(const OpenAliasResult &resolved) {
+    m_inFlight.remove(resolved.alias);
+
+    OpenAliasResult result = resolved;
+    const bool found = !result.address.isEmpty();
+    result.expires = QDateTime::currentSecsSinceEpoch() + (found ? cacheTtl : failureTtl);
+    m_cache.insert(result.alias, result);
+
+    if (found && result.dnssecValid) {
+        this->saveDiskCache();
+    }
+
+    emit this->resolved(result);
+}
+
+void OpenAliasResolver::loadDiskCache() {
+    if (!conf()->get(Config::cacheOpenAliases).toBool()) {
+        return;
+    }
+
+    QVariant value = conf()->get(Config::openAliasCache);
+    QJsonObject obj = value.toJsonObject();
+    if (obj.isEmpty()) {
+        obj = QJsonObject::fromVariantMap(value.toMap());
+    }
+    if (obj.isEmpty()) {
+        obj = QJsonDocument::fromJson(value.toByteArray()).object();
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+        // [address, expires]
+        QJsonArray entry = it.value().toArray();
+        if (entry.size() != 2 || static_cast<qint64>(entry[1].toDouble()) <= now) {
+            continue;
+        }
+
+        OpenAliasResult result;
+        result.alias = it.key();
+        result.address = entry[0].toString();
+        result.dnssecValid = true;
+        result.expires = static_cast<qint64>(entry[1].toDouble());
+        m_cache.insert(result.alias, result);
+    }
+}
+
+void OpenAliasResolver::saveDiskCache() {
+    if (!conf()->get(Config::cacheOpenAliases).toBool()) {
+        return;
+    }
+
+    // Only results that can be trusted without looking them up again
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QJsonObject obj;
+    for (const auto &result : m_cache) {
+        if (result.address.isEmpty() || !result.dnssecValid || result.expires <= now) {
+            continue;
+        }
+        obj[result.alias] = QJsonArray{result.address, static_cast<double>(result.expires)};
+    }
+    conf()->set(Config::openAliasCache, obj);
+}
+
+OpenAliasResolver* OpenAliasResolver::instance()
+{
+    if (!m_instance) {
+        m_instance = new OpenAliasResolver(QCoreApplication::instance());
+    }
+
+    return m_instance;
+}
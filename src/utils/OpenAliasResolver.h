@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_OPENALIASRESOLVER_H
+#define FEATHER_OPENALIASRESOLVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+
+#include "utils/networktype.h"
+#include "utils/scheduler.h"
+
+struct OpenAliasResult
+{
+    QString alias;          // normalized, see OpenAliasResolver::normalize()
+    QString address;        // empty if the alias has no address record
+    bool dnssecValid = false;
+    qint64 expires = 0;     // seconds since epoch
+};
+
+// Resolves OpenAlias addresses in the background and caches the results.
+//
+// Lookups run in parallel on the thread pool. A lookup for an alias that is already in flight isn't started again,
+// all requesters get the one result. Results are kept until they expire, failed lookups for a shorter time so typing
+// doesn't query the same name over and over. DNSSEC-validated results can also be kept in the config file across
+// restarts if the user enables it.
+//
+// Lookups go through the wallet library's DNS resolver, which doesn't report the TTL of the records, so a fixed TTL
+// is used. The resolver honours DNS_PUBLIC (e.g. DNS_PUBLIC=tcp://127.0.0.1), which points it at a local stub server.
+class OpenAliasResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    static OpenAliasResolver* instance();
+
+    //! e.g. "donate.getmonero.org" or "user@example.com", as opposed to an address of the network
+    static bool isAlias(const QString &text, NetworkType::Type nettype);
+    //! lower case, with '@' replaced by '.' like the wallet library does
+    static QString normalize(const QString &alias);
+
+    //! resolved() is emitted once for each alias, also for those answered from the cache
+    void resolve(const QStringList &aliases);
+    void resolve(const QString &alias);
+
+    //! unexpired cache entry of the alias, returns false if there is none
+    bool lookup(const QString &alias, OpenAliasResult &result) const;
+    bool isResolving(const QString &alias) const;
+
+    void clearCache();
+
+    static constexpr qint64 cacheTtl = 60 * 60;
+    static constexpr qint64 failureTtl = 60;
+
+signals:
+    void resolved(const OpenAliasResult &result);
+
+private:
+    explicit OpenAliasResolver(QObject *parent = nullptr);
+    ~OpenAliasResolver() override;
+
+    void onResolved(const OpenAliasResult &result);
+    void loadDiskCache();
+    void saveDiskCache();
+
+    static QPointer<OpenAliasResolver> m_instance;
+
+    FutureScheduler m_scheduler;
+    QHash<QString, OpenAliasResult> m_cache;
+    QSet<QString> m_inFlight;
+};
+
+inline OpenAliasResolver* openAliasResolver()
+{
+    return OpenAliasResolver::instance();
+}
+
+#endif //FEATHER_OPENALIASRESOLVER_H
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "OtsContainer.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+
+#include <cstring>
+
+#include "utils/Metrics.h"
+
+namespace OtsContainer
+{
+
+bool isContainer(const std::string &data) {
+    return data.size() >= headerSize && std::memcmp(data.data(), magic, magicSize) == 0;
+}
+
+bool pack(std::string &data, int level) {
+    METRICS_SCOPE("OtsContainer::pack");
+
+    QByteArray compressed = qCompress(reinterpret_cast<const uchar *>(data.data()), static_cast<qsizetype>(data.size()), level);
+    if (compressed.isEmpty()) {
+        qWarning() << "OtsContainer: compression failed";
+        return false;
+    }
+
+    qDebug() << "OtsContainer: packed" << data.size() << "bytes into" << compressed.size() + headerSize;
+
+    // Drop the uncompressed buffer before growing the new one, so peak usage is input + compressed size
+    data.clear();
+    data.shrink_to_fit();
+    data.reserve(headerSize + compressed.size());
+    data.append(magic, magicSize);
+    data.push_back(static_cast<char>(version));
+    data.push_back(static_cast<char>(Codec::Deflate));
+    data.append(compressed.constData(), compressed.size());
+    return true;
+}
+
+bool unpack(std::string &data, QString *error) {
+    if (!isContainer(data)) {
+        return true;
+    }
+
+    METRICS_SCOPE("OtsContainer::unpack");
+
+    auto fail = [error](const QString &msg) {
+        qWarning() << "OtsContainer:" << msg;
+        if (error) {
+            *error = msg;
+        }
+        return false;
+    };
+
+    auto dataVersion = static_cast<quint8>(data[magicSize]);
+    if (dataVersion > version) {
+        return fail(QString("Unsupported container version %1, update Feather on this device").arg(dataVersion));
+    }
+
+    auto codec = static_cast<quint8>(data[magicSize + 1]);
+    if (codec != Codec::Deflate) {
+        return fail(QString("Unsupported compression method %1").arg(codec));
+    }
+
+    // qUncompress allocates the size from the 4-byte header up front, don't trust it from a QR code or a file
+    if (data.size() < headerSize + 4) {
+        return fail("Compressed data is corrupt or incomplete");
+    }
+    const auto *sizeHeader = reinterpret_cast<const uchar *>(data.data()) + headerSize;
+    const quint64 declaredSize = (quint64(sizeHeader[0]) << 24) | (quint64(sizeHeader[1]) << 16) | (quint64(sizeHeader[2]) << 8) | quint64(sizeHeader[3]);
+    const quint64 compressedSize = data.size() - headerSize - 4;
+    if (declaredSize > maxPayloadSize || declaredSize > compressedSize * maxDeflateRatio) {
+        return fail(QString("Declared payload size of %1 bytes is not plausible").arg(declaredSize));
+    }
+
+    QByteArray payload = qUncompress(reinterpret_cast<const uchar *>(data.data()) + headerSize,
+                                     static_cast<qsizetype>(data.size()) - headerSize);
+    if (payload.isEmpty()) {
+        return fail("Compressed data is corrupt or incomplete");
+    }
+
+    data.clear();
+    data.shrink_to_fit();
+    data.assign(payload.constData(), payload.size());
+    return true;
+}
+
+bool writeFile(const QString &path, const std::string &data, QString *error) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = QString("Could not open file %1 for writing").arg(path);
+        }
+        return false;
+    }
+
+    if (file.write(data.data(), static_cast<qint64>(data.size())) != static_cast<qint64>(data.size())) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+bool readFile(const QString &path, std::string &data, QString *error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = QString("Could not open file %1 for reading").arg(path);
+        }
+        return false;
+    }
+
+    // Read straight into the string instead of readAll() + toStdString(), which holds two full copies
+    data.resize(file.size());
+    qint64 read = file.read(data.data(), static_cast<qint64>(data.size()));
+    if (read < 0) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    data.resize(read);
+
+    return unpack(data, error);
+}
+
+}
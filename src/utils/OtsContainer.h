@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_OTSCONTAINER_H
+#define FEATHER_OTSCONTAINER_H
+
+#include <QString>
+
+#include <string>
+
+// Optional compressed envelope for offline transaction signing payloads (outputs, key images, tx sets).
+//
+// Layout: magic "FOTS", one version byte, one codec byte, then the codec payload. Version 1 only knows deflate,
+// stored as produced by qCompress (4-byte big-endian uncompressed size followed by a zlib stream).
+//
+// Plain payloads from the wallet library start with their own "Monero ..." magic, so unpack() can tell both apart
+// and import pages accept either without asking the user.
+namespace OtsContainer
+{
+    constexpr char magic[] = "FOTS";
+    constexpr int magicSize = 4;
+    constexpr int headerSize = magicSize + 2;
+    constexpr quint8 version = 1;
+
+    // Limits for the uncompressed size a container declares, deflate can't expand data by more than ~1032:1
+    constexpr quint64 maxPayloadSize = 256 * 1024 * 1024;
+    constexpr quint64 maxDeflateRatio = 1032;
+
+    enum Codec : quint8 {
+        Deflate = 1
+    };
+
+    bool isContainer(const std::string &data);
+
+    //! replaces data with its compressed container, the uncompressed buffer is released before returning
+    bool pack(std::string &data, int level = 9);
+
+    //! replaces a container with its decompressed payload, plain data is left untouched
+    bool unpack(std::string &data, QString *error = nullptr);
+
+    //! writes data to path in one go, without going through QByteArray
+    bool writeFile(const QString &path, const std::string &data, QString *error = nullptr);
+
+    //! reads path into data and unpacks it if it is a container
+    bool readFile(const QString &path, std::string &data, QString *error = nullptr);
+}
+
+#endif //FEATHER_OTSCONTAINER_H
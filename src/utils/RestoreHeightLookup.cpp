@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "RestoreHeightLookup.h"
+
+#include "EmbeddedRestoreHeights.h"
+
+namespace {
+    template<std::size_t N>
+    constexpr bool isSorted(const std::array<RestoreHeightLookup::Checkpoint, N> &table) {
+        for (std::size_t i = 1; i < N; i++) {
+            if (table[i].timestamp <= table[i - 1].timestamp || table[i].height <= table[i - 1].height) {
+                return false;
+            }
+        }
+        return N > 0;
+    }
+
+    // The generator checks this too, the lookups rely on it
+    static_assert(isSorted(embedded::mainnetRestoreHeights), "mainnet restore heights are not sorted");
+    static_assert(isSorted(embedded::stagenetRestoreHeights), "stagenet restore heights are not sorted");
+
+    constexpr RestoreHeightLookup mainnet{NetworkType::MAINNET, embedded::mainnetRestoreHeights.data(), embedded::mainnetRestoreHeights.size()};
+    constexpr RestoreHeightLookup stagenet{NetworkType::STAGENET, embedded::stagenetRestoreHeights.data(), embedded::stagenetRestoreHeights.size()};
+    constexpr RestoreHeightLookup testnet{NetworkType::TESTNET, nullptr, 0};
+}
+
+const RestoreHeightLookup* RestoreHeightLookup::forNetwork(NetworkType::Type type) {
+    switch (type) {
+        case NetworkType::MAINNET:
+            return &mainnet;
+        case NetworkType::STAGENET:
+            return &stagenet;
+        default:
+            return &testnet;
+    }
+}
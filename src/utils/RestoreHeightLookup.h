@@ -6,98 +6,142 @@
 
 #include <QDateTime>
 
-#include <cstdio>
-#include <cstdlib>
+#include <algorithm>
+#include <functional>
 
 #include "monero_seed/monero_seed.hpp"
 
 #include "networktype.h"
-#include "utils/Utils.h"
 
+// Estimates between block heights and dates from a table of checkpoints.
+//
+// The tables are generated from assets/restore_heights_monero_*.txt at build time (see contrib/embed-tables), a
+// lookup is a binary search over a constexpr array and doesn't allocate.
 struct RestoreHeightLookup {
+    struct Checkpoint {
+        time_t timestamp;
+        int height;
+    };
+
+    static constexpr int blockTime = 120;
+    static constexpr int blocksPerDay = 720;
+
     NetworkType::Type type;
-    QMap<time_t, int> data;
-    explicit RestoreHeightLookup(NetworkType::Type type) : type(type) {}
+    const Checkpoint *table = nullptr; // sorted by timestamp and by height
+    std::size_t size = 0;
+
+    constexpr RestoreHeightLookup(NetworkType::Type type, const Checkpoint *table, std::size_t size)
+        : type(type), table(table), size(size) {}
 
-    int dateToHeight(time_t date) {
+    //! the embedded table of the network, testnet has no checkpoints
+    static const RestoreHeightLookup* forNetwork(NetworkType::Type type);
+
+    const Checkpoint* begin() const { return table; }
+    const Checkpoint* end() const { return table + size; }
+    bool empty() const { return size == 0; }
+    const Checkpoint& front() const { return table[0]; }
+    const Checkpoint& back() const { return table[size - 1]; }
+
+    int dateToHeight(time_t date) const {
         // restore height based on a given timestamp using a lookup
-        // table. If it cannot find the date in the lookup table, it
-        // will calculate the blockheight based off the last known
-        // date: ((now - lastKnownDate) / blockTime) - clearance
+        // table. The height is interpolated between the surrounding
+        // checkpoints, minus a clearance to account for the drift in
+        // block times between checkpoints. Past the last checkpoint
+        // the height is extrapolated and a larger clearance is used.
 
         if (this->type == NetworkType::TESTNET) {
             return 1;
         }
 
-        int blockTime = 120;
-        int blocksPerDay = 720;
-        int blockCalcClearance = blocksPerDay * 5;
-
-        QList<time_t> values = this->data.keys();
-
         // If timestamp is before epoch, return genesis height.
-        if (date <= values.at(0)) {
+        if (this->empty() || date <= this->front().timestamp) {
             return 1;
         }
 
-        for (int i = 0; i != values.count(); i++) {
-            if (values[i] > date) {
-                if (i == 0) {
-                    return 1;
-                }
-                return this->data[values[i-1]] - blockCalcClearance;
-            }
+        bool extrapolated = date > this->back().timestamp;
+        int blockCalcClearance = extrapolated ? blocksPerDay * 5 : blocksPerDay;
+
+        return std::max(1, this->estimateHeight(date) - blockCalcClearance);
+    }
+
+    int estimateHeight(time_t date) const {
+        // best guess for the height of the first block at or after date, without clearance
+        if (this->empty() || date <= this->front().timestamp) {
+            return 1;
         }
 
-        // lookup failed, calculate blockheight from last known checkpoint
-        time_t lastBlockHeightTime = values.last();
-        int lastBlockHeight = this->data[lastBlockHeightTime];
+        auto next = std::upper_bound(this->begin(), this->end(), date, [](time_t d, const Checkpoint &c) {
+            return d < c.timestamp;
+        });
 
-        time_t deltaTime = date - lastBlockHeightTime;
-        int deltaBlocks = deltaTime / blockTime;
+        if (next == this->end()) {
+            const Checkpoint &last = this->back();
+            return last.height + static_cast<int>((date - last.timestamp) / blockTime);
+        }
 
-        int blockHeight = (lastBlockHeight + deltaBlocks) - blockCalcClearance;
-        return blockHeight;
+        const Checkpoint &prev = *(next - 1);
+        return prev.height + static_cast<int>(qint64(date - prev.timestamp) * (next->height - prev.height) / qint64(next->timestamp - prev.timestamp));
     }
 
-    time_t heightToTimestamp(int height) {
-        // @TODO: most likely inefficient, refactor
-        QMap<time_t, int>::iterator i;
-        time_t timestamp = 0;
-        int heightData = 1;
-        for (i = this->data.begin(); i != this->data.end(); ++i) {
-            time_t ts = i.key();
-            if (i.value() > height)
-                return timestamp;
-            timestamp = ts;
-            heightData = i.value();
+    time_t heightToTimestamp(int height) const {
+        if (this->empty()) {
+            return static_cast<time_t>(std::max(0, height - 1) / blocksPerDay) * 86400;
+        }
+
+        if (height <= this->front().height) {
+            return this->front().timestamp;
         }
 
-        while (heightData < height) {
-            heightData += 720; // blocks per day
-            timestamp += 86400; // seconds in day
+        auto next = std::upper_bound(this->begin(), this->end(), height, [](int h, const Checkpoint &c) {
+            return h < c.height;
+        });
+
+        if (next == this->end()) {
+            const Checkpoint &last = this->back();
+            return last.timestamp + static_cast<time_t>(height - last.height) * blockTime;
         }
 
-        return timestamp;
+        const Checkpoint &prev = *(next - 1);
+        return prev.timestamp + static_cast<time_t>(qint64(height - prev.height) * (next->timestamp - prev.timestamp) / (next->height - prev.height));
     }
 
-    QDateTime heightToDate(int height) {
+    QDateTime heightToDate(int height) const {
         return QDateTime::fromSecsSinceEpoch(this->heightToTimestamp(height));
     }
 
-    static RestoreHeightLookup *fromFile(const QString &fn, NetworkType::Type type) {
-        // initialize this class using a lookup table, e.g `:/assets/restore_heights_monero_mainnet.txt`/
-        auto rtn = new RestoreHeightLookup(type);
-        auto data= Utils::barrayToString(Utils::fileOpen(fn));
+    // Binary search for the first block in [low, high] with a timestamp at or after date.
+    // timestampAt fetches a block header timestamp, e.g. from a daemon, and returns false on failure.
+    // Returns -1 if a header could not be fetched or if date lies before the block at low.
+    static int searchHeight(time_t date, int low, int high, const std::function<bool(int height, time_t &timestamp)> &timestampAt) {
+        if (low > high) {
+            return -1;
+        }
 
-        for (const auto &line: data.split('\n')) {
-            if (line.trimmed().isEmpty()) {
-                continue;
+        time_t timestamp;
+        if (!timestampAt(low, timestamp) || timestamp >= date) {
+            return -1;
+        }
+        if (!timestampAt(high, timestamp)) {
+            return -1;
+        }
+        if (timestamp < date) {
+            return high;
+        }
+
+        // invariant: timestamp(low) < date <= timestamp(high)
+        while (high - low > 1) {
+            int mid = low + (high - low) / 2;
+            if (!timestampAt(mid, timestamp)) {
+                return -1;
+            }
+            if (timestamp < date) {
+                low = mid;
+            } else {
+                high = mid;
             }
-            auto spl = line.trimmed().split(':');
-            rtn->data[(time_t)spl.at(0).toInt()] = spl.at(1).toInt();
         }
-        return rtn;
+
+        return high;
     }
 };
 
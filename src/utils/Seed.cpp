@@ -6,7 +6,7 @@
 #include "constants.h"
 #include "monero_seed/monero_seed.hpp"
 #include "polyseed/polyseed.h"
-#include "utils/AppData.h"
+#include "utils/RestoreHeightLookup.h"
 #include "crypto/crypto.h"
 #include "mnemonics/electrum-words.h"
 
@@ -153,7 +153,7 @@ Seed::Seed(Type type, QStringList mnemonic, NetworkType::Type networkType)
 void Seed::setRestoreHeight(int height) {
     auto now = std::time(nullptr);
     auto nowClearance = 3600 * 24;
-    auto currentBlockHeight = appData()->restoreHeights[this->networkType]->dateToHeight(now - nowClearance);
+    auto currentBlockHeight = RestoreHeightLookup::forNetwork(this->networkType)->dateToHeight(now - nowClearance);
     if (height >= currentBlockHeight + nowClearance) {
         qWarning() << "unrealistic restore height detected, setting to current blockheight instead: " << currentBlockHeight;
         this->restoreHeight = currentBlockHeight;
@@ -164,7 +164,7 @@ void Seed::setRestoreHeight(int height) {
 
 void Seed::setRestoreHeight() {
     // Ignore the embedded restore date, new wallets should sync from the current block height.
-    this->restoreHeight = appData()->restoreHeights[networkType]->dateToHeight(this->time);
+    this->restoreHeight = RestoreHeightLookup::forNetwork(networkType)->dateToHeight(this->time);
 }
 
 Seed::Seed() = default;
\ No newline at end of file
@@ -29,6 +29,7 @@ struct Seed {
 
     time_t time{};
     int restoreHeight = 0;
+    time_t restoreDate{}; // if set, restoreHeight is refined against the node once the wallet connects
 
     QString errorString;
 
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "Startup.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QThread>
+#include <QTimer>
+#include <QWidget>
+#include <QtConcurrent/QtConcurrent>
+
+#include "utils/Metrics.h"
+#include "utils/Tracer.h"
+
+Startup::Startup(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QPointer<Startup> Startup::m_instance(nullptr);
+
+void Startup::add(const char *name, Thread thread, std::function<void()> task, const QVector<const char*> &dependencies) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_tasks.contains(name)) {
+            qWarning() << "Startup: task added twice:" << name;
+            return;
+        }
+
+        Task t;
+        t.name = name;
+        t.thread = thread;
+        t.function = std::move(task);
+        for (const char *dependency : dependencies) {
+            if (!m_tasks.contains(dependency)) {
+                qWarning() << "Startup: ignoring unknown dependency" << dependency << "of" << name;
+                continue;
+            }
+            t.dependencies.append(dependency);
+        }
+        m_tasks.insert(name, t);
+    }
+
+    this->schedule();
+}
+
+void Startup::wait(const char *name) {
+    const bool onGuiThread = QThread::currentThread() == this->thread();
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_tasks.constFind(name);
+    if (it == m_tasks.cend() || it->state == Done) {
+        return;
+    }
+
+    const Thread thread = it->thread;
+    if (thread == Gui && (!onGuiThread || it->state == Running)) {
+        // Would never finish: the GUI thread is busy with the caller
+        qWarning() << "Startup: can't wait for" << name << "here";
+        return;
+    }
+
+    if (it->state == Pending && onGuiThread) {
+        // Needed now, start it instead of waiting for the event loop to get to it
+        const QVector<QByteArray> dependencies = it->dependencies;
+        locker.unlock();
+        for (const auto &dependency : dependencies) {
+            this->wait(dependency.constData());
+        }
+        if (thread == Gui) {
+            this->runOnGuiThread(name);
+            return;
+        }
+        this->schedule();
+        locker.relock();
+    }
+
+    while (true) {
+        it = m_tasks.constFind(name);
+        if (it == m_tasks.cend() || it->state == Done) {
+            return;
+        }
+        m_taskFinished.wait(&m_mutex);
+    }
+}
+
+void Startup::whenInteractive(const char *name, std::function<void()> task) {
+    if (!m_interactive) {
+        m_deferred.append({name, std::move(task)});
+        return;
+    }
+
+    const qint64 start = Tracer::now();
+    task();
+    Tracer::complete(name, start, Tracer::now());
+}
+
+void Startup::watch(QWidget *window) {
+    if (m_interactive || !window) {
+        return;
+    }
+    window->installEventFilter(this);
+}
+
+void Startup::setInteractive() {
+    if (m_interactive) {
+        return;
+    }
+    m_interactive = true;
+    m_interactiveAt = Tracer::now();
+
+    Tracer::instant("Startup::interactive");
+    Metrics::gauge("startup.timeToInteractive")->set(m_interactiveAt / 1000);
+    qInfo() << QString("Startup: interactive after %1 ms, %2 deferred tasks").arg(QString::number(m_interactiveAt / 1000), QString::number(m_deferred.size()));
+
+    emit interactive();
+
+    // One per event loop iteration, so input that arrives in between isn't held up
+    for (auto &deferred : m_deferred) {
+        QTimer::singleShot(0, this, [name = deferred.first, task = std::move(deferred.second)]{
+            const qint64 start = Tracer::now();
+            task();
+            const qint64 end = Tracer::now();
+            Tracer::complete(name, start, end);
+            qDebug() << QString("Startup: deferred %1 took %2 ms").arg(name, QString::number((end - start) / 1000));
+        });
+    }
+    m_deferred.clear();
+}
+
+bool Startup::isInteractive() const {
+    return m_interactive;
+}
+
+bool Startup::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::Paint) {
+        watched->removeEventFilter(this);
+        if (!m_paintSeen) {
+            m_paintSeen = true;
+            // After the paint event was handled and the frame was flushed
+            QTimer::singleShot(0, this, &Startup::setInteractive);
+        }
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void Startup::schedule() {
+    QMutexLocker locker(&m_mutex);
+    for (auto &task : m_tasks) {
+        if (task.state == Pending && !task.queued && this->isReady(task)) {
+            this->launch(task);
+        }
+    }
+}
+
+bool Startup::isReady(const Task &task) const {
+    for (const auto &dependency : task.dependencies) {
+        auto it = m_tasks.constFind(dependency);
+        if (it == m_tasks.cend() || it->state != Done) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Startup::launch(Task &task) {
+    const QByteArray key{task.name};
+
+    if (task.thread == Gui) {
+        task.queued = true;
+        QMetaObject::invokeMethod(this, [this, key]{
+            this->runOnGuiThread(key);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    task.state = Running;
+    task.future = QtConcurrent::run([this, key, name = task.name, function = task.function]{
+        const qint64 start = Tracer::now();
+        function();
+        const qint64 end = Tracer::now();
+        this->finished(key, start, end);
+        Tracer::complete(name, start, end);
+
+        // Dependents are started from the GUI thread
+        QMetaObject::invokeMethod(this, &Startup::schedule, Qt::QueuedConnection);
+    });
+}
+
+void Startup::runOnGuiThread(const QByteArray &key) {
+    std::function<void()> function;
+    const char *name;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_tasks.find(key);
+        if (it == m_tasks.end() || it->state != Pending) {
+            // Already run by wait()
+            return;
+        }
+        it->state = Running;
+        function = it->function;
+        name = it->name;
+    }
+
+    const qint64 start = Tracer::now();
+    function();
+    const qint64 end = Tracer::now();
+    this->finished(key, start, end);
+    Tracer::complete(name, start, end);
+
+    this->schedule();
+}
+
+void Startup::finished(const QByteArray &key, qint64 start, qint64 end) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_tasks.find(key);
+        it->state = Done;
+        it->start = start;
+        it->end = end;
+    }
+    m_taskFinished.wakeAll();
+
+    const qint64 ms = (end - start) / 1000;
+    Metrics::gauge(QString("startup.%1").arg(QString::fromLatin1(key)))->set(ms);
+    qDebug() << QString("Startup: %1 took %2 ms, started at %3 ms").arg(QString::fromLatin1(key), QString::number(ms), QString::number(start / 1000));
+}
+
+Startup* Startup::instance()
+{
+    if (!m_instance) {
+        m_instance = new Startup(QCoreApplication::instance());
+    }
+
+    return m_instance;
+}
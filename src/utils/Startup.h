@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_STARTUP_H
+#define FEATHER_STARTUP_H
+
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <functional>
+
+class QWidget;
+
+// Runs the initializers of the application start as a dependency graph.
+//
+// A task starts as soon as the tasks it depends on finished. Worker tasks run on the global thread pool, next to each
+// other and next to opening the wallet, GUI tasks are queued on the event loop. Code that needs the result of a task
+// blocks on it with wait(), so a slow initializer only delays its first user.
+//
+// Work that isn't needed to show a window is held back with whenInteractive() until the first window painted. The time
+// from process start to that paint is logged as time to interactive, together with the duration of every task.
+class Startup : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Thread {
+        Gui = 0,
+        Worker
+    };
+
+    static Startup* instance();
+
+    //! name must be a string literal, dependencies must have been added before
+    void add(const char *name, Thread thread, std::function<void()> task, const QVector<const char*> &dependencies = {});
+    //! blocks until the task finished, returns right away for tasks that were never added.
+    //! Worker tasks can be waited on from any thread, GUI tasks only from the GUI thread.
+    void wait(const char *name);
+
+    //! runs the task after the first window painted, or now if one did already
+    void whenInteractive(const char *name, std::function<void()> task);
+    //! the first paint of the window makes the application interactive
+    void watch(QWidget *window);
+    //! for runs without windows, releases the deferred tasks
+    void setInteractive();
+    bool isInteractive() const;
+
+signals:
+    void interactive();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit Startup(QObject *parent = nullptr);
+
+    enum State {
+        Pending = 0,
+        Running,
+        Done
+    };
+
+    struct Task {
+        const char *name = nullptr;
+        Thread thread = Gui;
+        std::function<void()> function;
+        QVector<QByteArray> dependencies;
+        State state = Pending;
+        bool queued = false;  // GUI task waiting for the event loop
+        qint64 start = 0;
+        qint64 end = 0;
+        QFuture<void> future;
+    };
+
+    //! starts every pending task whose dependencies finished, GUI thread only
+    void schedule();
+    bool isReady(const Task &task) const;
+    void launch(Task &task);
+    void runOnGuiThread(const QByteArray &key);
+    void finished(const QByteArray &key, qint64 start, qint64 end);
+
+    static QPointer<Startup> m_instance;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_taskFinished;
+    QHash<QByteArray, Task> m_tasks;
+
+    QVector<QPair<const char*, std::function<void()>>> m_deferred;
+    bool m_interactive = false;
+    bool m_paintSeen = false;
+    qint64 m_interactiveAt = 0;
+};
+
+inline Startup* startup()
+{
+    return Startup::instance();
+}
+
+#endif //FEATHER_STARTUP_H
@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "SyncTelemetry.h"
+
+#include <QDateTime>
+#include <QJsonDocument>
+
+#include <cmath>
+
+#include "constants.h"
+#include "libwalletqt/Wallet.h"
+#include "utils/config.h"
+#include "utils/Logger.h"
+
+QJsonObject NodeSyncStats::toJson() const {
+    QJsonObject obj;
+    obj["blocks"] = static_cast<double>(blocks);
+    obj["bytes"] = static_cast<double>(bytes);
+    obj["seconds"] = seconds;
+    obj["network_seconds"] = networkSeconds;
+    obj["scan_seconds"] = scanSeconds;
+    obj["sessions"] = sessions;
+    obj["last_seen"] = lastSeen;
+    return obj;
+}
+
+NodeSyncStats NodeSyncStats::fromJson(const QJsonObject &obj) {
+    NodeSyncStats stats;
+    stats.blocks = static_cast<quint64>(obj.value("blocks").toDouble());
+    stats.bytes = static_cast<quint64>(obj.value("bytes").toDouble());
+    stats.seconds = obj.value("seconds").toDouble();
+    stats.networkSeconds = obj.value("network_seconds").toDouble();
+    stats.scanSeconds = obj.value("scan_seconds").toDouble();
+    stats.sessions = obj.value("sessions").toInt();
+    stats.lastSeen = obj.value("last_seen").toInteger();
+    return stats;
+}
+
+namespace {
+    NodeSyncStats merged(NodeSyncStats stats, const NodeSyncStats &other) {
+        stats.blocks += other.blocks;
+        stats.bytes += other.bytes;
+        stats.seconds += other.seconds;
+        stats.networkSeconds += other.networkSeconds;
+        stats.scanSeconds += other.scanSeconds;
+        stats.sessions += other.sessions;
+        stats.lastSeen = std::max(stats.lastSeen, other.lastSeen);
+        return stats;
+    }
+
+    QString formatDuration(qint64 seconds) {
+        if (seconds < 60) {
+            return QString("%1s").arg(seconds);
+        }
+        if (seconds < 3600) {
+            return QString("%1m").arg(seconds / 60);
+        }
+        return QString("%1h %2m").arg(QString::number(seconds / 3600), QString::number((seconds % 3600) / 60));
+    }
+}
+
+SyncTelemetry::SyncTelemetry(Wallet *wallet, QObject *parent)
+        : QObject(parent)
+        , m_wallet(wallet)
+{
+    connect(m_wallet, &Wallet::syncStatus, this, &SyncTelemetry::onSyncStatus);
+    connect(m_wallet, &Wallet::connectionStatusChanged, this, [this](int status) {
+        if (status == Wallet::ConnectionStatus_Disconnected && m_syncing) {
+            this->finish();
+        }
+    });
+    connect(&m_sampleTimer, &QTimer::timeout, this, &SyncTelemetry::sample);
+}
+
+void SyncTelemetry::setNode(const QString &address, const QString &cacheRoute) {
+    if (address == m_node && cacheRoute == m_cacheRoute) {
+        return;
+    }
+
+    if (m_syncing) {
+        this->finish();
+    }
+    m_node = address;
+    m_cacheRoute = cacheRoute;
+}
+
+qint64 SyncTelemetry::eta() const {
+    if (!m_syncing || m_blocksPerSecond <= 0 || m_target <= m_height) {
+        return -1;
+    }
+    return static_cast<qint64>((m_target - m_height) / m_blocksPerSecond);
+}
+
+QString SyncTelemetry::summary() const {
+    if (!m_syncing || m_blocksPerSecond <= 0) {
+        return {};
+    }
+
+    QString text = QString("%1 blocks/s").arg(QString::number(m_blocksPerSecond, 'f', m_blocksPerSecond < 10 ? 1 : 0));
+    qint64 remaining = this->eta();
+    if (remaining >= 0) {
+        text += QString(", ETA %1").arg(formatDuration(remaining));
+    }
+    return text;
+}
+
+NodeSyncStats SyncTelemetry::stats(const QString &address) const {
+    QJsonObject nodes = loadAll().value(QString::number(constants::networkType)).toObject();
+    NodeSyncStats stats = NodeSyncStats::fromJson(nodes.value(address).toObject());
+    if (address == m_node) {
+        stats = merged(stats, m_unsaved);
+    }
+    return stats;
+}
+
+QMap<QString, NodeSyncStats> SyncTelemetry::allStats() const {
+    QMap<QString, NodeSyncStats> result;
+
+    QJsonObject nodes = loadAll().value(QString::number(constants::networkType)).toObject();
+    for (auto it = nodes.constBegin(); it != nodes.constEnd(); ++it) {
+        result[it.key()] = NodeSyncStats::fromJson(it.value().toObject());
+    }
+    if (!m_node.isEmpty() && m_unsaved.seconds > 0) {
+        result[m_node] = merged(result.value(m_node), m_unsaved);
+    }
+
+    return result;
+}
+
+void SyncTelemetry::onSyncStatus(quint64 height, quint64 target, bool daemonSync) {
+    if (daemonSync) {
+        // The node itself is still syncing, it isn't serving us blocks
+        return;
+    }
+
+    m_height = height;
+    m_target = target;
+
+    if (height >= (target - 1)) {
+        if (m_syncing) {
+            this->sample();
+            this->finish();
+        }
+        return;
+    }
+
+    if (!m_syncing) {
+        this->begin();
+    }
+}
+
+void SyncTelemetry::begin() {
+    m_syncing = true;
+    m_session = {};
+    m_unsaved = {};
+    m_session.sessions = 1;
+    m_unsaved.sessions = 1;
+
+    m_blocksPerSecond = 0;
+    m_bytesPerBlock = 0;
+    m_samplesSincePersist = 0;
+
+    m_lastHeight = m_height;
+    m_lastBytes = m_wallet->getBytesReceived();
+    m_lastHits = this->cacheHits();
+    m_unclaimedHits = {};
+    m_lastSampleTime.start();
+    m_sampleTimer.start(sampleInterval);
+
+    qCDebug(lcNetwork) << "Sync telemetry started at height" << m_height << "for" << m_node;
+}
+
+void SyncTelemetry::sample() {
+    const double seconds = m_lastSampleTime.restart() / 1000.0;
+    if (seconds <= 0) {
+        return;
+    }
+
+    const quint64 bytes = m_wallet->getBytesReceived();
+    const quint64 blocks = (m_height > m_lastHeight) ? m_height - m_lastHeight : 0;
+    // The counter starts over when the wallet reconnects
+    const quint64 received = (bytes >= m_lastBytes) ? bytes - m_lastBytes : bytes;
+    m_lastHeight = m_height;
+    m_lastBytes = bytes;
+
+    // Blocks the block cache served were not downloaded from the node, so they don't count toward its stats.
+    // The wallet scans them a little after they were served, hits not matched yet carry over to the next sample.
+    const BlockCacheProxy::CacheHits hits = this->cacheHits();
+    m_unclaimedHits.bytes += (hits.bytes >= m_lastHits.bytes) ? hits.bytes - m_lastHits.bytes : hits.bytes;
+    m_unclaimedHits.blocks += (hits.blocks >= m_lastHits.blocks) ? hits.blocks - m_lastHits.blocks : hits.blocks;
+    m_lastHits = hits;
+
+    const quint64 cachedBytes = std::min(received, m_unclaimedHits.bytes);
+    const quint64 cachedBlocks = std::min(blocks, m_unclaimedHits.blocks);
+    m_unclaimedHits.bytes -= cachedBytes;
+    m_unclaimedHits.blocks -= cachedBlocks;
+
+    // Time spent scanning cached blocks is left out in proportion
+    const double nodeSeconds = (blocks > 0) ? seconds * (blocks - cachedBlocks) / blocks : seconds;
+    if (cachedBlocks < blocks || blocks == 0) {
+        this->record(nodeSeconds, blocks - cachedBlocks, received - cachedBytes);
+    }
+
+    const double alpha = 1 - std::exp(-seconds / smoothingSeconds);
+    const double rate = blocks / seconds;
+    m_blocksPerSecond = (m_blocksPerSecond > 0) ? m_blocksPerSecond + alpha * (rate - m_blocksPerSecond) : rate;
+    if (blocks > 0) {
+        const double perBlock = static_cast<double>(received) / blocks;
+        m_bytesPerBlock = (m_bytesPerBlock > 0) ? m_bytesPerBlock + alpha * (perBlock - m_bytesPerBlock) : perBlock;
+    }
+
+    // Long syncs are written out once a minute, so a crash doesn't lose them
+    if (++m_samplesSincePersist >= 60) {
+        this->persist();
+    }
+
+    emit updated();
+}
+
+void SyncTelemetry::record(double seconds, quint64 blocks, quint64 bytes) {
+    for (NodeSyncStats *stats : {&m_session, &m_unsaved}) {
+        stats->seconds += seconds;
+        stats->blocks += blocks;
+        stats->bytes += bytes;
+        if (blocks > 0) {
+            stats->scanSeconds += seconds;
+        } else {
+            stats->networkSeconds += seconds;
+        }
+    }
+}
+
+void SyncTelemetry::finish() {
+    m_sampleTimer.stop();
+    this->persist();
+    m_syncing = false;
+
+    qCDebug(lcNetwork) << "Sync telemetry:" << m_session.blocks << "blocks in" << m_session.seconds << "s from" << m_node
+                       << "network:" << m_session.networkSeconds << "s scanning:" << m_session.scanSeconds << "s";
+    emit updated();
+}
+
+void SyncTelemetry::persist() {
+    m_samplesSincePersist = 0;
+
+    if (m_node.isEmpty() || m_unsaved.seconds <= 0) {
+        return;
+    }
+
+    m_unsaved.lastSeen = QDateTime::currentSecsSinceEpoch();
+
+    QJsonObject all = loadAll();
+    QString networkType = QString::number(constants::networkType);
+    QJsonObject nodes = all.value(networkType).toObject();
+    nodes[m_node] = merged(NodeSyncStats::fromJson(nodes.value(m_node).toObject()), m_unsaved).toJson();
+    all[networkType] = nodes;
+    conf()->set(Config::syncTelemetry, all);
+
+    m_unsaved = {};
+}
+
+BlockCacheProxy::CacheHits SyncTelemetry::cacheHits() const {
+    if (m_cacheRoute.isEmpty() || !BlockCacheProxy::isRunning()) {
+        return {};
+    }
+    return blockCacheProxy()->cacheHits(m_cacheRoute);
+}
+
+QJsonObject SyncTelemetry::loadAll() {
+    QVariant value = conf()->get(Config::syncTelemetry);
+
+    QJsonObject obj = value.toJsonObject();
+    if (obj.isEmpty()) {
+        obj = QJsonObject::fromVariantMap(value.toMap());
+    }
+    if (obj.isEmpty()) {
+        obj = QJsonDocument::fromJson(value.toByteArray()).object();
+    }
+    return obj;
+}
+
+SyncTelemetry::~SyncTelemetry() {
+    if (m_syncing) {
+        m_sampleTimer.stop();
+        this->persist();
+    }
+}
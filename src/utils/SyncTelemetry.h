@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_SYNCTELEMETRY_H
+#define FEATHER_SYNCTELEMETRY_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+
+#include "utils/BlockCacheProxy.h"
+
+class Wallet;
+
+// Accumulated sync performance of a single node
+struct NodeSyncStats
+{
+    quint64 blocks = 0;
+    quint64 bytes = 0;
+    double seconds = 0;
+    double networkSeconds = 0;  // no blocks were scanned, waiting on the node
+    double scanSeconds = 0;
+    int sessions = 0;
+    qint64 lastSeen = 0;
+
+    double blocksPerSecond() const { return seconds > 0 ? blocks / seconds : 0; }
+    double bytesPerBlock() const { return blocks > 0 ? static_cast<double>(bytes) / blocks : 0; }
+
+    QJsonObject toJson() const;
+    static NodeSyncStats fromJson(const QJsonObject &obj);
+};
+
+// Measures wallet synchronization while it happens and keeps a log of how each node performed.
+//
+// Fed by Wallet::syncStatus and the wallet's received bytes counter, sampled once per second while the wallet is
+// behind. Rates are exponentially smoothed. Seconds in which the wallet height advanced count as scanning, the others
+// as waiting on the network. Totals are stored per node address in the config, so nodes can be compared across
+// sessions. Blocks served by the block cache are left out of the node's totals.
+class SyncTelemetry : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SyncTelemetry(Wallet *wallet, QObject *parent = nullptr);
+    ~SyncTelemetry() override;
+
+    //! the node blocks are being downloaded from, ends the current measurement.
+    //! cacheRoute is the BlockCacheProxy route the wallet connects through, if any.
+    void setNode(const QString &address, const QString &cacheRoute = {});
+
+    bool isSyncing() const { return m_syncing; }
+    double blocksPerSecond() const { return m_blocksPerSecond; }
+    double bytesPerBlock() const { return m_bytesPerBlock; }
+    //! seconds until synchronized, -1 if unknown
+    qint64 eta() const;
+    double networkSeconds() const { return m_session.networkSeconds; }
+    double scanSeconds() const { return m_session.scanSeconds; }
+
+    //! e.g. "120 blocks/s, ETA 5m"
+    QString summary() const;
+
+    NodeSyncStats stats(const QString &address) const;
+    QMap<QString, NodeSyncStats> allStats() const;
+
+    static constexpr int sampleInterval = 1000;
+    static constexpr double smoothingSeconds = 30;
+
+signals:
+    void updated();
+
+private:
+    void onSyncStatus(quint64 height, quint64 target, bool daemonSync);
+    void begin();
+    void sample();
+    void finish();
+    void persist();
+    void record(double seconds, quint64 blocks, quint64 bytes);
+    BlockCacheProxy::CacheHits cacheHits() const;
+
+    static QJsonObject loadAll();
+
+    Wallet *m_wallet;
+    QTimer m_sampleTimer;
+    QString m_node;
+    QString m_cacheRoute;
+
+    bool m_syncing = false;
+    quint64 m_height = 0;
+    quint64 m_target = 0;
+
+    QElapsedTimer m_lastSampleTime;
+    quint64 m_lastHeight = 0;
+    quint64 m_lastBytes = 0;
+    BlockCacheProxy::CacheHits m_lastHits;
+    BlockCacheProxy::CacheHits m_unclaimedHits;  // served by the cache, not yet seen in the wallet height
+    int m_samplesSincePersist = 0;
+
+    double m_blocksPerSecond = 0;
+    double m_bytesPerBlock = 0;
+
+    NodeSyncStats m_session;  // current sync
+    NodeSyncStats m_unsaved;  // part of the current sync not yet written to the config
+};
+
+#endif //FEATHER_SYNCTELEMETRY_H
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "TorControl.h"
+
+#include <QFile>
+#include <QRegularExpression>
+
+#include "utils/Logger.h"
+
+TorControl::TorControl(QObject *parent)
+        : QObject(parent)
+        , m_socket(new QTcpSocket(this))
+{
+    m_reconnectTimer.setSingleShot(true);
+    m_reconnectTimer.setInterval(reconnectInterval);
+    connect(&m_reconnectTimer, &QTimer::timeout, [this] {
+        if (m_running && m_state == Disconnected) {
+            this->setState(Connecting);
+            m_socket->connectToHost(m_host, m_port);
+        }
+    });
+
+    connect(m_socket, &QTcpSocket::connected, this, &TorControl::onConnected);
+    connect(m_socket, &QTcpSocket::readyRead, this, &TorControl::onReadyRead);
+    connect(m_socket, &QTcpSocket::disconnected, this, &TorControl::onDisconnected);
+    connect(m_socket, &QTcpSocket::errorOccurred, this, &TorControl::onSocketError);
+}
+
+void TorControl::start(const QString &host, quint16 port) {
+    if (m_running && m_host == host && m_port == port) {
+        return;
+    }
+
+    this->stop();
+
+    m_host = host;
+    m_port = port;
+    m_running = true;
+
+    qCDebug(lcNetwork) << "Connecting to Tor control port" << QString("%1:%2").arg(host, QString::number(port));
+    this->setState(Connecting);
+    m_socket->connectToHost(m_host, m_port);
+}
+
+void TorControl::stop() {
+    m_running = false;
+    m_reconnectTimer.stop();
+    m_socket->abort();
+    m_handlers.clear();
+    m_reply = {};
+    m_dataBlock = false;
+    this->setState(Disconnected);
+}
+
+void TorControl::setState(State state) {
+    if (m_state == state) {
+        return;
+    }
+    m_state = state;
+    emit stateChanged(state);
+}
+
+void TorControl::send(const QByteArray &command, ReplyHandler handler) {
+    // Replies arrive in the order the commands were sent
+    m_handlers.enqueue(std::move(handler));
+    m_socket->write(command + "\r\n");
+}
+
+void TorControl::onConnected() {
+    this->setState(Authenticating);
+    this->send("PROTOCOLINFO 1", [this](const Reply &reply) {
+        this->onProtocolInfo(reply);
+    });
+}
+
+void TorControl::onReadyRead() {
+    while (m_socket->canReadLine()) {
+        QString line = QString::fromUtf8(m_socket->readLine()).trimmed();
+
+        if (m_dataBlock) {
+            // Data blocks end with a single dot, none of the keys we ask for need their content
+            m_dataBlock = (line != ".");
+            continue;
+        }
+
+        if (line.size() < 4) {
+            continue;
+        }
+
+        int code = line.left(3).toInt();
+        QChar separator = line.at(3);
+        QString content = line.mid(4);
+
+        if (separator == '+') {
+            m_dataBlock = true;
+        }
+
+        if (code == 650) {
+            if (separator == ' ') {
+                this->onEvent(content);
+            }
+            continue;
+        }
+
+        m_reply.code = code;
+        m_reply.lines.append(content);
+
+        if (separator != ' ') {
+            continue;
+        }
+
+        Reply reply = m_reply;
+        m_reply = {};
+        if (m_handlers.isEmpty()) {
+            qCDebug(lcNetwork) << "Unexpected Tor control reply:" << line;
+            continue;
+        }
+        m_handlers.dequeue()(reply);
+    }
+}
+
+void TorControl::onDisconnected() {
+    m_handlers.clear();
+    m_reply = {};
+    m_dataBlock = false;
+    m_builtCircuits.clear();
+    this->setState(Disconnected);
+
+    if (m_running) {
+        m_reconnectTimer.start();
+    }
+}
+
+void TorControl::onSocketError(QAbstractSocket::SocketError socketError) {
+    Q_UNUSED(socketError)
+
+    if (m_state == Connecting) {
+        // No disconnected() follows a failed connection attempt
+        this->setState(Disconnected);
+        emit error(QString("Unable to connect to Tor control port: %1").arg(m_socket->errorString()));
+        if (m_running) {
+            m_reconnectTimer.start();
+        }
+    }
+}
+
+void TorControl::onProtocolInfo(const Reply &reply) {
+    if (reply.code != 250) {
+        this->fail(QString("PROTOCOLINFO failed: %1").arg(reply.lines.join(" ")));
+        return;
+    }
+
+    QStringList methods;
+    QString cookieFile;
+    static const QRegularExpression methodsRe{R"(METHODS=(\S+))"};
+    static const QRegularExpression cookieRe{R"re(COOKIEFILE="((?:[^"\\]|\\.)*)")re"};
+    for (const auto &line : reply.lines) {
+        if (!line.startsWith("AUTH ")) {
+            continue;
+        }
+        auto match = methodsRe.match(line);
+        if (match.hasMatch()) {
+            methods = match.captured(1).split(",");
+        }
+        match = cookieRe.match(line);
+        if (match.hasMatch()) {
+            cookieFile = match.captured(1).replace(R"(\")", R"(")").replace(R"(\\)", R"(\)");
+        }
+    }
+
+    QByteArray command = "AUTHENTICATE";
+    if (methods.contains("NULL")) {
+        // No authentication required
+    }
+    else if (methods.contains("COOKIE") && !cookieFile.isEmpty()) {
+        QFile file{cookieFile};
+        if (!file.open(QIODevice::ReadOnly)) {
+            this->fail(QString("Unable to read Tor control cookie: %1").arg(cookieFile));
+            return;
+        }
+        command += " " + file.readAll().toHex();
+    }
+    else {
+        this->fail(QString("Unsupported Tor control authentication: %1").arg(methods.join(",")));
+        return;
+    }
+
+    this->send(command, [this](const Reply &reply) {
+        this->onAuthenticated(reply);
+    });
+}
+
+void TorControl::onAuthenticated(const Reply &reply) {
+    if (reply.code != 250) {
+        this->fail(QString("Tor control authentication failed: %1").arg(reply.lines.join(" ")));
+        return;
+    }
+
+    this->send("SETEVENTS STATUS_CLIENT CIRC", [this](const Reply &reply) {
+        if (reply.code != 250) {
+            this->fail(QString("Unable to subscribe to Tor events: %1").arg(reply.lines.join(" ")));
+            return;
+        }
+        this->setState(Ready);
+    });
+
+    // Events only report changes, fetch the current state once
+    this->send("GETINFO status/bootstrap-phase status/circuit-established", [this](const Reply &reply) {
+        if (reply.code != 250) {
+            return;
+        }
+        for (const auto &line : reply.lines) {
+            if (line.startsWith("status/bootstrap-phase=")) {
+                this->onBootstrapStatus(line.mid(line.indexOf('=') + 1));
+            }
+            else if (line.startsWith("status/circuit-established=")) {
+                this->setCircuitEstablished(line.endsWith("=1"));
+            }
+        }
+    });
+}
+
+void TorControl::onEvent(const QString &line) {
+    QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+    if (parts.isEmpty()) {
+        return;
+    }
+
+    if (parts[0] == "STATUS_CLIENT" && parts.size() >= 3) {
+        const QString &action = parts[2];
+        if (action == "BOOTSTRAP") {
+            this->onBootstrapStatus(line.mid(line.indexOf(' ') + 1));
+        }
+        else if (action == "CIRCUIT_ESTABLISHED") {
+            this->setCircuitEstablished(true);
+        }
+        else if (action == "CIRCUIT_NOT_ESTABLISHED") {
+            this->setCircuitEstablished(false);
+        }
+        return;
+    }
+
+    if (parts[0] == "CIRC" && parts.size() >= 3) {
+        const QString &circuitId = parts[1];
+        const QString &status = parts[2];
+        if (status == "BUILT") {
+            m_builtCircuits.insert(circuitId);
+            this->setCircuitEstablished(true);
+        }
+        else if (status == "FAILED" || status == "CLOSED") {
+            m_builtCircuits.remove(circuitId);
+        }
+    }
+}
+
+void TorControl::onBootstrapStatus(const QString &status) {
+    // e.g. NOTICE BOOTSTRAP PROGRESS=75 TAG=enough_dirinfo SUMMARY="Loaded enough directory info to build circuits"
+    static const QRegularExpression progressRe{R"(PROGRESS=(\d+))"};
+    static const QRegularExpression summaryRe{R"re(SUMMARY="([^"]*)")re"};
+
+    auto match = progressRe.match(status);
+    if (!match.hasMatch()) {
+        return;
+    }
+    int progress = match.captured(1).toInt();
+
+    QString summary;
+    match = summaryRe.match(status);
+    if (match.hasMatch()) {
+        summary = match.captured(1);
+    }
+
+    m_bootstrapProgress = progress;
+    emit bootstrapProgressChanged(progress, summary);
+}
+
+void TorControl::setCircuitEstablished(bool established) {
+    if (m_circuitEstablished == established) {
+        return;
+    }
+    m_circuitEstablished = established;
+    emit circuitEstablishedChanged(established);
+}
+
+void TorControl::fail(const QString &message) {
+    qWarning() << message;
+    emit error(message);
+
+    // Authentication problems don't go away by retrying
+    m_running = false;
+    m_socket->abort();
+    this->setState(Disconnected);
+}
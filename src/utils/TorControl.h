@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TORCONTROL_H
+#define FEATHER_TORCONTROL_H
+
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <functional>
+
+// Asynchronous client for the Tor control protocol.
+//
+// Authenticates with the control port (null or cookie authentication), subscribes to bootstrap and circuit events and
+// reports them as they arrive, so nothing has to poll the SOCKS port. Reconnects on its own until stop() is called.
+class TorControl : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum State {
+        Disconnected = 0,
+        Connecting,
+        Authenticating,
+        Ready
+    };
+    Q_ENUM(State)
+
+    explicit TorControl(QObject *parent = nullptr);
+
+    void start(const QString &host, quint16 port);
+    void stop();
+
+    State state() const { return m_state; }
+    bool isReady() const { return m_state == Ready; }
+
+    int bootstrapProgress() const { return m_bootstrapProgress; }
+    bool circuitEstablished() const { return m_circuitEstablished; }
+    int circuitCount() const { return m_builtCircuits.size(); }
+
+    static constexpr int reconnectInterval = 5000;
+
+signals:
+    void stateChanged(TorControl::State state);
+    void bootstrapProgressChanged(int progress, const QString &summary);
+    void circuitEstablishedChanged(bool established);
+    void error(const QString &message);
+
+private:
+    struct Reply {
+        int code = 0;
+        QStringList lines;
+    };
+    using ReplyHandler = std::function<void(const Reply &reply)>;
+
+    void setState(State state);
+    void send(const QByteArray &command, ReplyHandler handler);
+
+    void onConnected();
+    void onReadyRead();
+    void onDisconnected();
+    void onSocketError(QAbstractSocket::SocketError socketError);
+
+    void onProtocolInfo(const Reply &reply);
+    void onAuthenticated(const Reply &reply);
+    void onEvent(const QString &line);
+    void onBootstrapStatus(const QString &status);
+
+    void setCircuitEstablished(bool established);
+    void fail(const QString &message);
+
+    QTcpSocket *m_socket;
+    QTimer m_reconnectTimer;
+
+    QString m_host;
+    quint16 m_port = 0;
+    bool m_running = false;
+
+    State m_state = Disconnected;
+    QQueue<ReplyHandler> m_handlers;
+    Reply m_reply;
+    bool m_dataBlock = false;
+
+    int m_bootstrapProgress = 0;
+    bool m_circuitEstablished = false;
+    QSet<QString> m_builtCircuits;
+};
+
+#endif //FEATHER_TORCONTROL_H
@@ -7,6 +7,7 @@
 #include <QDirIterator>
 
 #include "utils/config.h"
+#include "utils/Startup.h"
 #include "utils/Utils.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
@@ -15,9 +16,19 @@ TorManager::TorManager(QObject *parent)
     : QObject(parent)
     , m_checkConnectionTimer(new QTimer(this))
     , m_process(new QProcess(this))
+    , m_control(new TorControl(this))
+    , m_tailsCheck(new QProcess(this))
 {
     connect(m_checkConnectionTimer, &QTimer::timeout, this, &TorManager::checkConnection);
 
+    connect(m_control, &TorControl::stateChanged, this, &TorManager::onControlStateChanged);
+    connect(m_control, &TorControl::bootstrapProgressChanged, this, &TorManager::onBootstrapProgress);
+    connect(m_control, &TorControl::circuitEstablishedChanged, this, &TorManager::setConnectionState);
+
+    connect(m_tailsCheck, &QProcess::finished, [this](int exitCode, QProcess::ExitStatus exitStatus) {
+        this->setConnectionState(exitStatus == QProcess::NormalExit && exitCode == 0);
+    });
+
     this->torDir = Config::defaultConfigDir().filePath("tor");
 #if defined(TOR_INSTALLED)
     // When installed, use directory relative to application path.
@@ -42,6 +53,7 @@ TorManager::TorManager(QObject *parent)
 QPointer<TorManager> TorManager::m_instance(nullptr);
 
 void TorManager::init() {
+    m_control->stop();
     m_localTor = !shouldStartTorDaemon();
 
     auto state = m_process->state();
@@ -54,6 +66,7 @@ void TorManager::init() {
 }
 
 void TorManager::stop() {
+    m_control->stop();
     m_process->kill();
     m_started = false;
 }
@@ -62,6 +75,7 @@ void TorManager::start() {
     m_checkConnectionTimer->start(5000);
 
     if (m_localTor) {
+        this->startControl();
         this->checkConnection();
         return;
     }
@@ -99,6 +113,14 @@ void TorManager::start() {
     arguments << "--Log" << "notice";
     arguments << "--pidfile" << QDir(this->torDataPath).filePath("tor.pid");
 
+    // Tor picks a free control port and writes it to a file, see startControl()
+    QString controlPortFile = QDir(this->torDataPath).filePath("control_port");
+    QFile::remove(controlPortFile);
+    arguments << "--ControlPort" << "auto";
+    arguments << "--ControlPortWriteToFile" << controlPortFile;
+    arguments << "--CookieAuthentication" << "1";
+    arguments << "--CookieAuthFile" << QDir(this->torDataPath).filePath("control_auth_cookie");
+
     qDebug() << QString("%1 %2").arg(this->torPath, arguments.join(" "));
 
     m_process->start(this->torPath, arguments);
@@ -116,27 +138,100 @@ void TorManager::checkConnection() {
     }
 
     else if (TailsOS::detect()) {
+        if (m_tailsCheck->state() != QProcess::NotRunning) {
+            return;
+        }
         QStringList args = QStringList() << "--quiet" << "is-active" << "tails-tor-has-bootstrapped.target";
-        int code = QProcess::execute("/bin/systemctl", args);
-
-        this->setConnectionState(code == 0);
+        m_tailsCheck->start("/bin/systemctl", args);
     }
 
     else if (conf()->get(Config::proxy).toInt() != Config::Proxy::Tor) {
         this->setConnectionState(false);
     }
 
+    else if (m_control->isReady()) {
+        // Kept up to date by control port events
+        return;
+    }
+
     else if (m_localTor && !m_alreadyRunning) {
         QString host = conf()->get(Config::socks5Host).toString();
         quint16 port = conf()->get(Config::socks5Port).toString().toUShort();
-        this->setConnectionState(Utils::portOpen(host, port));
+        this->probePort(host, port);
     }
 
     else {
-        this->setConnectionState(Utils::portOpen(featherTorHost, featherTorPort));
+        // Tor may log the control listener before it writes control_port, keep trying until the control port is up
+        if (m_process->state() == QProcess::Running) {
+            this->startControl();
+        }
+        this->probePort(featherTorHost, featherTorPort);
+    }
+}
+
+void TorManager::probePort(const QString &host, quint16 port) {
+    if (m_probing) {
+        return;
+    }
+
+    m_probing = true;
+    Utils::portOpenAsync(this, host, port, [this](bool open) {
+        m_probing = false;
+        if (!m_control->isReady()) {
+            this->setConnectionState(open);
+        }
+    });
+}
+
+void TorManager::startControl() {
+    // Connection state comes from the environment here, and Tails filters the control port
+    if (Utils::isTorsocks() || WhonixOS::detect() || TailsOS::detect()) {
+        return;
+    }
+
+    if (conf()->get(Config::proxy).toInt() != Config::Proxy::Tor) {
+        return;
+    }
+
+    if (!m_localTor) {
+        QFile file{QDir(this->torDataPath).filePath("control_port")};
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+
+        // PORT=127.0.0.1:39411
+        QString address = QString::fromUtf8(file.readAll()).trimmed().section('=', 1);
+        QString host = address.section(':', 0, -2);
+        quint16 port = address.section(':', -1).toUShort();
+        if (host.isEmpty() || port == 0) {
+            return;
+        }
+        m_control->start(host, port);
+    }
+    else if (!m_alreadyRunning) {
+        QString host = conf()->get(Config::socks5Host).toString();
+        quint16 port = conf()->get(Config::torControlPort).toString().toUShort();
+        m_control->start(host, port);
     }
 }
 
+void TorManager::onControlStateChanged(TorControl::State state) {
+    if (state == TorControl::Ready) {
+        qInfo() << "Connected to Tor control port";
+        this->setConnectionState(m_control->circuitEstablished());
+    }
+    else if (state == TorControl::Disconnected) {
+        // Fall back to probing the SOCKS port
+        this->checkConnection();
+    }
+}
+
+void TorManager::onBootstrapProgress(int progress, const QString &summary) {
+    this->bootstrapProgress = progress;
+    this->bootstrapSummary = summary;
+    emit bootstrapProgressChanged(progress, summary);
+}
+
 void TorManager::setConnectionState(bool connected) {
     this->torConnected = connected;
     emit connectionStateChanged(connected);
@@ -168,6 +263,10 @@ void TorManager::handleProcessOutput() {
         this->setConnectionState(true);
     }
 
+    if (output.contains(QByteArray("Opened Control listener"))) {
+        this->startControl();
+    }
+
     qDebug() << output;
 }
 
@@ -180,36 +279,81 @@ void TorManager::handleProcessError(QProcess::ProcessError error) {
     }
 }
 
+void TorManager::prepare() {
+    if (m_unpacked || m_preparing) {
+        return;
+    }
+
+    // Same conditions as shouldStartTorDaemon(), minus the port checks which are done when Tor is started
+    bool needed = !Utils::isTorsocks() && !TailsOS::detect() && !WhonixOS::detect()
+                  && conf()->get(Config::proxy).toInt() == Config::Proxy::Tor
+                  && !conf()->get(Config::useLocalTor).toBool();
+#if !defined(HAS_TOR_BIN) && !defined(TOR_INSTALLED)
+    needed = false;
+#endif
+    m_preparing = needed;
+
+    // Added either way, the network setup depends on it
+    const QStringList versionCache = conf()->get(Config::torVersionCache).toStringList();
+    startup()->add("TorManager::unpackBins", Startup::Worker, [this, needed, torDir = this->torDir, versionCache]{
+        if (needed) {
+            m_prepared = unpack(torDir, versionCache);
+        }
+    });
+}
+
 bool TorManager::unpackBins() {
     if (m_unpacked) {
         return true;
     }
 
+    Unpacked result;
+    if (m_preparing) {
+        startup()->wait("TorManager::unpackBins");
+        m_preparing = false;
+        result = m_prepared;
+    } else {
+        result = unpack(this->torDir, conf()->get(Config::torVersionCache).toStringList());
+    }
+
+    this->torPath = result.torPath;
+    conf()->set(Config::torVersionCache, result.versionCache);
+    m_unpacked = result.success;
+    return result.success;
+}
+
+TorManager::Unpacked TorManager::unpack(const QString &torDir, QStringList versionCache) {
+    Unpacked result;
+    result.versionCache = versionCache;
+
     QString torBin = "tor";
 #if defined(Q_OS_WIN)
    torBin += ".exe";
 #endif
 
-    this->torPath = QDir(this->torDir).filePath(torBin);
+    result.torPath = QDir(torDir).filePath(torBin);
+    const QString &torPath = result.torPath;
 
 #if defined(TOR_INSTALLED)
     // We don't need to unpack if Tor was installed using the installer
-    return true;
+    result.success = true;
+    return result;
 #endif
 
     if (QString(FEATHER_TARGET_TRIPLET) == "arm64-apple-darwin" || QString(FEATHER_TARGET_TRIPLET) == "x86_64-apple-darwin") {
-        return true;
+        result.success = true;
+        return result;
     }
 
     SemanticVersion embeddedVersion = SemanticVersion::fromString(QString(TOR_VERSION));
-    SemanticVersion filesystemVersion = this->getVersion(torPath);
+    SemanticVersion filesystemVersion = getVersion(torPath, result.versionCache);
     qDebug() << QString("Tor versions: embedded %1, filesystem %2").arg(embeddedVersion.toString(), filesystemVersion.toString());
     if (SemanticVersion::isValid(filesystemVersion) && (embeddedVersion > filesystemVersion)) {
         qInfo() << "Embedded version is newer, overwriting.";
         QFile::setPermissions(torPath, QFile::ReadOther | QFile::WriteOther);
         if (!QFile::remove(torPath)) {
             qWarning() << "Unable to remove old Tor binary";
-            return false;
+            return result;
         }
     }
 
@@ -219,21 +363,21 @@ bool TorManager::unpackBins() {
             QString assetFile = it.next();
             QFileInfo assetFileInfo = QFileInfo(assetFile);
             QFile f(assetFile);
-            QString filePath = QDir(this->torDir).filePath(assetFileInfo.fileName());
+            QString filePath = QDir(torDir).filePath(assetFileInfo.fileName());
             f.copy(filePath);
             f.close();
         }
-        qInfo() << "Wrote Tor binaries to: " << this->torDir;
+        qInfo() << "Wrote Tor binaries to: " << torDir;
     }
 
 #if defined(Q_OS_UNIX)
-    QFile tor(this->torPath);
+    QFile tor(torPath);
     tor.setPermissions(QFile::ExeUser | QFile::ExeGroup | QFile::ExeOther
     | QFile::ReadOwner | QFile::ReadGroup | QFile::ReadOther);
 #endif
 
-    m_unpacked = true;
-    return true;
+    result.success = true;
+    return result;
 }
 
 bool TorManager::isLocalTor() {
@@ -307,11 +451,24 @@ bool TorManager::shouldStartTorDaemon() {
     return true;
 }
 
-SemanticVersion TorManager::getVersion(const QString &fileName) {
+SemanticVersion TorManager::getVersion(const QString &fileName, QStringList &versionCache) {
+    QFileInfo info{fileName};
+    if (!info.isFile()) {
+        return SemanticVersion();
+    }
+
+    QStringList key = {info.absoluteFilePath(),
+                       QString::number(info.lastModified().toMSecsSinceEpoch()),
+                       QString::number(info.size())};
+
+    if (versionCache.size() == 4 && versionCache.mid(0, 3) == key) {
+        return SemanticVersion::fromString(versionCache[3]);
+    }
+
     QProcess process;
     process.setProcessChannelMode(QProcess::MergedChannels);
-    process.start(this->torPath, QStringList() << "--version");
-    process.waitForFinished(-1);
+    process.start(fileName, QStringList() << "--version");
+    process.waitForFinished(5000);
     QString output = process.readAllStandardOutput();
 
     if(output.isEmpty()) {
@@ -319,7 +476,11 @@ SemanticVersion TorManager::getVersion(const QString &fileName) {
         return SemanticVersion();
     }
 
-    return SemanticVersion::fromString(output);
+    SemanticVersion version = SemanticVersion::fromString(output);
+    if (SemanticVersion::isValid(version)) {
+        versionCache = key << version.toString();
+    }
+    return version;
 }
 
 void TorManager::setErrorMessage(const QString &msg) {
@@ -9,6 +9,7 @@
 #include <QTimer>
 
 #include "utils/SemanticVersion.h"
+#include "utils/TorControl.h"
 
 class TorManager : public QObject
 {
@@ -21,15 +22,21 @@ public:
     void init();
     void start();
     void stop();
+    //! starts unpacking the embedded Tor binary on a worker thread if the proxy settings are going to need it
+    void prepare();
+    //! waits for prepare() if it was called, unpacks now otherwise
     bool unpackBins();
     bool isLocalTor();
     bool isStarted();
     bool isAlreadyRunning();
-    SemanticVersion getVersion(const QString &fileName);
+    //! the result is cached by path, size and modification time in versionCache, so Tor is only run when the binary changed
+    static SemanticVersion getVersion(const QString &fileName, QStringList &versionCache);
 
     static TorManager* instance();
 
     bool torConnected = false;
+    int bootstrapProgress = 0;
+    QString bootstrapSummary;
 
     QString featherTorHost = "127.0.0.1";
     quint16 featherTorPort = 19450;
@@ -43,6 +50,7 @@ public:
 
 signals:
     void connectionStateChanged(bool connected);
+    void bootstrapProgressChanged(int progress, const QString &summary);
     void statusChanged(QString reason);
     void logsUpdated();
 
@@ -53,7 +61,20 @@ private slots:
     void checkConnection();
 
 private:
+    struct Unpacked {
+        bool success = false;
+        QString torPath;
+        QStringList versionCache;
+    };
+
+    //! doesn't touch members or the config, so it can run on any thread
+    static Unpacked unpack(const QString &torDir, QStringList versionCache);
+
     bool shouldStartTorDaemon();
+    void startControl();
+    void onControlStateChanged(TorControl::State state);
+    void onBootstrapProgress(int progress, const QString &summary);
+    void probePort(const QString &host, quint16 port);
     void setConnectionState(bool connected);
     void setErrorMessage(const QString &msg);
 
@@ -65,8 +86,13 @@ private:
     bool m_localTor = false;
     bool m_started = false;
     bool m_unpacked = false;
+    bool m_preparing = false;
+    Unpacked m_prepared;  // written by the startup task
     bool m_alreadyRunning = false;
     QTimer *m_checkConnectionTimer;
+    TorControl *m_control;
+    QProcess *m_tailsCheck;
+    bool m_probing = false;
 };
 
 inline TorManager* torManager()
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "Tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSaveFile>
+#include <QThread>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        const char *name;
+        qint64 ts;
+        qint64 dur;
+        char phase;
+    };
+
+    // Each buffer is written by its owning thread only, the dump reads up to the published size.
+    struct ThreadBuffer {
+        static constexpr size_t capacity = 8192;
+
+        std::array<TraceEvent, capacity> events;
+        std::atomic<size_t> size{0};
+        std::atomic<size_t> dropped{0};
+        int tid = 0;
+        bool mainThread = false;
+    };
+
+    const auto processStart = std::chrono::steady_clock::now();
+
+    QString outputPath;
+
+    // Only locked when a thread records its first event and when dumping
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    thread_local ThreadBuffer *threadBuffer = nullptr;
+
+    ThreadBuffer* currentBuffer() {
+        if (threadBuffer) {
+            return threadBuffer;
+        }
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        auto *app = QCoreApplication::instance();
+        buffer->mainThread = !app || QThread::currentThread() == app->thread();
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->tid = static_cast<int>(buffers.size()) + 1;
+        threadBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+        return threadBuffer;
+    }
+
+    void record(const char *name, qint64 ts, qint64 dur, char phase) {
+        ThreadBuffer *buffer = currentBuffer();
+
+        size_t idx = buffer->size.load(std::memory_order_relaxed);
+        if (idx >= ThreadBuffer::capacity) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->events[idx] = {name, ts, dur, phase};
+        buffer->size.store(idx + 1, std::memory_order_release);
+    }
+
+    QByteArray escape(const char *name) {
+        QByteArray out(name);
+        out.replace('\\', "\\\\");
+        out.replace('"', "\\\"");
+        return out;
+    }
+}
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+void Tracer::enable(const QString &path) {
+    outputPath = path;
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+qint64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - processStart).count();
+}
+
+void Tracer::complete(const char *name, qint64 start, qint64 end) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(name, start, end - start, 'X');
+}
+
+void Tracer::instant(const char *name) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(name, now(), 0, 'i');
+}
+
+bool Tracer::dump() {
+    if (!isEnabled() || outputPath.isEmpty()) {
+        return false;
+    }
+
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Unable to write trace to" << outputPath;
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    size_t dropped = 0;
+    bool first = true;
+
+    auto writeEvent = [&file, &first](const QByteArray &event) {
+        if (!first) {
+            file.write(",\n");
+        }
+        first = false;
+        file.write(event);
+    };
+
+    file.write("{\"traceEvents\":[\n");
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const auto &buffer : buffers) {
+        const char *threadName = buffer->mainThread ? "main" : "worker";
+        writeEvent(QString(R"({"name":"thread_name","ph":"M","pid":%1,"tid":%2,"args":{"name":"%3 %2"}})")
+                           .arg(pid).arg(buffer->tid).arg(threadName).toUtf8());
+
+        size_t size = buffer->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; i++) {
+            const TraceEvent &e = buffer->events[i];
+            QByteArray event = QString(R"({"name":"%1","cat":"feather","ph":"%2","ts":%3,"pid":%4,"tid":%5)")
+                    .arg(QString::fromUtf8(escape(e.name))).arg(QChar(e.phase))
+                    .arg(e.ts).arg(pid).arg(buffer->tid).toUtf8();
+            if (e.phase == 'X') {
+                event += QString(R"(,"dur":%1)").arg(e.dur).toUtf8();
+            } else if (e.phase == 'i') {
+                event += R"(,"s":"t")";
+            }
+            event += "}";
+            writeEvent(event);
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+
+    file.write("\n]}\n");
+
+    if (!file.commit()) {
+        qWarning() << "Unable to write trace to" << outputPath;
+        return false;
+    }
+
+    if (dropped > 0) {
+        qWarning() << "Trace buffer full," << dropped << "events were dropped";
+    }
+    qInfo() << "Trace written to" << outputPath;
+    return true;
+}
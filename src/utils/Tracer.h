@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TRACER_H
+#define FEATHER_TRACER_H
+
+#include <QString>
+
+#include <atomic>
+
+// Records named spans into per-thread buffers and writes them out in the
+// Chrome trace_event format (load in chrome://tracing or ui.perfetto.dev).
+//
+// Tracing is always compiled in, but does nothing until enabled with --trace.
+// Span names must be string literals, they are stored by pointer.
+class Tracer
+{
+public:
+    static void enable(const QString &outputPath);
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    //! microseconds since process start
+    static qint64 now();
+
+    static void complete(const char *name, qint64 start, qint64 end);
+    static void instant(const char *name);
+
+    //! writes all recorded events to the output path, returns false on failure
+    static bool dump();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name)
+            : m_name(name)
+            , m_start(Tracer::isEnabled() ? Tracer::now() : -1) {}
+
+        ~Scope() {
+            if (m_start >= 0) {
+                Tracer::complete(m_name, m_start, Tracer::now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char *m_name;
+        qint64 m_start;
+    };
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Tracer::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+#endif //FEATHER_TRACER_H
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_TXPOOLDIFF_H
+#define FEATHER_TXPOOLDIFF_H
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+#include <algorithm>
+
+#include "libwalletqt/rows/TxBacklogEntry.h"
+
+// A pool transaction as far as the daemon's backlog describes it, the backlog doesn't include hashes
+struct PoolTransaction
+{
+    quint64 fee = 0;
+    quint64 weight = 0;
+    qint64 received = 0;  // poll time minus time in pool
+
+    quint64 feePerByte() const { return weight ? fee / weight : 0; }
+};
+
+struct PoolDiff
+{
+    QVector<bool> kept;  // per transaction of the previous poll
+    QVector<PoolTransaction> added;
+    int removed = 0;
+};
+
+//! receive times of the same transaction in consecutive polls may differ by the latency of the requests
+constexpr qint64 poolMatchTolerance = 3;
+
+// Difference between the transactions of a previous poll and a new backlog fetched at pollTime.
+// Transactions are matched by fee and weight, and within a group in order of receive time. Tx needs fee, weight and
+// received members.
+template<typename Tx>
+PoolDiff diffPool(const QVector<Tx> &previous, const QVector<TxBacklogEntry> &entries, qint64 pollTime) {
+    using Key = QPair<quint64, quint64>;  // fee, weight
+
+    QHash<Key, QVector<qint64>> incoming;
+    incoming.reserve(entries.size());
+    for (const auto &entry : entries) {
+        if (entry.weight == 0) {
+            continue;
+        }
+        incoming[{entry.fee, entry.weight}].append(pollTime - static_cast<qint64>(entry.timeInPool));
+    }
+
+    QHash<Key, QVector<int>> existing;
+    existing.reserve(previous.size());
+    for (int i = 0; i < previous.size(); i++) {
+        existing[{previous[i].fee, previous[i].weight}].append(i);
+    }
+
+    PoolDiff diff;
+    diff.kept.fill(false, previous.size());
+    for (auto it = incoming.begin(); it != incoming.end(); ++it) {
+        QVector<qint64> &times = it.value();
+        std::sort(times.begin(), times.end());
+
+        QVector<int> candidates = existing.value(it.key());
+        std::sort(candidates.begin(), candidates.end(), [&previous](int a, int b) {
+            return previous[a].received < previous[b].received;
+        });
+
+        qsizetype c = 0;
+        for (qint64 received : times) {
+            while (c < candidates.size() && previous[candidates[c]].received < received - poolMatchTolerance) {
+                c++;  // left the pool
+            }
+            if (c < candidates.size() && previous[candidates[c]].received <= received + poolMatchTolerance) {
+                diff.kept[candidates[c]] = true;
+                c++;
+                continue;
+            }
+            diff.added.append(PoolTransaction{it.key().first, it.key().second, received});
+        }
+    }
+
+    diff.removed = static_cast<int>(std::count(diff.kept.cbegin(), diff.kept.cend(), false));
+    return diff;
+}
+
+#endif //FEATHER_TXPOOLDIFF_H
@@ -17,14 +17,16 @@
 #include <QThread>
 #include <QStandardPaths>
 #include <QProcess>
+#include <QTimer>
 
 #include "constants.h"
 #include "networktype.h"
-#include "utils/AppData.h"
+#include "utils/RestoreHeightLookup.h"
 #include "utils/ColorScheme.h"
 #include "utils/config.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
+#include "libwalletqt/AddressResolver.h"
 #include "libwalletqt/Wallet.h"
 #include "WindowManager.h"
 
@@ -359,7 +361,7 @@ bool xdgDesktopEntryRegister() {
     return true;
 }
 
-bool portOpen(const QString &hostname, quint16 port) { // TODO: this call should be async
+bool portOpen(const QString &hostname, quint16 port) {
     if (conf()->get(Config::offlineMode).toBool()) {
         return false;
     }
@@ -369,6 +371,38 @@ bool portOpen(const QString &hostname, quint16 port) { // TODO: this call should
     return socket.waitForConnected(600);
 }
 
+void portOpenAsync(QObject *context, const QString &hostname, quint16 port, const std::function<void(bool open)> &callback, int timeout) {
+    if (conf()->get(Config::offlineMode).toBool()) {
+        QTimer::singleShot(0, context, [callback] {
+            callback(false);
+        });
+        return;
+    }
+
+    auto *socket = new QTcpSocket(context);
+    auto finish = [socket, callback](bool open) {
+        if (socket->property("finished").toBool()) {
+            return;
+        }
+        socket->setProperty("finished", true);
+        socket->abort();
+        socket->deleteLater();
+        callback(open);
+    };
+
+    QObject::connect(socket, &QTcpSocket::connected, socket, [finish] {
+        finish(true);
+    });
+    QObject::connect(socket, &QTcpSocket::errorOccurred, socket, [finish] {
+        finish(false);
+    });
+    QTimer::singleShot(timeout, socket, [finish] {
+        finish(false);
+    });
+
+    socket->connectToHost(hostname, port);
+}
+
 quint16 getDefaultRpcPort(NetworkType::Type type) {
     switch (type) {
         case NetworkType::Type::MAINNET:
@@ -540,16 +574,20 @@ QString displayAddress(const QString& address, int sections, const QString& sep)
     return list.join(sep);
 }
 
-QTextCharFormat addressTextFormat(const SubaddressIndex &index, quint64 amount) {
+QTextCharFormat addressTextFormat(const AddressIdentity &identity, quint64 amount) {
     QTextCharFormat rec;
-    if (index.isPrimary()) {
+    if (identity.subaddressIndex.isPrimary()) {
         rec.setBackground(QBrush(ColorScheme::YELLOW.asColor(true)));
         rec.setToolTip("Wallet change/primary address");
     }
-    else if (index.isValid()) {
+    else if (identity.isOwn()) {
         rec.setBackground(QBrush(ColorScheme::GREEN.asColor(true)));
         rec.setToolTip("Wallet receive address");
     }
+    else if (identity.isContact()) {
+        rec.setBackground(QBrush(ColorScheme::BLUE.asColor(true)));
+        rec.setToolTip(QString("Contact: %1").arg(identity.contactLabel));
+    }
     else if (amount == 0) {
         rec.setBackground(QBrush(ColorScheme::GRAY.asColor(true)));
         rec.setToolTip("Dummy output (Min. 2 outs consensus rule)");
@@ -557,35 +595,6 @@ QTextCharFormat addressTextFormat(const SubaddressIndex &index, quint64 amount)
     return rec;
 }
 
-void applicationLogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-    const QString fn = context.function ? QString::fromUtf8(context.function) : "";
-    const QString date = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    QString line;
-
-    switch (type) {
-        case QtDebugMsg:
-            line = QString("[%1 D] %2(:%3) %4\n").arg(date, fn, QString::number(context.line), msg);
-            fprintf(stderr, "%s", line.toLatin1().data());
-            break;
-        case QtInfoMsg:
-            line = QString("[%1 I] %2\n").arg(date, msg);
-            fprintf(stdout, "%s", line.toLatin1().data());
-            break;
-        case QtWarningMsg:
-            line = QString("[%1 W] %2(:%3) %4\n").arg(date, fn, QString::number(context.line), msg);
-            fprintf(stdout, "%s", line.toLatin1().data());
-            break;
-        case QtCriticalMsg:
-            line = QString("[%1 C] %2(:%3) %4\n").arg(date, fn, QString::number(context.line), msg);
-            fprintf(stderr, "%s", line.toLatin1().data());
-            break;
-        case QtFatalMsg:
-            line = QString("[%1 F] %2(:%3) %4\n").arg(date, fn, QString::number(context.line), msg);
-            fprintf(stderr, "%s", line.toLatin1().data());
-            break;
-    }
-}
-
 QString barrayToString(const QByteArray &data) {
     return QString::fromUtf8(data);
 }
@@ -713,7 +722,7 @@ QString formatSyncStatus(quint64 height, quint64 target, bool daemonSync) {
 }
 
 QString formatRestoreHeight(quint64 height) {
-    const QDateTime restoreDate = appData()->restoreHeights[constants::networkType]->heightToDate(height);
+    const QDateTime restoreDate = RestoreHeightLookup::forNetwork(constants::networkType)->heightToDate(height);
     return QString("%1  (%2)").arg(QString::number(height), restoreDate.toString("yyyy-MM-dd"));
 }
 
@@ -11,9 +11,11 @@
 #include <QStandardItem>
 #include <QMetaEnum>
 
+#include <functional>
+
 #include "networktype.h"
 
-class SubaddressIndex;
+struct AddressIdentity;
 
 namespace Utils
 {
@@ -75,6 +77,8 @@ namespace Utils
     bool xdgDesktopEntryRegister();
 
     bool portOpen(const QString &hostname, quint16 port);
+    //! non-blocking portOpen, callback is invoked in the thread of context, unless context is destroyed first
+    void portOpenAsync(QObject *context, const QString &hostname, quint16 port, const std::function<void(bool open)> &callback, int timeout = 600);
     quint16 getDefaultRpcPort(NetworkType::Type type);
     bool isTorsocks();
 
@@ -92,12 +96,11 @@ namespace Utils
     void externalLinkWarning(QWidget *parent, const QString &url);
 
     QString displayAddress(const QString& address, int sections = 3, const QString & sep = " ");
-    QTextCharFormat addressTextFormat(const SubaddressIndex &index, quint64 amount);
+    QTextCharFormat addressTextFormat(const AddressIdentity &identity, quint64 amount);
 
     QFont getMonospaceFont();
     QFont relativeFont(int delta);
 
-    void applicationLogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
     QString barrayToString(const QByteArray &data);
 
     bool isLocalUrl(const QUrl &url);
@@ -40,11 +40,15 @@ static const QHash<Config::ConfigKey, ConfigDirective> configStrings = {
         {Config::walletDirectory,{QS("walletDirectory"), ""}},
         {Config::autoOpenWalletPath,{QS("autoOpenWalletPath"), ""}},
         {Config::recentlyOpenedWallets, {QS("recentlyOpenedWallets"), {}}},
+        {Config::restoreHeightMargin, {QS("restoreHeightMargin"), 60}},
 
         // Nodes
         {Config::nodes,{QS("nodes"), "{}"}},
         {Config::nodeSource,{QS("nodeSource"), 0}},
         {Config::useOnionNodes,{QS("useOnionNodes"), false}},
+        {Config::blockCacheEnabled,{QS("blockCacheEnabled"), false}},
+        {Config::blockCacheSize,{QS("blockCacheSize"), 512}},
+        {Config::syncTelemetry,{QS("syncTelemetry"), "{}"}},
 
         // Tabs
         {Config::enabledTabs, {QS("enabledTabs"), QStringList{"Home", "History", "Send", "Receive", "Calc"}}},
@@ -60,6 +64,7 @@ static const QHash<Config::ConfigKey, ConfigDirective> configStrings = {
         {Config::showChangeAddresses,{QS("showChangeAddresses"), false}},
         {Config::showAddressIndex,{QS("showAddressIndex"), true}},
         {Config::showAddressLabels,{QS("showAddressLabels"), true}},
+        {Config::subaddressPoolSize,{QS("subaddressPoolSize"), 0}},
 
         // Settings
         {Config::lastSettingsPage, {QS("lastSettingsPage"), 0}},
@@ -82,14 +87,21 @@ static const QHash<Config::ConfigKey, ConfigDirective> configStrings = {
         {Config::multiBroadcast, {QS("multiBroadcast"), true}},
         {Config::offlineTxSigningMethod, {QS("offlineTxSigningMethod"), Config::OTSMethod::UnifiedResources}},
         {Config::offlineTxSigningForceKISync, {QS("offlineTxSigningForceKISync"), false}},
+        {Config::offlineTxSigningCompress, {QS("offlineTxSigningCompress"), false}},
         {Config::manualFeeTierSelection, {QS("manualFeeTierSelection"), false}},
         {Config::subtractFeeFromAmount, {QS("subtractFeeFromAmount"), false}},
+        {Config::recordFeeHistory, {QS("recordFeeHistory"), false}},
+        {Config::confirmationDeadline, {QS("confirmationDeadline"), 0}},
+        {Config::cacheOpenAliases, {QS("cacheOpenAliases"), false}},
+        {Config::openAliasCache, {QS("openAliasCache"), "{}"}},
 
         {Config::warnOnExternalLink,{QS("warnOnExternalLink"), true}},
         {Config::hideBalance, {QS("hideBalance"), false}},
         {Config::hideNotifications, {QS("hideNotifications"), false}},
         {Config::hideUpdateNotifications, {QS("hideUpdateNotifications"), false}},
         {Config::disableLogging, {QS("disableLogging"), true}},
+        {Config::logToFile, {QS("logToFile"), false}},
+        {Config::logFilterRules, {QS("logFilterRules"), ""}},
         {Config::writeStackTraceToDisk, {QS("writeStackTraceToDisk"), true}},
         {Config::writeRecentlyOpenedWallets, {QS("writeRecentlyOpenedWallets"), true}},
 
@@ -120,6 +132,8 @@ static const QHash<Config::ConfigKey, ConfigDirective> configStrings = {
         {Config::socks5User, {QS("socks5User"), ""}}, // Unused
         {Config::socks5Pass, {QS("socks5Pass"), ""}}, // Unused
         {Config::torManagedPort, {QS("torManagedPort"), "19450"}},
+        {Config::torControlPort, {QS("torControlPort"), "9051"}},
+        {Config::torVersionCache, {QS("torVersionCache"), QStringList{}}},
         {Config::useLocalTor, {QS("useLocalTor"), false}},
         {Config::initSyncThreshold, {QS("initSyncThreshold"), 360}},
 
@@ -156,6 +170,9 @@ void Config::set(ConfigKey key, const QVariant& value)
     m_settings->setValue(cfg.name, value);
 
     this->sync();
+    if (ConfigSnapshot::covers(key)) {
+        this->updateSnapshot();
+    }
     emit changed(key);
 }
 
@@ -164,6 +181,9 @@ void Config::remove(ConfigKey key)
     auto cfg = configStrings[key];
     m_settings->remove(cfg.name);
 
+    if (ConfigSnapshot::covers(key)) {
+        this->updateSnapshot();
+    }
     emit changed(key);
 }
 
@@ -182,6 +202,59 @@ void Config::sync()
 void Config::resetToDefaults()
 {
     m_settings->clear();
+    this->updateSnapshot();
+}
+
+void Config::updateSnapshot()
+{
+    auto snapshot = std::make_unique<ConfigSnapshot>();
+
+    snapshot->amountPrecision = get(amountPrecision).toInt();
+    snapshot->dateTimeFormat = QString("%1 %2").arg(get(dateFormat).toString(), get(timeFormat).toString());
+
+    snapshot->historyShowFullTxid = get(historyShowFullTxid).toBool();
+
+    snapshot->showUsedAddresses = get(showUsedAddresses).toBool();
+    snapshot->showHiddenAddresses = get(showHiddenAddresses).toBool();
+    snapshot->showChangeAddresses = get(showChangeAddresses).toBool();
+    snapshot->showFullAddresses = get(showFullAddresses).toBool();
+
+    snapshot->nodeSource = get(nodeSource).toInt();
+    snapshot->offlineMode = get(offlineMode).toBool();
+    snapshot->proxy = get(proxy).toInt();
+    snapshot->torPrivacyLevel = get(torPrivacyLevel).toInt();
+    snapshot->torOnlyAllowOnion = get(torOnlyAllowOnion).toBool();
+    snapshot->initSyncThreshold = get(initSyncThreshold).toInt();
+    snapshot->socks5Host = get(socks5Host).toString();
+    snapshot->socks5Port = get(socks5Port).toString();
+
+    m_snapshot.store(snapshot.get(), std::memory_order_release);
+    m_snapshots.push_back(std::move(snapshot));
+}
+
+bool ConfigSnapshot::covers(Config::ConfigKey key)
+{
+    switch (key) {
+        case Config::amountPrecision:
+        case Config::dateFormat:
+        case Config::timeFormat:
+        case Config::historyShowFullTxid:
+        case Config::showUsedAddresses:
+        case Config::showHiddenAddresses:
+        case Config::showChangeAddresses:
+        case Config::showFullAddresses:
+        case Config::nodeSource:
+        case Config::offlineMode:
+        case Config::proxy:
+        case Config::torPrivacyLevel:
+        case Config::torOnlyAllowOnion:
+        case Config::initSyncThreshold:
+        case Config::socks5Host:
+        case Config::socks5Port:
+            return true;
+        default:
+            return false;
+    }
 }
 
 Config::Config(const QString& fileName, QObject* parent)
@@ -255,6 +328,7 @@ void Config::init(const QString& configFileName)
     const QSettings::Format jsonFormat = QSettings::registerFormat("json", Utils::readJsonFile, Utils::writeJsonFile);
     QSettings::setDefaultFormat(jsonFormat);
     m_settings.reset(new QSettings(configFileName, jsonFormat));
+    this->updateSnapshot();
 
     connect(qApp, &QCoreApplication::aboutToQuit, this, &Config::sync);
 }
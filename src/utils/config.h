@@ -11,6 +11,12 @@
 #include <QPointer>
 #include <QDir>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct ConfigSnapshot;
+
 class Config : public QObject
 {
     Q_OBJECT
@@ -39,11 +45,15 @@ public:
         walletDirectory, // Directory where wallet files are stored
         autoOpenWalletPath,
         recentlyOpenedWallets,
+        restoreHeightMargin, // Blocks scanned before the restore height found on the node
 
         // Nodes
         nodes,
         nodeSource,
         useOnionNodes,
+        blockCacheEnabled, // Route wallets through the shared block cache proxy
+        blockCacheSize, // On-disk block cache size in MB
+        syncTelemetry, // Sync performance per node address, see SyncTelemetry
 
         // Tabs
         enabledTabs,
@@ -59,6 +69,7 @@ public:
         showChangeAddresses,
         showAddressIndex,
         showAddressLabels,
+        subaddressPoolSize,
 
         // Settings
         lastSettingsPage,
@@ -82,6 +93,8 @@ public:
         torOnlyAllowOnion,
         torPrivacyLevel, // Tor node network traffic strategy
         torManagedPort, // Port for managed Tor daemon
+        torControlPort, // Control port of a local Tor daemon, for bootstrap and circuit events
+        torVersionCache, // Path, mtime, size and version of the last probed Tor binary
         initSyncThreshold, // Switch to Tor after initial sync threshold blocks
 
         // Network -> Websocket
@@ -93,6 +106,8 @@ public:
         // Storage -> Logging
         writeStackTraceToDisk,
         disableLogging,
+        logToFile,
+        logFilterRules,
         logLevel,
 
         // Storage -> Misc
@@ -113,8 +128,13 @@ public:
         multiBroadcast,
         offlineTxSigningMethod,
         offlineTxSigningForceKISync,
+        offlineTxSigningCompress,
         manualFeeTierSelection,
         subtractFeeFromAmount,
+        recordFeeHistory,
+        confirmationDeadline, // Minutes the fee tier suggestion aims for, 0 if none
+        cacheOpenAliases,
+        openAliasCache, // DNSSEC-validated OpenAlias addresses, see OpenAliasResolver
 
         // Misc
         blockExplorers,
@@ -175,6 +195,9 @@ public:
 
     static QDir defaultConfigDir();
 
+    //! typed copy of frequently read settings, safe to read from any thread without locking
+    const ConfigSnapshot& snapshot() const;
+
     static Config* instance();
 
 signals:
@@ -184,13 +207,53 @@ private:
     Config(const QString& fileName, QObject* parent = nullptr);
     explicit Config(QObject* parent);
     void init(const QString& configFileName);
+    void updateSnapshot();
 
     static QPointer<Config> m_instance;
 
     QScopedPointer<QSettings> m_settings;
     QHash<QString, QVariant> m_defaults;
+
+    // Snapshots are immutable once published. Replaced ones are kept alive, so a reader holding a reference to an
+    // older snapshot is never left dangling. Settings rarely change, this only grows by a few entries per session.
+    std::atomic<const ConfigSnapshot*> m_snapshot{nullptr};
+    std::vector<std::unique_ptr<const ConfigSnapshot>> m_snapshots;
+};
+
+struct ConfigSnapshot
+{
+    // Appearance
+    int amountPrecision = 12;
+    QString dateTimeFormat; // "<dateFormat> <timeFormat>"
+
+    // History
+    bool historyShowFullTxid = false;
+
+    // Receive
+    bool showUsedAddresses = false;
+    bool showHiddenAddresses = false;
+    bool showChangeAddresses = false;
+    bool showFullAddresses = false;
+
+    // Nodes
+    int nodeSource = 0;
+    bool offlineMode = false;
+    int proxy = Config::Proxy::Tor;
+    int torPrivacyLevel = Config::allTorExceptInitSync;
+    bool torOnlyAllowOnion = false;
+    int initSyncThreshold = 360;
+    QString socks5Host;
+    QString socks5Port;
+
+    //! returns true if key is one of the settings above
+    static bool covers(Config::ConfigKey key);
 };
 
+inline const ConfigSnapshot& Config::snapshot() const
+{
+    return *m_snapshot.load(std::memory_order_acquire);
+}
+
 inline Config* conf()
 {
     return Config::instance();
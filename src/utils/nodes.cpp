@@ -3,8 +3,10 @@
 
 #include "nodes.h"
 
+#include "EmbeddedSeedNodes.h"
 #include "libwalletqt/Wallet.h"
 #include "utils/AppData.h"
+#include "utils/BlockCacheProxy.h"
 #include "utils/Utils.h"
 #include "utils/os/tails.h"
 #include "utils/os/whonix.h"
@@ -109,6 +111,7 @@ Nodes::Nodes(QObject *parent, Wallet *wallet)
 
     if (m_wallet) {
         connect(m_wallet, &Wallet::walletRefreshed, this, &Nodes::onWalletRefreshed);
+        m_telemetry = new SyncTelemetry(m_wallet, this);
     }
 }
 
@@ -154,34 +157,21 @@ void Nodes::loadConfig() {
 
     // No nodes cached, fallback to hardcoded list
     if (m_websocketNodes.count() == 0) {
-        QByteArray file = Utils::fileOpenQRC(":/assets/nodes.json");
-        QJsonDocument nodes_json = QJsonDocument::fromJson(file);
-        QJsonObject nodes_obj = nodes_json.object();
-
-        QString netKey;
-        if (constants::networkType == NetworkType::MAINNET) {
-            netKey = "mainnet";
-        } else if (constants::networkType == NetworkType::STAGENET) {
-            netKey = "stagenet";
-        }
-
-        if (nodes_obj.contains(netKey)) {
-            QJsonArray nodes_list;
-            nodes_list = nodes_json[netKey].toObject()["tor"].toArray();
-            for (const auto &node : nodes_json[netKey].toObject()["clearnet"].toArray()) {
-                nodes_list.append(node);
-            }
-            for (const auto &node : nodes_json[netKey].toObject()["i2p"].toArray()) {
-                nodes_list.append(node);
-            }
-
-            for (auto node: nodes_list) {
-                FeatherNode wsNode(node.toString());
+        auto addSeedNodes = [this](const auto &seedNodes) {
+            for (const char *address : seedNodes) {
+                FeatherNode wsNode(address);
                 wsNode.custom = false;
                 wsNode.online = true;
                 m_websocketNodes.append(wsNode);
-                m_nodes.addNode(node.toString(), constants::networkType, NodeList::Type::ws);
+                m_nodes.addNode(address, constants::networkType, NodeList::Type::ws);
             }
+        };
+
+        // Compiled in from assets/nodes.json, see contrib/embed-tables
+        if (constants::networkType == NetworkType::MAINNET) {
+            addSeedNodes(embedded::mainnetSeedNodes);
+        } else if (constants::networkType == NetworkType::STAGENET) {
+            addSeedNodes(embedded::stagenetSeedNodes);
         }
 
         qDebug() << QString("Loaded %1 nodes from hardcoded list").arg(m_websocketNodes.count());
@@ -208,11 +198,11 @@ void Nodes::connectToNode(const FeatherNode &node) {
         return;
     }
 
-    if (conf()->get(Config::offlineMode).toBool()) {
+    if (conf()->snapshot().offlineMode) {
         return;
     }
 
-    if (conf()->get(Config::proxy).toInt() == Config::Proxy::Tor && conf()->get(Config::torOnlyAllowOnion).toBool()) {
+    if (conf()->snapshot().proxy == Config::Proxy::Tor && conf()->snapshot().torOnlyAllowOnion) {
         if (!node.isOnion() && !node.isLocal()) {
             // We only want to connect to .onion nodes, but local nodes get an exception.
             return;
@@ -221,24 +211,48 @@ void Nodes::connectToNode(const FeatherNode &node) {
 
     qInfo() << QString("Attempting to connect to %1 (%2)").arg(node.toAddress(), node.custom ? "custom" : "ws");
 
+    QString daemonUsername;
+    QString daemonPassword;
     if (!node.url.userName().isEmpty() && !node.url.password().isEmpty()) {
-        m_wallet->setDaemonLogin(node.url.userName(), node.url.password());
+        daemonUsername = node.url.userName();
+        daemonPassword = node.url.password();
     }
 
     // Don't use SSL over Tor/i2p
-    m_wallet->setUseSSL(!node.isAnonymityNetwork());
+    bool useSSL = !node.isAnonymityNetwork();
 
     QString proxyAddress;
     if (useSocks5Proxy(node)) {
-        if (conf()->get(Config::proxy).toInt() == Config::Proxy::Tor && (!torManager()->isLocalTor() || torManager()->isAlreadyRunning())) {
+        if (conf()->snapshot().proxy == Config::Proxy::Tor && (!torManager()->isLocalTor() || torManager()->isAlreadyRunning())) {
             proxyAddress = QString("%1:%2").arg(torManager()->featherTorHost, QString::number(torManager()->featherTorPort));
         } else {
-            proxyAddress = QString("%1:%2").arg(conf()->get(Config::socks5Host).toString(),
-                                                conf()->get(Config::socks5Port).toString());
+            proxyAddress = QString("%1:%2").arg(conf()->snapshot().socks5Host, conf()->snapshot().socks5Port);
         }
     }
 
-    m_wallet->initAsync(node.toAddress(), true, 0, proxyAddress);
+    // Wallets open side by side share one block cache, so the same blocks are only downloaded once
+    QString daemonAddress = node.toAddress();
+    QString previousRoute = m_cacheRoute;
+    m_cacheRoute.clear();
+    if (conf()->get(Config::blockCacheEnabled).toBool()) {
+        BlockCacheProxy::Route route = blockCacheProxy()->route(daemonAddress, useSSL, proxyAddress, daemonUsername, daemonPassword);
+        if (!route.address.isEmpty()) {
+            daemonAddress = route.address;
+            daemonUsername = route.username;
+            daemonPassword = route.password;
+            useSSL = false;
+            proxyAddress = "";
+            m_cacheRoute = route.address;
+        }
+    }
+    if (!previousRoute.isEmpty()) {
+        blockCacheProxy()->release(previousRoute);
+    }
+
+    m_telemetry->setNode(node.toAddress(), m_cacheRoute);
+    m_wallet->setDaemonLogin(daemonUsername, daemonPassword);
+    m_wallet->setUseSSL(useSSL);
+    m_wallet->initAsync(daemonAddress, true, 0, proxyAddress);
 
     m_connection = node;
     m_connection.isActive = false;
@@ -257,7 +271,7 @@ void Nodes::autoConnect(bool forceReconnect) {
         return;
     }
 
-    if (conf()->get(Config::offlineMode).toBool()) {
+    if (conf()->snapshot().offlineMode) {
         return;
     }
 
@@ -321,6 +335,24 @@ FeatherNode Nodes::pickEligibleNode() {
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
     std::shuffle(node_indices.begin(), node_indices.end(), std::default_random_engine(seed));
 
+    // Nodes that synced far slower than the fastest known one are only tried last
+    if (m_telemetry) {
+        QMap<QString, NodeSyncStats> stats = m_telemetry->allStats();
+        auto rate = [&stats](const FeatherNode &node) {
+            const NodeSyncStats &s = stats[node.toAddress()];
+            return (s.blocks >= 1000) ? s.blocksPerSecond() : 0;  // too little data to judge
+        };
+
+        double fastest = 0;
+        for (const auto &node : nodes) {
+            fastest = std::max(fastest, rate(node));
+        }
+        std::stable_partition(node_indices.begin(), node_indices.end(), [&](int index) {
+            double r = rate(nodes.at(index));
+            return r == 0 || r >= fastest / 4;
+        });
+    }
+
     // Pick random eligible node
     int mode_height = this->modeHeight(nodes);
     for (int index : node_indices) {
@@ -342,7 +374,7 @@ FeatherNode Nodes::pickEligibleNode() {
                 continue;
         }
 
-        if (conf()->get(Config::proxy).toInt() == Config::Proxy::Tor && conf()->get(Config::torOnlyAllowOnion).toBool()) {
+        if (conf()->snapshot().proxy == Config::Proxy::Tor && conf()->snapshot().torOnlyAllowOnion) {
             if (!node.isOnion() && !node.isLocal()) {
                 // We only want to connect to .onion nodes, but local nodes get an exception.
                 continue;
@@ -415,7 +447,7 @@ void Nodes::setCustomNodes(const QList<FeatherNode> &nodes) {
 }
 
 void Nodes::onWalletRefreshed() {
-    if (conf()->get(Config::proxy) == Config::Proxy::Tor && conf()->get(Config::torPrivacyLevel).toInt() == Config::allTorExceptInitSync) {
+    if (conf()->snapshot().proxy == Config::Proxy::Tor && conf()->snapshot().torPrivacyLevel == Config::allTorExceptInitSync) {
         // Don't reconnect if we're connected to a local node (traffic will not be routed through Tor)
         if (m_connection.isLocal())
             return;
@@ -429,15 +461,16 @@ void Nodes::onWalletRefreshed() {
 }
 
 bool Nodes::useOnionNodes() {
-    if (conf()->get(Config::proxy) != Config::Proxy::Tor) {
+    const ConfigSnapshot &settings = conf()->snapshot();
+    if (settings.proxy != Config::Proxy::Tor) {
         return false;
     }
 
-    if (conf()->get(Config::torOnlyAllowOnion).toBool()) {
+    if (settings.torOnlyAllowOnion) {
         return true;
     }
 
-    auto privacyLevel = conf()->get(Config::torPrivacyLevel).toInt();
+    auto privacyLevel = settings.torPrivacyLevel;
     if (privacyLevel == Config::allTor) {
         return true;
     }
@@ -448,7 +481,7 @@ bool Nodes::useOnionNodes() {
         }
 
         if (appData()->heights.contains(constants::networkType)) {
-            int initSyncThreshold = conf()->get(Config::initSyncThreshold).toInt();
+            int initSyncThreshold = settings.initSyncThreshold;
             int networkHeight = appData()->heights[constants::networkType];
 
             if (m_wallet && m_wallet->blockChainHeight() > (networkHeight - initSyncThreshold)) {
@@ -461,7 +494,7 @@ bool Nodes::useOnionNodes() {
 }
 
 bool Nodes::useI2PNodes() {
-    if (conf()->get(Config::proxy) == Config::Proxy::i2p) {
+    if (conf()->snapshot().proxy == Config::Proxy::i2p) {
         return true;
     }
 
@@ -479,7 +512,7 @@ bool Nodes::useSocks5Proxy(const FeatherNode &node) {
         return false;
     }
 
-    const auto config_proxy = conf()->get(Config::proxy).toInt();
+    const auto config_proxy = conf()->snapshot().proxy;
     if (config_proxy == Config::Proxy::None) {
         return false;
     }
@@ -570,7 +603,7 @@ FeatherNode Nodes::connection() {
 }
 
 NodeSource Nodes::source() {
-    return static_cast<NodeSource>(conf()->get(Config::nodeSource).toInt());
+    return static_cast<NodeSource>(conf()->snapshot().nodeSource);
 }
 
 int Nodes::modeHeight(const QList<FeatherNode> &nodes) {
@@ -609,4 +642,12 @@ void Nodes::allowConnection() {
     m_allowConnection = true;
 }
 
-Nodes::~Nodes() = default;
+SyncTelemetry* Nodes::telemetry() const {
+    return m_telemetry;
+}
+
+Nodes::~Nodes() {
+    if (!m_cacheRoute.isEmpty() && BlockCacheProxy::isRunning()) {
+        blockCacheProxy()->release(m_cacheRoute);
+    }
+}
@@ -12,6 +12,7 @@
 #include <QUrl>
 
 #include "model/NodeModel.h"
+#include "utils/SyncTelemetry.h"
 #include "utils/Utils.h"
 #include "utils/config.h"
 
@@ -161,6 +162,9 @@ public:
     QList<FeatherNode> customNodes();
     QList<FeatherNode> websocketNodes();
 
+    //! sync performance of the current and past connections, nullptr without a wallet
+    SyncTelemetry *telemetry() const;
+
     NodeModel *modelWebsocket;
     NodeModel *modelCustom;
 
@@ -177,6 +181,7 @@ private slots:
 
 private:
     Wallet *m_wallet = nullptr;
+    SyncTelemetry *m_telemetry = nullptr;
     QJsonObject m_configJson;
 
     NodeList m_nodes;
@@ -187,6 +192,7 @@ private:
     QList<FeatherNode> m_websocketNodes;
 
     FeatherNode m_connection;  // current active connection, if any
+    QString m_cacheRoute;      // block cache listener the wallet connects through, see BlockCacheProxy
 
     bool m_wsNodesReceived = false;
     bool m_enableAutoconnect = true;
@@ -3,6 +3,8 @@
 
 #include "scheduler.h"
 
+#include "Tracer.h"
+
 FutureScheduler::FutureScheduler(QObject *parent)
     : QObject(parent), Alive(0), Stopping(false)
 {
@@ -31,6 +33,7 @@ QPair<bool, QFuture<void>> FutureScheduler::run(std::function<void()> function)
         return QtConcurrent::run([this, function] {
             try
             {
+                TRACE_SCOPE("FutureScheduler::run");
                 function();
             }
             catch (const std::exception &exception)
@@ -52,6 +55,7 @@ QPair<bool, QFuture<QVariantMap>> FutureScheduler::run(const std::function<QVari
             QVariantMap result;
             try
             {
+                TRACE_SCOPE("FutureScheduler::run");
                 result = function();
             }
             catch (const std::exception &exception)
@@ -7,8 +7,6 @@
 #include <QFileDialog>
 
 #include "constants.h"
-#include "utils/AsyncTask.h"
-#include "utils/Networking.h"
 #include "utils/NetworkManager.h"
 #include "utils/updater/Updater.h"
 #include "utils/Utils.h"
@@ -39,8 +37,8 @@ UpdateDialog::UpdateDialog(QWidget *parent, QSharedPointer<Updater> updater)
     }
 
     connect(ui->btn_cancel, &QPushButton::clicked, [this]{
-        if (m_reply) {
-            m_reply->abort();
+        if (m_downloader) {
+            m_downloader->abort();
         }
         this->reject();
     });
@@ -87,58 +85,46 @@ void UpdateDialog::onDownloadClicked() {
     ui->btn_download->hide();
     ui->progressBar->show();
 
-    Networking network{this};
+    if (!m_downloader) {
+        // A directory only we can write to, with a name that can't be guessed, so the archive can't be swapped
+        // between verification and extraction
+        if (!m_tempDir.isValid()) {
+            this->onDownloadError(QString("Unable to create temporary directory: %1").arg(m_tempDir.errorString()));
+            return;
+        }
+        QString archivePath = m_tempDir.filePath(m_updater->binaryFilename);
+        const QByteArray signedHash = QByteArray::fromHex(m_updater->hash.toUtf8());
 
-    m_reply = network.get(this, m_updater->downloadUrl);
-    connect(m_reply, &QNetworkReply::downloadProgress, this, &UpdateDialog::onDownloadProgress);
-    connect(m_reply, &QNetworkReply::finished, this, &UpdateDialog::onDownloadFinished);
+        m_downloader = new UpdateDownloader(m_updater->downloadUrl, archivePath, signedHash, this);
+        connect(m_downloader, &UpdateDownloader::progress, this, &UpdateDialog::onDownloadProgress);
+        connect(m_downloader, &UpdateDownloader::retrying, this, &UpdateDialog::onDownloadRetrying);
+        connect(m_downloader, &UpdateDownloader::finished, this, &UpdateDialog::onDownloadFinished);
+        connect(m_downloader, &UpdateDownloader::failed, this, &UpdateDialog::onDownloadError);
+    }
+
+    // Resumes where the previous attempt left off
+    m_downloader->start();
 }
 
 void UpdateDialog::onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
+    if (bytesTotal > 0) {
+        ui->progressBar->setMaximum(bytesTotal);
+    }
     ui->progressBar->setValue(bytesReceived);
-    ui->progressBar->setMaximum(bytesTotal);
 }
 
-void UpdateDialog::onDownloadFinished() {
-    bool error = (m_reply->error() != QNetworkReply::NoError);
-    if (error) {
-        this->onDownloadError(QString("Network error: %1").arg(m_reply->errorString()));
-        return;
-    }
-
-    QByteArray response = m_reply->readAll();
-    if (response.isEmpty()) {
-        this->onDownloadError("Network error: Empty response");
-        return;
-    }
-
-    std::string responseStr = response.toStdString();
-
-    try {
-        const QByteArray calculatedHash = AsyncTask::runAndWaitForFuture([this, responseStr]{
-            return Updater().getHash(&responseStr[0], responseStr.size());
-        });
-
-        const QByteArray signedHash = QByteArray::fromHex(m_updater->hash.toUtf8());
-
-        if (signedHash != calculatedHash) {
-            this->onDownloadError("Error: Hash sum mismatch.");
-            return;
-        }
-    }
-    catch (const std::exception &e)
-    {
-        this->onDownloadError(QString("Error: Unable to calculate sha256sum: %1").arg(e.what()));
-        return;
-    }
+void UpdateDialog::onDownloadRetrying(int attempt, const QString &reason) {
+    ui->label_body->setText(QString("%1\nResuming download (attempt %2 of %3)..").arg(reason, QString::number(attempt), QString::number(UpdateDownloader::maxRetries)));
+}
 
+void UpdateDialog::onDownloadFinished(const QString &archivePath) {
     this->setStatus("Download finished and verified.", true);
 
     ui->btn_installUpdate->show();
     ui->btn_installUpdate->setFocus();
     ui->progressBar->hide();
 
-    m_updateZipArchive = responseStr;
+    m_archivePath = archivePath;
 }
 
 void UpdateDialog::onDownloadError(const QString &errMsg) {
@@ -160,18 +146,14 @@ void UpdateDialog::onInstallUpdate() {
     return;
 #endif
 
-    zip_error_t err;
-    zip_error_init(&err);
-
-    zip_source_t *zip_source = zip_source_buffer_create(&m_updateZipArchive[0], m_updateZipArchive.size(), 0, &err);
-    if (!zip_source) {
-        this->onInstallError(QString("Error in libzip: Unable to create zip source from buffer: %1").arg(QString::fromStdString(err.str)));
-        return;
-    }
-
-    zip_t *zip_archive = zip_open_from_source(zip_source, 0, &err);
+    int errorCode = 0;
+    zip_t *zip_archive = zip_open(m_archivePath.toStdString().c_str(), ZIP_RDONLY, &errorCode);
     if (!zip_archive) {
-        this->onInstallError(QString("Error in libzip: Unable to open archive from source: %1").arg(QString::fromStdString(err.str)));
+        zip_error_t err;
+        zip_error_init_with_code(&err, errorCode);
+        QString errorStr = QString::fromStdString(zip_error_strerror(&err));
+        zip_error_fini(&err);
+        this->onInstallError(QString("Error in libzip: Unable to open archive: %1").arg(errorStr));
         return;
     }
 
@@ -204,17 +186,6 @@ void UpdateDialog::onInstallUpdate() {
         return;
     }
 
-    std::unique_ptr<char[]> contents{new char[sb.size]};
-
-    auto bytes_read = zip_fread(zf, contents.get(), sb.size);
-    if (bytes_read != sb.size){
-        this->onInstallError("Error in libzip: File size inconsistent");
-        return;
-    }
-
-    zip_fclose(zf);
-    zip_close(zip_archive);
-
     QDir applicationDir(Utils::applicationPath());
     QString filePath = applicationDir.filePath(name);
     if (m_updater->platformTag == "win-installer") {
@@ -226,15 +197,39 @@ void UpdateDialog::onInstallUpdate() {
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly))
     {
+        zip_fclose(zf);
+        zip_close(zip_archive);
         this->onInstallError(QString("Error: Could not write to application path: %1").arg(filePath));
         return;
     }
 
-    if (static_cast<size_t>(file.write(&contents[0], sb.size)) != sb.size) {
-        this->onInstallError("Error: Unable to write file");
+    // Extract in chunks, the binary is never held in memory as a whole
+    std::unique_ptr<char[]> chunk{new char[64 * 1024]};
+    zip_uint64_t written = 0;
+    while (written < sb.size) {
+        auto bytes_read = zip_fread(zf, chunk.get(), 64 * 1024);
+        if (bytes_read <= 0) {
+            break;
+        }
+        if (file.write(chunk.get(), bytes_read) != bytes_read) {
+            zip_fclose(zf);
+            zip_close(zip_archive);
+            this->onInstallError("Error: Unable to write file");
+            return;
+        }
+        written += bytes_read;
+    }
+
+    zip_fclose(zf);
+    zip_close(zip_archive);
+
+    if (written != sb.size) {
+        this->onInstallError("Error in libzip: File size inconsistent");
         return;
     }
 
+    QFile::remove(m_archivePath);
+
     if (!file.setPermissions(QFile::ExeUser | QFile::ExeOwner | QFile::ExeGroup | QFile::ExeOther
                              | QFile::ReadUser | QFile::ReadOwner
                              | QFile::WriteUser | QFile::WriteOwner)) {
@@ -268,27 +263,7 @@ void UpdateDialog::installUpdateMac() {
         return;
     }
 
-    QString appName = QString("feather-%1").arg(m_updater->version);
-    QString zipName = QString("%1.zip").arg(appName);
-
-    QString downloadsPath = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
-    if (downloadsPath.isEmpty()) {
-        this->onInstallError(QString("Error: Could not determine download location"));
-        return;
-    }
-
-    QString fPath = QString("%1/%2").arg(downloadsPath, zipName);
-    QFile file(fPath);
-    qDebug() << "Writing zip file to " << fPath;
-    if (!file.open(QIODevice::WriteOnly)) {
-        this->onInstallError(QString("Error: Could not write to download location: %1").arg(fPath));
-        return;
-    }
-
-    if (static_cast<size_t>(file.write(&m_updateZipArchive[0], m_updateZipArchive.size())) != m_updateZipArchive.size()) {
-        this->onInstallError("Error: Unable to write file");
-        return;
-    }
+    QString fPath = m_archivePath;
 
     QProcess unzip;
     unzip.start("/usr/bin/unzip", {"-o", fPath, "-d", appDir.absolutePath()});
@@ -302,7 +277,7 @@ void UpdateDialog::installUpdateMac() {
     m_updatePath = QString("%1/Contents/MacOS/feather").arg(appDir.absolutePath());
     qDebug() << "Update path: " << m_updatePath;
 
-    file.remove();
+    QFile::remove(fPath);
 
     this->setStatus(QString("Installation successful: Do you want to restart Feather now?").arg(m_updatePath));
     ui->btn_restart->show();
@@ -6,9 +6,11 @@
 
 #include <QDialog>
 #include <QNetworkReply>
+#include <QTemporaryDir>
 #include <QTimer>
 
 #include "utils/updater/Updater.h"
+#include "utils/updater/UpdateDownloader.h"
 
 namespace Ui {
     class UpdateDialog;
@@ -25,7 +27,8 @@ public:
 private slots:
     void onDownloadClicked();
     void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
-    void onDownloadFinished();
+    void onDownloadRetrying(int attempt, const QString &reason);
+    void onDownloadFinished(const QString &archivePath);
     void onDownloadError(const QString &errMsg);
     void onInstallUpdate();
     void onInstallError(const QString &errMsg);
@@ -48,11 +51,13 @@ private:
     QString m_downloadUrl;
     QString m_updatePath;
 
-    std::string m_updateZipArchive;
+    // Verified archive on disk, written by m_downloader into m_tempDir
+    QTemporaryDir m_tempDir;
+    QString m_archivePath;
 
     QTimer m_waitingTimer;
 
-    QNetworkReply *m_reply = nullptr;
+    UpdateDownloader *m_downloader = nullptr;
 };
 
 #endif //FEATHER_UPDATEDIALOG_H
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "UpdateDownloader.h"
+
+#include <QRegularExpression>
+
+#include "utils/Networking.h"
+
+namespace {
+    constexpr qint64 chunkSize = 64 * 1024;
+
+    // Don't let Qt buffer more than this in memory, readyRead drains it to disk
+    constexpr qint64 readBufferSize = 1024 * 1024;
+}
+
+UpdateDownloader::UpdateDownloader(QString url, QString filePath, QByteArray expectedHash, QObject *parent)
+    : QObject(parent)
+    , m_url(std::move(url))
+    , m_filePath(std::move(filePath))
+    , m_expectedHash(std::move(expectedHash))
+{
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &UpdateDownloader::request);
+}
+
+void UpdateDownloader::start() {
+    if (m_reply || m_retryTimer.isActive()) {
+        return;
+    }
+
+    m_attempt = 0;
+    if (!m_file && !this->restart()) {
+        return;
+    }
+
+    if (m_received > 0) {
+        qInfo() << "Updater: resuming download at" << m_received << "bytes";
+    }
+    this->request();
+}
+
+void UpdateDownloader::abort() {
+    m_retryTimer.stop();
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+        m_reply = nullptr;
+    }
+}
+
+bool UpdateDownloader::restart() {
+    // Destroying an uncommitted QSaveFile removes its temporary file
+    m_file.reset(new QSaveFile(m_filePath));
+    m_hash.reset();
+    m_received = 0;
+    m_total = -1;
+    m_writeError = false;
+
+    if (!m_file->open(QIODevice::WriteOnly)) {
+        QString error = QString("Unable to write to %1: %2").arg(m_filePath, m_file->errorString());
+        m_file.reset();
+        emit failed(error);
+        return false;
+    }
+    return true;
+}
+
+void UpdateDownloader::request() {
+    Networking network{this};
+    m_reply = network.get(this, m_url, m_received);
+    if (!m_reply) {
+        emit failed("Network is disabled (offline mode)");
+        return;
+    }
+
+    m_requestOffset = m_received;
+    m_reply->setReadBufferSize(readBufferSize);
+
+    connect(m_reply, &QNetworkReply::metaDataChanged, this, &UpdateDownloader::onMetaDataChanged);
+    connect(m_reply, &QNetworkReply::readyRead, this, &UpdateDownloader::onReadyRead);
+    connect(m_reply, &QNetworkReply::finished, this, &UpdateDownloader::onFinished);
+}
+
+void UpdateDownloader::onMetaDataChanged() {
+    int status = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    qint64 length = m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+
+    if (status == 206) {
+        // Content-Range: bytes <first>-<last>/<total or *>
+        static const QRegularExpression re(R"(^bytes (\d+)-(\d+)/(\d+|\*)$)");
+        auto match = re.match(QString::fromLatin1(m_reply->rawHeader("Content-Range")));
+        if (!match.hasMatch() || match.captured(1).toLongLong() != m_requestOffset) {
+            qWarning() << "Updater: unexpected Content-Range, starting over";
+            this->abort();
+            if (this->restart()) {
+                this->request();
+            }
+            return;
+        }
+        bool ok;
+        qint64 total = match.captured(3).toLongLong(&ok);
+        m_total = ok ? total : -1;
+    }
+    else if (status == 200) {
+        if (m_received > 0) {
+            qInfo() << "Updater: server ignored the range request, starting over";
+            if (!this->restart()) {
+                this->abort();
+                return;
+            }
+            m_requestOffset = 0;
+        }
+        m_total = length > 0 ? length : -1;
+    }
+}
+
+void UpdateDownloader::onReadyRead() {
+    this->drain(m_reply);
+}
+
+void UpdateDownloader::drain(QNetworkReply *reply) {
+    if (!m_file || m_writeError) {
+        return;
+    }
+
+    while (reply->bytesAvailable() > 0) {
+        m_buffer.resize(chunkSize);
+        qint64 n = reply->read(m_buffer.data(), chunkSize);
+        if (n <= 0) {
+            break;
+        }
+
+        if (m_file->write(m_buffer.constData(), n) != n) {
+            m_writeError = true;
+            reply->abort();
+            return;
+        }
+        m_hash.addData(QByteArrayView(m_buffer.constData(), n));
+        m_received += n;
+    }
+
+    emit progress(m_received, m_total);
+}
+
+void UpdateDownloader::onFinished() {
+    QNetworkReply *reply = m_reply;
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    // Whatever arrived before an error is still valid data
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 200 || status == 206) {
+        this->drain(reply);
+    }
+
+    if (m_writeError) {
+        QString error = QString("Unable to write update to disk: %1").arg(m_file->errorString());
+        m_file.reset();
+        emit failed(error);
+        return;
+    }
+
+    // The previous attempt already got everything, but didn't get to see the end of the response
+    if (status == 416 && m_received > 0) {
+        this->verifyAndCommit();
+        return;
+    }
+
+    if (status >= 400 && status < 500) {
+        emit failed(QString("Download failed: HTTP status %1").arg(status));
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        if (reply->error() == QNetworkReply::OperationCanceledError) {
+            return;
+        }
+        this->retry(QString("Network error: %1").arg(reply->errorString()));
+        return;
+    }
+
+    if (status != 200 && status != 206) {
+        emit failed(QString("Unexpected HTTP status %1").arg(status));
+        return;
+    }
+
+    if (m_total >= 0 && m_received < m_total) {
+        this->retry("Connection closed before the download completed");
+        return;
+    }
+
+    this->verifyAndCommit();
+}
+
+void UpdateDownloader::retry(const QString &reason) {
+    // Only give up if attempts keep failing without making progress
+    if (m_received > m_requestOffset) {
+        m_attempt = 0;
+    }
+
+    if (++m_attempt > maxRetries) {
+        qWarning() << "Updater: download failed:" << reason;
+        emit failed(reason);
+        return;
+    }
+
+    int delay = qMin(1 << m_attempt, 30);
+    qInfo() << "Updater:" << reason << "- resuming in" << delay << "seconds";
+    emit retrying(m_attempt, reason);
+    m_retryTimer.start(delay * 1000);
+}
+
+void UpdateDownloader::verifyAndCommit() {
+    QByteArray hash = m_hash.result();
+    if (hash != m_expectedHash) {
+        qWarning() << "Updater: hash mismatch, expected" << m_expectedHash.toHex() << "got" << hash.toHex();
+        m_file.reset();
+        emit failed("Error: Hash sum mismatch.");
+        return;
+    }
+
+    if (!m_file->commit()) {
+        QString error = QString("Unable to save update: %1").arg(m_file->errorString());
+        m_file.reset();
+        emit failed(error);
+        return;
+    }
+
+    m_file.reset();
+    qInfo() << "Updater: downloaded and verified" << m_filePath;
+    emit finished(m_filePath);
+}
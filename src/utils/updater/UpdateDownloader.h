@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_UPDATEDOWNLOADER_H
+#define FEATHER_UPDATEDOWNLOADER_H
+
+#include <QCryptographicHash>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QSaveFile>
+#include <QTimer>
+
+// Downloads an update archive straight to disk, hashing it as it arrives.
+//
+// The data goes into a QSaveFile, which is only renamed to its final name once the SHA-256 matches the signed hash,
+// so a partial or tampered file never appears under the archive name. When the connection drops, the download is
+// resumed with an HTTP Range request, a few times automatically and afterwards whenever start() is called again.
+class UpdateDownloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    UpdateDownloader(QString url, QString filePath, QByteArray expectedHash, QObject *parent = nullptr);
+
+    //! starts the download, or resumes it after a failure
+    void start();
+    void abort();
+
+    QString filePath() const { return m_filePath; }
+
+    static constexpr int maxRetries = 5;
+
+signals:
+    void progress(qint64 bytesReceived, qint64 bytesTotal);
+    void retrying(int attempt, const QString &reason);
+    void finished(const QString &filePath);
+    void failed(const QString &error);
+
+private:
+    void request();
+    void onMetaDataChanged();
+    void onReadyRead();
+    void drain(QNetworkReply *reply);
+    void onFinished();
+    void retry(const QString &reason);
+    void verifyAndCommit();
+
+    //! discards everything downloaded so far
+    bool restart();
+
+    QString m_url;
+    QString m_filePath;
+    QByteArray m_expectedHash;
+
+    QScopedPointer<QSaveFile> m_file;
+    QCryptographicHash m_hash{QCryptographicHash::Sha256};
+    QByteArray m_buffer;
+
+    QPointer<QNetworkReply> m_reply;
+    QTimer m_retryTimer;
+
+    qint64 m_received = 0;
+    qint64 m_total = -1;
+    qint64 m_requestOffset = 0;
+    int m_attempt = 0;
+    bool m_writeError = false;
+};
+
+#endif //FEATHER_UPDATEDOWNLOADER_H
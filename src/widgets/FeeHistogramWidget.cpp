@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#include "FeeHistogramWidget.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+
+#include "utils/ColorScheme.h"
+#include "utils/Utils.h"
+
+FeeHistogramWidget::FeeHistogramWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    this->setMouseTracking(true);
+    this->setMinimumHeight(120);
+}
+
+void FeeHistogramWidget::setHistogram(const FeeHistogram &histogram, const QVector<quint64> &baseFees) {
+    m_histogram = histogram;
+    m_baseFees = baseFees;
+
+    // Only show the range that has transactions or fee tiers in it
+    m_firstBucket = FeeHistogram::bucketCount;
+    m_lastBucket = -1;
+    m_maxWeight = 0;
+    for (int i = 0; i < FeeHistogram::bucketCount; i++) {
+        const auto &bucket = m_histogram.buckets[i];
+        if (bucket.transactions == 0) {
+            continue;
+        }
+        m_firstBucket = std::min(m_firstBucket, i);
+        m_lastBucket = std::max(m_lastBucket, i);
+        m_maxWeight = std::max(m_maxWeight, bucket.weight);
+    }
+    for (const auto &fee : m_baseFees) {
+        int bucket = FeeHistogram::bucketFor(fee);
+        m_firstBucket = std::min(m_firstBucket, bucket);
+        m_lastBucket = std::max(m_lastBucket, bucket);
+    }
+
+    this->update();
+}
+
+QSize FeeHistogramWidget::sizeHint() const {
+    return {400, 160};
+}
+
+QRect FeeHistogramWidget::plotArea() const {
+    const int labelHeight = this->fontMetrics().height() + 4;
+    return this->rect().adjusted(4, 4, -4, -labelHeight);
+}
+
+int FeeHistogramWidget::bucketAt(const QPoint &pos) const {
+    const QRect area = this->plotArea();
+    if (m_lastBucket < m_firstBucket || !area.contains(pos)) {
+        return -1;
+    }
+    const int buckets = m_lastBucket - m_firstBucket + 1;
+    return m_firstBucket + std::min(buckets - 1, (pos.x() - area.left()) * buckets / std::max(area.width(), 1));
+}
+
+void FeeHistogramWidget::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    const QRect area = this->plotArea();
+    const QColor textColor = this->palette().color(QPalette::WindowText);
+
+    if (m_lastBucket < m_firstBucket) {
+        painter.setPen(textColor);
+        painter.drawText(this->rect(), Qt::AlignCenter, "No transactions in pool");
+        return;
+    }
+
+    const int buckets = m_lastBucket - m_firstBucket + 1;
+    const double barWidth = static_cast<double>(area.width()) / buckets;
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(this->palette().color(QPalette::Highlight));
+    for (int i = m_firstBucket; i <= m_lastBucket; i++) {
+        const auto &bucket = m_histogram.buckets[i];
+        if (bucket.weight == 0 || m_maxWeight == 0) {
+            continue;
+        }
+        const double height = static_cast<double>(bucket.weight) / m_maxWeight * area.height();
+        const double x = area.left() + (i - m_firstBucket) * barWidth;
+        painter.drawRect(QRectF(x, area.bottom() - height, std::max(barWidth - 1, 1.0), height));
+    }
+
+    // Fee tiers, in the colours the transaction list uses
+    static const QList<ColorSchemeItem*> tierColors = {&ColorScheme::BLUE, &ColorScheme::GREEN, &ColorScheme::YELLOW, &ColorScheme::RED};
+    for (int i = 0; i < m_baseFees.size() && i < tierColors.size(); i++) {
+        const int bucket = FeeHistogram::bucketFor(m_baseFees[i]);
+        const double x = area.left() + (bucket - m_firstBucket + 0.5) * barWidth;
+        painter.setPen(QPen(tierColors[i]->asColor(), 2, Qt::DashLine));
+        painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+    }
+
+    painter.setPen(textColor);
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+
+    const QRect labels(area.left(), area.bottom() + 2, area.width(), this->height() - area.bottom() - 2);
+    painter.drawText(labels, Qt::AlignLeft | Qt::AlignTop, QString("%1 /B").arg(FeeHistogram::lowerBound(m_firstBucket)));
+    painter.drawText(labels, Qt::AlignRight | Qt::AlignTop, QString("%1 /B").arg(FeeHistogram::lowerBound(m_lastBucket + 1)));
+}
+
+void FeeHistogramWidget::mouseMoveEvent(QMouseEvent *event) {
+    const int i = this->bucketAt(event->position().toPoint());
+    if (i < 0) {
+        QToolTip::hideText();
+        return;
+    }
+
+    const auto &bucket = m_histogram.buckets[i];
+    QString text = QString("%1 – %2 /B\n%3 transactions, %4")
+            .arg(QString::number(FeeHistogram::lowerBound(i)),
+                 QString::number(std::max(FeeHistogram::lowerBound(i), FeeHistogram::lowerBound(i + 1) - 1)),
+                 QString::number(bucket.transactions),
+                 Utils::formatBytes(bucket.weight));
+    QToolTip::showText(event->globalPosition().toPoint(), text, this);
+}
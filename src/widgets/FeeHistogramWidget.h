@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: The Monero Project
+
+#ifndef FEATHER_FEEHISTOGRAMWIDGET_H
+#define FEATHER_FEEHISTOGRAMWIDGET_H
+
+#include <QWidget>
+
+#include "model/TxPoolModel.h"
+
+// Draws the pool's weight per fee-per-byte bucket, with markers for the fee tiers
+class FeeHistogramWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FeeHistogramWidget(QWidget *parent = nullptr);
+
+    void setHistogram(const FeeHistogram &histogram, const QVector<quint64> &baseFees);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    QSize sizeHint() const override;
+
+private:
+    QRect plotArea() const;
+    int bucketAt(const QPoint &pos) const;
+
+    FeeHistogram m_histogram;
+    QVector<quint64> m_baseFees;
+    int m_firstBucket = 0;
+    int m_lastBucket = -1;
+    quint64 m_maxWeight = 0;
+};
+
+#endif //FEATHER_FEEHISTOGRAMWIDGET_H
@@ -23,6 +23,8 @@ PayToEdit::PayToEdit(QWidget *parent) : QPlainTextEdit(parent)
     connect(this->document(), &QTextDocument::contentsChanged, this, &PayToEdit::updateSize);
     connect(this, &QPlainTextEdit::textChanged, this, &PayToEdit::checkText);
 
+    connect(openAliasResolver(), &OpenAliasResolver::resolved, this, &PayToEdit::onAliasResolved);
+
     this->updateSize();
 }
 
@@ -63,19 +65,25 @@ void PayToEdit::payToMany() {
     this->updateSize();
 }
 
+bool PayToEdit::hasUnresolvedAliases() {
+    return !m_pendingAliases.isEmpty();
+}
+
+void PayToEdit::resolveAliases() {
+    // Looked up only on request, a lookup goes to the system's DNS resolver and not through the proxy
+    for (const auto &alias : m_pendingAliases) {
+        m_aliasErrors.remove(alias);
+    }
+    m_requestedAliases.unite(m_pendingAliases);
+    openAliasResolver()->resolve(m_pendingAliases.values());
+}
+
 bool PayToEdit::isOpenAlias() {
     if (this->isMultiline()) {
         return false;
     }
-    auto text = this->toPlainText().trimmed();
-    if (!(text.contains('.') and (!text.contains(' ')))) {
-        return false;
-    }
-    auto parts = text.split(',');
-    if (parts.size() > 0 and WalletManager::addressValid(parts[0], m_netType)) {
-        return false;
-    }
-    return true;
+    auto parts = this->toPlainText().trimmed().split(',');
+    return OpenAliasResolver::isAlias(parts[0], m_netType);
 }
 
 void PayToEdit::keyPressEvent(QKeyEvent *event) {
@@ -134,6 +142,7 @@ bool PayToEdit::pasteEvent(const QMimeData *mimeData) {
 void PayToEdit::checkText() {
     m_errors.clear();
     m_outputs.clear();
+    m_pendingAliases.clear();
 
     // filter out empty lines
     QStringList lines;
@@ -163,6 +172,10 @@ PartialTxOutput PayToEdit::parseAddressAndAmount(const QString &line) {
     }
 
     QString address = this->parseAddress(x[0]);
+    if (address.isEmpty() && OpenAliasResolver::isAlias(x[0], m_netType)) {
+        // Keep the alias, parseAsMultiline() resolves it
+        address = x[0].trimmed();
+    }
     quint64 amount = this->parseAmount(x[1]);
 
     return PartialTxOutput(address, amount);
@@ -201,7 +214,48 @@ void PayToEdit::parseAsMultiline(const QStringList &lines) {
             continue;
         }
 
+        if (OpenAliasResolver::isAlias(output.address, m_netType)) {
+            QString alias = OpenAliasResolver::normalize(output.address);
+            m_pendingAliases.insert(alias);
+            m_errors.append(PayToLineError(line, m_aliasErrors.value(alias, "OpenAlias not resolved yet, click Resolve to look it up"), i, true));
+            continue;
+        }
+
         m_outputs.append(output);
         m_total += output.amount;
     }
-}
\ No newline at end of file
+}
+
+void PayToEdit::onAliasResolved(const OpenAliasResult &result) {
+    if (!m_requestedAliases.remove(result.alias)) {
+        return;
+    }
+
+    QString error;
+    if (result.address.isEmpty()) {
+        error = "OpenAlias could not be resolved";
+    }
+    else if (!result.dnssecValid) {
+        error = "OpenAlias found, but the DNSSEC signatures could not be verified";
+    }
+    else if (!WalletManager::addressValid(result.address, m_netType)) {
+        error = "OpenAlias does not resolve to a valid address";
+    }
+
+    if (!error.isEmpty()) {
+        m_aliasErrors.insert(result.alias, error);
+        this->checkText();
+        emit outputsChanged();
+        return;
+    }
+
+    // The address replaces the alias in the text, so what will be paid to is on screen before sending
+    QStringList lines = this->lines();
+    for (auto &line : lines) {
+        qsizetype comma = line.indexOf(',');
+        if (comma > 0 && OpenAliasResolver::normalize(line.left(comma)) == result.alias) {
+            line = result.address + line.mid(comma);
+        }
+    }
+    this->setPlainText(lines.join("\n"));
+}
@@ -7,7 +7,10 @@
 
 #include <QObject>
 #include <QPlainTextEdit>
+#include <QHash>
+#include <QSet>
 
+#include "utils/OpenAliasResolver.h"
 #include "utils/Utils.h"
 
 struct PartialTxOutput {
@@ -47,9 +50,14 @@ public:
     bool isMultiline();
     void payToMany();
     bool isOpenAlias();
+    //! a line pays to an OpenAlias that wasn't looked up yet
+    bool hasUnresolvedAliases();
+    //! looks up the aliases of all lines, each valid one is replaced by its address
+    void resolveAliases();
 
 signals:
     void dataPasted(const QString &data);
+    void outputsChanged(); // an OpenAlias in a line failed to resolve
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
@@ -65,6 +73,7 @@ private:
     QString parseAddress(QString address);
 
     void parseAsMultiline(const QStringList &lines);
+    void onAliasResolved(const OpenAliasResult &result);
 
     int m_heightMin = 0;
     int m_heightMax = 150;
@@ -73,6 +82,10 @@ private:
 
     QVector<PayToLineError> m_errors;
     QVector<PartialTxOutput> m_outputs;
+
+    QSet<QString> m_pendingAliases;         // in the text, not resolved
+    QSet<QString> m_requestedAliases;       // looked up on request, waiting for the result
+    QHash<QString, QString> m_aliasErrors;  // alias to why it can't be paid to
 };
 
 #endif //FEATHER_PAYTOEDIT_H
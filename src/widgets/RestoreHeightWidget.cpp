@@ -6,7 +6,7 @@
 
 #include <QValidator>
 
-#include "AppData.h"
+#include "RestoreHeightLookup.h"
 #include "constants.h"
 
 RestoreHeightWidget::RestoreHeightWidget(QWidget *parent)
@@ -46,13 +46,13 @@ void RestoreHeightWidget::onCreationDateChanged() {
     QDateTime restoreDate = date > curDate ? curDate : date;
     qint64 timestamp = restoreDate.toSecsSinceEpoch();
 
-    QString restoreHeight = QString::number(appData()->restoreHeights[constants::networkType]->dateToHeight(timestamp));
+    QString restoreHeight = QString::number(RestoreHeightLookup::forNetwork(constants::networkType)->dateToHeight(timestamp));
     ui->line_restoreHeight->setText(restoreHeight);
 }
 
 void RestoreHeightWidget::onRestoreHeightChanged() {
     int restoreHeight = ui->line_restoreHeight->text().toInt();
-    QDateTime date = appData()->restoreHeights[constants::networkType]->heightToDate(restoreHeight);
+    QDateTime date = RestoreHeightLookup::forNetwork(constants::networkType)->heightToDate(restoreHeight);
     ui->line_creationDate->setText(date.toString("yyyy-MM-dd"));
 }
 
@@ -5,6 +5,7 @@
 #include "ui_TxDetailsSimple.h"
 
 #include "constants.h"
+#include "libwalletqt/AddressResolver.h"
 #include "libwalletqt/WalletManager.h"
 #include "utils/AppData.h"
 #include "utils/ColorScheme.h"
@@ -49,7 +50,8 @@ void TxDetailsSimple::setDetails(Wallet *wallet, PendingTransaction *tx, const Q
     ui->label_fee->setText(QString("%1 (%2 %3)").arg(amounts[1], amounts_fiat[1], preferredCur));
     ui->label_total->setText(QString("%1 (%2 %3)").arg(amounts[2], amounts_fiat[2], preferredCur));
 
-    auto subaddressIndex = wallet->subaddressIndex(address);
+    AddressIdentity identity = wallet->addressResolver()->identify(address);
+    SubaddressIndex subaddressIndex = identity.subaddressIndex;
     QString addressExtra;
 
     ui->label_address->setText(Utils::displayAddress(address, 2));
@@ -68,6 +70,11 @@ void TxDetailsSimple::setDetails(Wallet *wallet, PendingTransaction *tx, const Q
         ui->label_address->setToolTip("Wallet change/primary address");
     }
 
+    if (!identity.isOwn() && identity.isContact()) {
+        ui->label_address->setStyleSheet(ColorScheme::BLUE.asStylesheet(true));
+        ui->label_address->setToolTip(QString("Contact: %1\n%2").arg(identity.contactLabel, address));
+    }
+
     if (tx->fee() > WalletManager::amountFromDouble(0.01)) {
         ui->label_fee->setStyleSheet(ColorScheme::RED.asStylesheet(true));
         ui->label_fee->setToolTip("Unrealistic fee. You may be connected to a malicious node.");
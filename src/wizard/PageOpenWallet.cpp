@@ -9,6 +9,7 @@
 #include "constants.h"
 #include "WalletWizard.h"
 #include "model/WalletKeysFilesModel.h"
+#include "utils/Utils.h"
 
 PageOpenWallet::PageOpenWallet(WalletKeysFilesModel *wallets, QWidget *parent)
         : QWizardPage(parent)
@@ -7,7 +7,7 @@
 #include <QValidator>
 
 #include "constants.h"
-#include "utils/AppData.h"
+#include "utils/RestoreHeightLookup.h"
 #include "utils/Icons.h"
 #include "WalletWizard.h"
 
@@ -35,6 +35,7 @@ PageSetRestoreHeight::PageSetRestoreHeight(WizardFields *fields, QWidget *parent
         this->completeChanged();
     });
     connect(ui->line_restoreHeight, &QLineEdit::textEdited, [this]{
+        m_restoreDate = 0;
         this->onRestoreHeightEdited();
         this->completeChanged();
     });
@@ -46,6 +47,7 @@ void PageSetRestoreHeight::initializePage() {
     ui->line_restoreHeight->setText("");
     ui->frame_scanWarning->hide();
     ui->frame_walletAgeWarning->hide();
+    m_restoreDate = 0;
 
     if (m_fields->showSetRestoreHeightPage && m_fields->mode == WizardMode::RestoreFromSeed) {
         auto creationDate = QDateTime::fromSecsSinceEpoch(m_fields->seed.time);
@@ -57,6 +59,7 @@ void PageSetRestoreHeight::initializePage() {
         ui->line_restoreHeight->setText(QString::number(m_fields->restoreHeight));
         this->onRestoreHeightEdited();
         this->completeChanged();
+        m_restoreDate = m_fields->restoreDate;
     }
 }
 
@@ -67,13 +70,15 @@ void PageSetRestoreHeight::onCreationDateEdited() {
         ui->frame_walletAgeWarning->hide();
         ui->frame_scanWarning->hide();
         ui->line_restoreHeight->setText("");
+        m_restoreDate = 0;
         return;
     }
 
     QDateTime restoreDate = date > curDate ? curDate : date;
     int timestamp = restoreDate.toSecsSinceEpoch();
+    m_restoreDate = timestamp;
 
-    QString restoreHeight = QString::number(appData()->restoreHeights[constants::networkType]->dateToHeight(timestamp));
+    QString restoreHeight = QString::number(RestoreHeightLookup::forNetwork(constants::networkType)->dateToHeight(timestamp));
     ui->line_restoreHeight->setText(restoreHeight);
 
     this->showScanWarning(restoreDate);
@@ -86,7 +91,7 @@ void PageSetRestoreHeight::onRestoreHeightEdited() {
         restoreHeight = 1;
     }
 
-    QDateTime date = appData()->restoreHeights[constants::networkType]->heightToDate(restoreHeight);
+    QDateTime date = RestoreHeightLookup::forNetwork(constants::networkType)->heightToDate(restoreHeight);
     ui->line_creationDate->setText(date.toString("yyyy-MM-dd"));
 
     this->showScanWarning(date);
@@ -106,6 +111,7 @@ void PageSetRestoreHeight::showWalletAgeWarning(const QDateTime &date) {
 
 bool PageSetRestoreHeight::validatePage() {
     m_fields->restoreHeight = std::max(1, ui->line_restoreHeight->text().toInt());
+    m_fields->restoreDate = m_restoreDate;
     return true;
 }
 
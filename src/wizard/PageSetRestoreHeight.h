@@ -33,6 +33,7 @@ private:
 
     Ui::PageSetRestoreHeight *ui;
     WizardFields *m_fields;
+    qint64 m_restoreDate = 0;
 };
 
 #endif //FEATHER_PAGESETRESTOREHEIGHT_H
@@ -12,6 +12,7 @@
 #include "WalletWizard.h"
 #include "constants.h"
 #include "libwalletqt/WalletManager.h"
+#include "utils/Utils.h"
 
 #ifdef WITH_SCANNER
 #include "scanner/QrCodeScanDialog.h"
@@ -14,6 +14,7 @@
 #include "dialog/LegacySeedRecovery.h"
 #include <monero_seed/wordlist.hpp>  // tevador 14 word
 #include "utils/Seed.h"
+#include "utils/Utils.h"
 #include "constants.h"
 
 #include <mnemonics/electrum-words.h>
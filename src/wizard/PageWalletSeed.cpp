@@ -16,6 +16,7 @@
 #include "Seed.h"
 #include "Icons.h"
 #include "dialog/SeedDiceDialog.h"
+#include "utils/Utils.h"
 
 PageWalletSeed::PageWalletSeed(WizardFields *fields, QWidget *parent)
     : QWizardPage(parent)
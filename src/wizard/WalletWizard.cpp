@@ -151,8 +151,13 @@ void WalletWizard::onCreateWallet() {
         m_wizardFields.seed.restoreHeight = currentBlockHeight;
     }
 
-    if (m_wizardFields.mode == WizardMode::RestoreFromSeed && (m_wizardFields.seedType == Seed::Type::MONERO || m_wizardFields.showSetRestoreHeightPage)) {
-        m_wizardFields.seed.setRestoreHeight(m_wizardFields.restoreHeight);
+    if (m_wizardFields.mode == WizardMode::RestoreFromSeed) {
+        if (m_wizardFields.seedType == Seed::Type::MONERO || m_wizardFields.showSetRestoreHeightPage) {
+            m_wizardFields.seed.setRestoreHeight(m_wizardFields.restoreHeight);
+            m_wizardFields.seed.restoreDate = m_wizardFields.restoreDate;
+        } else {
+            m_wizardFields.seed.restoreDate = m_wizardFields.seed.time;
+        }
     }
 
     bool newWallet = m_wizardFields.mode == WizardMode::CreateWallet;
@@ -41,6 +41,7 @@ struct WizardFields {
     QString secretSpendKey;
     WizardMode mode;
     int restoreHeight = 0;
+    qint64 restoreDate = 0; // creation date the restore height was derived from, 0 if entered manually
     Seed::Type seedType;
     DeviceType deviceType;
     QString subaddressLookahead;
@@ -55,6 +56,7 @@ struct WizardFields {
         secretViewKey = "";
         secretSpendKey = "";
         restoreHeight = 0;
+        restoreDate = 0;
         subaddressLookahead = "";
     }
 
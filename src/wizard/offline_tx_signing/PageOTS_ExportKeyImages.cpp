@@ -8,6 +8,7 @@
 #include <QCheckBox>
 
 #include "utils/config.h"
+#include "utils/OtsContainer.h"
 #include "utils/Utils.h"
 
 PageOTS_ExportKeyImages::PageOTS_ExportKeyImages(QWidget *parent, Wallet *wallet, TxWizardFields *wizardFields)
@@ -15,6 +16,7 @@ PageOTS_ExportKeyImages::PageOTS_ExportKeyImages(QWidget *parent, Wallet *wallet
         , ui(new Ui::PageOTS_Export)
         , m_wallet(wallet)
         , m_wizardFields(wizardFields)
+        , m_check_compress(new QCheckBox(this))
 {
     ui->setupUi(this);
     this->setTitle("2. Export key images");
@@ -22,6 +24,14 @@ PageOTS_ExportKeyImages::PageOTS_ExportKeyImages(QWidget *parent, Wallet *wallet
     ui->label_step->hide();
     ui->label_instructions->setText("Scan this animated QR code with the view-only wallet.");
 
+    m_check_compress->setText("Compress (requires Feather on the view-only device)");
+    m_check_compress->setChecked(conf()->get(Config::offlineTxSigningCompress).toBool());
+    ui->layout_extra->addWidget(m_check_compress);
+    connect(m_check_compress, &QCheckBox::toggled, [this](bool checked){
+        conf()->set(Config::offlineTxSigningCompress, checked);
+        this->setupUR(false);
+    });
+
     connect(ui->btn_export, &QPushButton::clicked, this, &PageOTS_ExportKeyImages::exportKeyImages);
     connect(ui->combo_method, &QComboBox::currentIndexChanged, [this](int index){
         conf()->set(Config::offlineTxSigningMethod, index);
@@ -39,24 +49,27 @@ void PageOTS_ExportKeyImages::exportKeyImages() {
         fn += "_keyImages";
     }
 
-    QFile file{fn};
-    if (!file.open(QIODevice::WriteOnly)) {
-      Utils::showError(this, "Failed to export key images", QString("Could not open file %1 for writing").arg(fn));
+    QString error;
+    if (!OtsContainer::writeFile(fn, this->payload(), &error)) {
+      Utils::showError(this, "Failed to export key images", error);
       return;
     }
 
-    file.write(m_wizardFields->keyImages.data(), m_wizardFields->keyImages.size());
-    file.close();
-
     QFileInfo fileInfo(fn);
     Utils::openDir(this, "Successfully exported key images", fileInfo.absolutePath());
 }
 
+std::string PageOTS_ExportKeyImages::payload() const {
+    std::string keyImages = m_wizardFields->keyImages;
+    if (m_check_compress->isChecked()) {
+        OtsContainer::pack(keyImages);
+    }
+    return keyImages;
+}
+
 void PageOTS_ExportKeyImages::setupUR(bool all) {
-    // TODO: check if empty
-    std::string ki_export;
-    m_wallet->exportKeyImagesToStr(ki_export, all);
-    ui->widget_UR->setData("xmr-keyimage", m_wizardFields->keyImages);
+    // The key images were already derived from the imported outputs, only those outputs are covered
+    ui->widget_UR->setData("xmr-keyimage", this->payload());
 }
 
 void PageOTS_ExportKeyImages::initializePage() {
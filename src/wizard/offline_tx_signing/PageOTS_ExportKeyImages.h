@@ -5,6 +5,7 @@
 #define FEATHER_PAGEOTS_EXPORTKEYIMAGES_H
 
 #include <QWizardPage>
+#include <QCheckBox>
 #include "Wallet.h"
 #include "OfflineTxSigningWizard.h"
 
@@ -26,10 +27,12 @@ private slots:
 
 private:
     void setupUR(bool all);
+    std::string payload() const;
     
     Ui::PageOTS_Export *ui;
     Wallet *m_wallet;
     TxWizardFields *m_wizardFields;
+    QCheckBox *m_check_compress;
 };
 
 #endif //FEATHER_PAGEOTS_EXPORTKEYIMAGES_H
@@ -8,6 +8,7 @@
 #include <QFileDialog>
 #include <QCheckBox>
 
+#include "utils/OtsContainer.h"
 #include "utils/Utils.h"
 #include "utils/config.h"
 
@@ -16,6 +17,7 @@ PageOTS_ExportOutputs::PageOTS_ExportOutputs(QWidget *parent, Wallet *wallet)
         , ui(new Ui::PageOTS_Export)
         , m_wallet(wallet)
         , m_check_exportAll(new QCheckBox(this))
+        , m_check_compress(new QCheckBox(this))
 {
     ui->setupUi(this);
     this->setTitle("1. Export outputs");
@@ -26,7 +28,16 @@ PageOTS_ExportOutputs::PageOTS_ExportOutputs(QWidget *parent, Wallet *wallet)
     m_check_exportAll->setText("Export all outputs");
     ui->layout_extra->addWidget(m_check_exportAll);
     connect(m_check_exportAll, &QCheckBox::toggled, this, &PageOTS_ExportOutputs::setupUR);
-    
+
+    m_check_compress->setText("Compress (requires Feather on the offline device)");
+    m_check_compress->setToolTip("Greatly reduces the number of QR codes for wallets with many outputs.");
+    m_check_compress->setChecked(conf()->get(Config::offlineTxSigningCompress).toBool());
+    ui->layout_extra->addWidget(m_check_compress);
+    connect(m_check_compress, &QCheckBox::toggled, [this](bool checked){
+        conf()->set(Config::offlineTxSigningCompress, checked);
+        this->setupUR(m_check_exportAll->isChecked());
+    });
+
     connect(ui->btn_export, &QPushButton::clicked, this, &PageOTS_ExportOutputs::exportOutputs);
     connect(ui->combo_method, &QComboBox::currentIndexChanged, [this](int index){
         conf()->set(Config::offlineTxSigningMethod, index);
@@ -44,20 +55,36 @@ void PageOTS_ExportOutputs::exportOutputs() {
         fn += "_outputs";
     }
 
-    bool r = m_wallet->exportOutputs(fn, m_check_exportAll->isChecked());
-    if (!r) {
+    bool all = m_check_exportAll->isChecked();
+    if (m_check_compress->isChecked()) {
+        std::string outputs;
+        QString error = "Compression failed";
+        if (!m_wallet->exportOutputsToStr(outputs, all)) {
+            Utils::showError(this, "Failed to export outputs", m_wallet->errorString());
+            return;
+        }
+        if (!OtsContainer::pack(outputs) || !OtsContainer::writeFile(fn, outputs, &error)) {
+            Utils::showError(this, "Failed to export outputs", error);
+            return;
+        }
+    }
+    else if (!m_wallet->exportOutputs(fn, all)) {
         Utils::showError(this, "Failed to export outputs", m_wallet->errorString());
         return;
-    } 
+    }
 
     QFileInfo fileInfo(fn);
     Utils::openDir(this, "Successfully exported outputs", fileInfo.absolutePath());
 }
 
 void PageOTS_ExportOutputs::setupUR(bool all) {
+    // Unless "all" is checked, the wallet only exports outputs whose key images haven't been imported yet
     std::string output_export;
     m_wallet->exportOutputsToStr(output_export, all);
-    ui->widget_UR->setData("xmr-output", output_export);
+    if (m_check_compress->isChecked()) {
+        OtsContainer::pack(output_export);
+    }
+    ui->widget_UR->setData("xmr-output", std::move(output_export));
 }
 
 void PageOTS_ExportOutputs::initializePage() {
@@ -29,6 +29,7 @@ private:
     
     Ui::PageOTS_Export *ui;
     QCheckBox *m_check_exportAll;
+    QCheckBox *m_check_compress;
     Wallet *m_wallet;
 };
 
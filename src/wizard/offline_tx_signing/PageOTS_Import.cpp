@@ -9,6 +9,7 @@
 
 #include "utils/config.h"
 #include "utils/Icons.h"
+#include "utils/OtsContainer.h"
 #include "utils/Utils.h"
 
 PageOTS_Import::PageOTS_Import(QWidget *parent, Wallet *wallet, TxWizardFields *wizardFields, int step, const QString &type, const QString &fileType, const QString &successButtonText)
@@ -47,6 +48,13 @@ void PageOTS_Import::onScanFinished(bool success) {
     }
 
     std::string data = m_scanWidget->getURData();
+    QString error;
+    if (!OtsContainer::unpack(data, &error)) {
+        m_scanWidget->pause();
+        Utils::showError(this, QString("Failed to import %1").arg(m_type), error);
+        m_scanWidget->reset();
+        return;
+    }
     importFromStr(data);
 }
 
@@ -71,15 +79,13 @@ void PageOTS_Import::importFromFile() {
         return;
     }
 
-    QFile file(fn);
-    if (!file.open(QIODevice::ReadOnly)) {
+    std::string data;
+    QString error;
+    if (!OtsContainer::readFile(fn, data, &error)) {
+        Utils::showError(this, QString("Failed to import %1").arg(m_type), error);
         return;
     }
 
-    QByteArray qdata = file.readAll();
-    std::string data = qdata.toStdString();
-    file.close();
-
     importFromStr(data);
 }
 